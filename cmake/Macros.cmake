@@ -286,12 +286,14 @@ macro(gqe_add_example target)
       endif()
     endif()
 
-    # always copy resources over to build directory after build
-    add_custom_command(TARGET ${target}
-                       POST_BUILD
-                       COMMAND ${CMAKE_COMMAND} -E copy_directory
-                         ${PROJECT_SOURCE_DIR}/resources
-                         ${PROJECT_BINARY_DIR}/${CMAKE_CFG_INTDIR}/resources)
+    # always copy resources (if any) over to build directory after build
+    if(EXISTS ${PROJECT_SOURCE_DIR}/resources)
+        add_custom_command(TARGET ${target}
+                           POST_BUILD
+                           COMMAND ${CMAKE_COMMAND} -E copy_directory
+                             ${PROJECT_SOURCE_DIR}/resources
+                             ${PROJECT_BINARY_DIR}/${CMAKE_CFG_INTDIR}/resources)
+    endif()
 
     # add the install rule
     install(TARGETS ${target}
@@ -0,0 +1,123 @@
+/**
+ * Provides the allocation counters used by the CollisionBench example to
+ * report the number of heap allocations made by each collision update. The
+ * global operator new and delete are replaced to count every allocation.
+ * The counters aren't locked, so they are only valid with threads=1, since
+ * the narrowphase threads would otherwise update them at the same time.
+ *
+ * @file examples/collisionbench/src/AllocationCounter.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Only trust the counters with a single narrowphase thread
+ */
+#include <cstdlib>
+#include <new>
+#include "AllocationCounter.hpp"
+
+// Dynamic exception specifications were removed from newer C++ standards
+#if __cplusplus >= 201103L
+#define ALLOCATION_THROW
+#define ALLOCATION_NOTHROW noexcept
+#else
+#define ALLOCATION_THROW throw(std::bad_alloc)
+#define ALLOCATION_NOTHROW throw()
+#endif
+
+/// Number of calls made to the global operator new
+static volatile GQE::Uint64 gAllocationCount = 0;
+
+/// Number of bytes requested from the global operator new
+static volatile GQE::Uint64 gAllocationBytes = 0;
+
+/**
+ * CountedAllocate will count and perform a single allocation.
+ * @param[in] theSize in bytes to allocate
+ * @return the memory allocated or NULL if none was available
+ */
+static void* CountedAllocate(std::size_t theSize)
+{
+  gAllocationCount = gAllocationCount + 1;
+  gAllocationBytes = gAllocationBytes + theSize;
+  return malloc(theSize > 0 ? theSize : 1);
+}
+
+GQE::Uint64 GetAllocationCount(void)
+{
+  return gAllocationCount;
+}
+
+GQE::Uint64 GetAllocationBytes(void)
+{
+  return gAllocationBytes;
+}
+
+void* operator new(std::size_t theSize) ALLOCATION_THROW
+{
+  void* anResult = CountedAllocate(theSize);
+  if(NULL == anResult)
+  {
+    throw std::bad_alloc();
+  }
+  return anResult;
+}
+
+void* operator new[](std::size_t theSize) ALLOCATION_THROW
+{
+  void* anResult = CountedAllocate(theSize);
+  if(NULL == anResult)
+  {
+    throw std::bad_alloc();
+  }
+  return anResult;
+}
+
+void* operator new(std::size_t theSize, const std::nothrow_t&) ALLOCATION_NOTHROW
+{
+  return CountedAllocate(theSize);
+}
+
+void* operator new[](std::size_t theSize, const std::nothrow_t&) ALLOCATION_NOTHROW
+{
+  return CountedAllocate(theSize);
+}
+
+void operator delete(void* theMemory) ALLOCATION_NOTHROW
+{
+  free(theMemory);
+}
+
+void operator delete[](void* theMemory) ALLOCATION_NOTHROW
+{
+  free(theMemory);
+}
+
+void operator delete(void* theMemory, const std::nothrow_t&) ALLOCATION_NOTHROW
+{
+  free(theMemory);
+}
+
+void operator delete[](void* theMemory, const std::nothrow_t&) ALLOCATION_NOTHROW
+{
+  free(theMemory);
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
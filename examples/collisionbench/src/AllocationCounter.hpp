@@ -0,0 +1,51 @@
+/**
+ * Provides the allocation counters used by the CollisionBench example to
+ * report the number of heap allocations made by each collision update. The
+ * counts are only valid when a single narrowphase thread is used.
+ *
+ * @file examples/collisionbench/src/AllocationCounter.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Only trust the counters with a single narrowphase thread
+ */
+#ifndef   ALLOCATION_COUNTER_HPP_INCLUDED
+#define   ALLOCATION_COUNTER_HPP_INCLUDED
+
+#include <GQE/Config.hpp>
+
+/**
+ * GetAllocationCount will return the number of times the global operator new
+ * has been called since the application started.
+ * @return the number of allocations made
+ */
+GQE::Uint64 GetAllocationCount(void);
+
+/**
+ * GetAllocationBytes will return the number of bytes requested from the
+ * global operator new since the application started.
+ * @return the number of bytes allocated
+ */
+GQE::Uint64 GetAllocationBytes(void);
+
+#endif // ALLOCATION_COUNTER_HPP_INCLUDED
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,74 @@
+/**
+ * Provides the BenchCollisionSystem class used by the CollisionBench example
+ * to keep every moving IEntity inside the benchmark world.
+ *
+ * @file examples/collisionbench/src/BenchCollisionSystem.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+#include <GQE/Entity/interfaces/IEntity.hpp>
+#include "BenchCollisionSystem.hpp"
+
+BenchCollisionSystem::BenchCollisionSystem(GQE::IApp& theApp,
+    const float theWorldSize, const GQE::Uint32 theSweepAxes) :
+  GQE::ICollisionSystem(theApp, theSweepAxes),
+  mWorldSize(theWorldSize)
+{
+}
+
+BenchCollisionSystem::~BenchCollisionSystem()
+{
+}
+
+void BenchCollisionSystem::EntityUpdateFixed(GQE::IEntity* theEntity)
+{
+  if(!theEntity->mProperties.GetBool("bMovable"))
+  {
+    return;
+  }
+
+  // Head back toward the middle of the world after crossing an edge
+  sf::Vector2f anPosition = theEntity->mProperties.Get<sf::Vector2f>("vPosition");
+  sf::Vector2f anVelocity = theEntity->mProperties.Get<sf::Vector2f>("vVelocity");
+  sf::Vector2f anOldVelocity = anVelocity;
+  if((anPosition.x < 0.0f && anVelocity.x < 0.0f) ||
+      (anPosition.x > mWorldSize && anVelocity.x > 0.0f))
+  {
+    anVelocity.x = -anVelocity.x;
+  }
+  if((anPosition.y < 0.0f && anVelocity.y < 0.0f) ||
+      (anPosition.y > mWorldSize && anVelocity.y > 0.0f))
+  {
+    anVelocity.y = -anVelocity.y;
+  }
+  if(anVelocity != anOldVelocity)
+  {
+    theEntity->mProperties.Set<sf::Vector2f>("vVelocity", anVelocity);
+  }
+}
+
+void BenchCollisionSystem::EntityCollision(GQE::CollisionData anCollisionData)
+{
+  // Do nothing
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
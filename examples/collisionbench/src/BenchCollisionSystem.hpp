@@ -0,0 +1,81 @@
+/**
+ * Provides the BenchCollisionSystem class used by the CollisionBench example
+ * to keep every moving IEntity inside the benchmark world.
+ *
+ * @file examples/collisionbench/src/BenchCollisionSystem.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+#ifndef   BENCH_COLLISION_SYSTEM_HPP_INCLUDED
+#define   BENCH_COLLISION_SYSTEM_HPP_INCLUDED
+
+#include <GQE/Entity/interfaces/ICollisionSystem.hpp>
+
+/// Provides the ICollisionSystem used by the CollisionBench example
+class BenchCollisionSystem : public GQE::ICollisionSystem
+{
+  public:
+    /**
+     * BenchCollisionSystem constructor
+     * @param[in] theApp is the current GQE app
+     * @param[in] theWorldSize of the square world to keep each IEntity in
+     * @param[in] theSweepAxes to sort along in the broadphase
+     */
+    BenchCollisionSystem(GQE::IApp& theApp, const float theWorldSize,
+        const GQE::Uint32 theSweepAxes);
+
+    /**
+     * BenchCollisionSystem deconstructor
+     */
+    virtual ~BenchCollisionSystem();
+
+  protected:
+    /**
+     * EntityUpdateFixed will bounce each moving IEntity off the edges of the
+     * world so the number of contacts stays about the same every update.
+     * @param[in] theEntity to update
+     */
+    virtual void EntityUpdateFixed(GQE::IEntity* theEntity);
+
+    /**
+     * EntityCollision does nothing so every run of the benchmark performs
+     * exactly the same work.
+     * @param[in] anCollisionData of the contact found
+     */
+    virtual void EntityCollision(GQE::CollisionData anCollisionData);
+
+  private:
+    // Variables
+    /////////////////////////////////////////////////////////////////////////
+    /// The size of the square world to keep each IEntity in
+    float mWorldSize;
+}; // class BenchCollisionSystem
+
+#endif // BENCH_COLLISION_SYSTEM_HPP_INCLUDED
+
+/**
+ * @class BenchCollisionSystem
+ * @ingroup Examples
+ * The BenchCollisionSystem class is the ICollisionSystem measured by the
+ * CollisionBench example. It never responds to a contact and only reverses
+ * the velocity of each IEntity that leaves the world.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,405 @@
+/**
+ * Provides the BenchState class which fills a BenchCollisionSystem with
+ * static and moving colliders and measures each collision update.
+ *
+ * @file examples/collisionbench/src/BenchState.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Quit if the BenchCollisionSystem can't be created
+ */
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <GQE/Core/assets/ConfigAsset.hpp>
+#include <GQE/Core/interfaces/IApp.hpp>
+#include <GQE/Core/utils/MathUtil.hpp>
+#include <GQE/Entity/utils/CollisionUtil.hpp>
+#include "AllocationCounter.hpp"
+#include "BenchState.hpp"
+
+BenchEntity::BenchEntity() :
+  GQE::IEntity()
+{
+}
+
+BenchEntity::~BenchEntity()
+{
+  DropAllSystems();
+}
+
+void BenchEntity::Destroy(void)
+{
+  DropAllSystems();
+}
+
+BenchState::BenchState(GQE::IApp& theApp) :
+  GQE::IState("Bench", theApp),
+  mTransformSystem(theApp),
+  mCollisionSystem(NULL),
+  mStaticCount(0),
+  mMovingCount(0),
+  mWarmup(0),
+  mTicks(1),
+  mClusterCount(1),
+  mSweepAxes(GQE::AXIS_HORZ | GQE::AXIS_VERT),
+  mThreadCount(1),
+  mSeed(1),
+  mWorldSize(1.0f),
+  mMinSize(1.0f),
+  mMaxSize(1.0f),
+  mSpeed(0.0f),
+  mContinuous(false)
+{
+}
+
+BenchState::~BenchState(void)
+{
+  HandleCleanup();
+}
+
+void BenchState::DoInit(void)
+{
+  // First call our base class implementation
+  IState::DoInit();
+
+  LoadSettings();
+
+  // Use a fixed seed so every run creates the same world
+  GQE::SetSeed(mSeed);
+  mCollisionSystem = new(std::nothrow) BenchCollisionSystem(mApp, mWorldSize, mSweepAxes);
+  if(NULL == mCollisionSystem)
+  {
+    std::cerr << "Unable to create the collision system" << std::endl;
+    mApp.Quit(GQE::StatusError);
+    return;
+  }
+  mCollisionSystem->SetThreadCount(mThreadCount);
+
+  // A bracket shaped outline that is split into three convex pieces
+  std::vector<sf::Vector2f> anOutline;
+  anOutline.push_back(sf::Vector2f(-1.0f, -1.0f));
+  anOutline.push_back(sf::Vector2f(1.0f, -1.0f));
+  anOutline.push_back(sf::Vector2f(1.0f, 1.0f));
+  anOutline.push_back(sf::Vector2f(0.4f, 1.0f));
+  anOutline.push_back(sf::Vector2f(0.4f, -0.2f));
+  anOutline.push_back(sf::Vector2f(-0.4f, -0.2f));
+  anOutline.push_back(sf::Vector2f(-0.4f, 1.0f));
+  anOutline.push_back(sf::Vector2f(-1.0f, 1.0f));
+  mConcaveShape.SetPoints(anOutline);
+
+  for(GQE::Uint32 anIndex = 0; anIndex < mClusterCount; ++anIndex)
+  {
+    mClusters.push_back(sf::Vector2f(GQE::Random(0.0f, mWorldSize),
+          GQE::Random(0.0f, mWorldSize)));
+  }
+  for(GQE::Uint32 anIndex = 0; anIndex < mStaticCount; ++anIndex)
+  {
+    AddEntity(false);
+  }
+  for(GQE::Uint32 anIndex = 0; anIndex < mMovingCount; ++anIndex)
+  {
+    AddEntity(true);
+  }
+}
+
+void BenchState::ReInit(void)
+{
+}
+
+void BenchState::UpdateFixed(void)
+{
+  // Nothing to measure if DoInit was unable to create the collision system
+  if(NULL == mCollisionSystem)
+  {
+    return;
+  }
+
+  BenchResults anResults;
+  RunBenchmark(anResults);
+
+  if(mOutput.empty())
+  {
+    WriteResults(anResults, std::cout, true);
+  }
+  else
+  {
+    // Only start a CSV file with the column names if the file is empty so
+    // each run can be appended to the same file
+    bool anHeader = true;
+    if(mFormat == "csv")
+    {
+      std::ifstream anExisting(mOutput.c_str());
+      anHeader = !anExisting.is_open() || anExisting.peek() == std::ifstream::traits_type::eof();
+    }
+    std::ofstream anFile(mOutput.c_str(),
+        mFormat == "csv" ? std::ios::out | std::ios::app : std::ios::out | std::ios::trunc);
+    if(!anFile.is_open())
+    {
+      std::cerr << "Unable to open " << mOutput << std::endl;
+      mApp.Quit(GQE::StatusError);
+      return;
+    }
+    WriteResults(anResults, anFile, anHeader);
+  }
+
+  mApp.Quit(GQE::StatusAppOK);
+}
+
+void BenchState::UpdateVariable(float theElapsedTime)
+{
+}
+
+void BenchState::Draw(void)
+{
+}
+
+void BenchState::HandleCleanup(void)
+{
+  // Each BenchEntity drops itself from every system
+  std::vector<BenchEntity*>::iterator anIter;
+  for(anIter = mEntities.begin(); anIter != mEntities.end(); ++anIter)
+  {
+    delete *anIter;
+  }
+  mEntities.clear();
+
+  delete mCollisionSystem;
+  mCollisionSystem = NULL;
+}
+
+void BenchState::LoadSettings(void)
+{
+  GQE::ConfigAsset anSettingsConfig(GQE::IApp::APP_SETTINGS);
+  GQE::ConfigReader& anConfig = anSettingsConfig.GetAsset();
+  mStaticCount = anConfig.GetUint32("benchmark", "statics", 2000);
+  mMovingCount = anConfig.GetUint32("benchmark", "moving", 500);
+  mWarmup = anConfig.GetUint32("benchmark", "warmup", 30);
+  mTicks = anConfig.GetUint32("benchmark", "ticks", 300);
+  mTicks = mTicks > 0 ? mTicks : 1;
+  mWorldSize = anConfig.GetFloat("benchmark", "world", 4000.0f);
+  mDistribution = anConfig.GetString("benchmark", "distribution", "uniform");
+  mClusterCount = anConfig.GetUint32("benchmark", "clusters", 8);
+  mClusterCount = mClusterCount > 0 ? mClusterCount : 1;
+  mShape = anConfig.GetString("benchmark", "shape", "polygon");
+  mMinSize = anConfig.GetFloat("benchmark", "size", 8.0f);
+  mMaxSize = anConfig.GetFloat("benchmark", "maxsize", 24.0f);
+  mMaxSize = mMaxSize > mMinSize ? mMaxSize : mMinSize;
+  mSpeed = anConfig.GetFloat("benchmark", "speed", 4.0f);
+  mContinuous = anConfig.GetBool("benchmark", "continuous", false);
+  mSweepAxes = anConfig.GetUint32("benchmark", "axes", GQE::AXIS_HORZ | GQE::AXIS_VERT);
+  mThreadCount = anConfig.GetUint32("benchmark", "threads", 1);
+  mSeed = anConfig.GetUint32("benchmark", "seed", 1);
+  mFormat = anConfig.GetString("benchmark", "format", "text");
+  mOutput = anConfig.GetString("benchmark", "output", "");
+  mLabel = anConfig.GetString("benchmark", "label", "");
+}
+
+void BenchState::AddEntity(const bool theMovable)
+{
+  BenchEntity* anEntity = new(std::nothrow) BenchEntity();
+  if(NULL == anEntity)
+  {
+    return;
+  }
+  mEntities.push_back(anEntity);
+
+  // Mixed colliders use an even split of every other collider
+  std::string anShape = mShape;
+  if(anShape == "mixed")
+  {
+    const char* anShapes[4] = {"polygon", "circle", "aabb", "concave"};
+    anShape = anShapes[GQE::Random(0U, 3U)];
+  }
+  float anSize = GQE::Random(mMinSize, mMaxSize);
+
+  // Set our properties before each system adds its default values
+  sf::ConvexShape anCollisionShape;
+  if(anShape == "circle")
+  {
+    anEntity->mProperties.Add<GQE::Uint32>("uColliderType", GQE::COLLIDER_CIRCLE);
+    anEntity->mProperties.Add<float>("fCollisionRadius", anSize);
+  }
+  else if(anShape == "aabb")
+  {
+    anCollisionShape.setPointCount(4);
+    anCollisionShape.setPoint(0, sf::Vector2f(-anSize, -anSize));
+    anCollisionShape.setPoint(1, sf::Vector2f(anSize, -anSize));
+    anCollisionShape.setPoint(2, sf::Vector2f(anSize, anSize));
+    anCollisionShape.setPoint(3, sf::Vector2f(-anSize, anSize));
+    anEntity->mProperties.Add<GQE::Uint32>("uColliderType", GQE::COLLIDER_AABB);
+  }
+  else if(anShape == "concave")
+  {
+    anEntity->mProperties.Add<GQE::PolygonShape*>("CollisionPolygon", &mConcaveShape);
+    anEntity->mProperties.Add<sf::Vector2f>("vScale", sf::Vector2f(anSize, anSize));
+  }
+  else
+  {
+    GQE::Uint32 anPointCount = GQE::Random(3U, 8U);
+    float anRotation = GQE::Random(0.0f, 360.0f);
+    anCollisionShape.setPointCount(anPointCount);
+    for(GQE::Uint32 anIndex = 0; anIndex < anPointCount; ++anIndex)
+    {
+      float anAngle = GQE::ToRadians(anRotation + (360.0f * anIndex) / anPointCount);
+      anCollisionShape.setPoint(anIndex,
+          sf::Vector2f(anSize * cos(anAngle), anSize * sin(anAngle)));
+    }
+  }
+  anEntity->mProperties.Add<sf::ConvexShape>("CollisionShape", anCollisionShape);
+  anEntity->mProperties.Add<sf::Vector2f>("vOrigin", sf::Vector2f(0.0f, 0.0f));
+  anEntity->mProperties.Add<sf::Vector2f>("vPosition", MakePosition());
+  anEntity->mProperties.Add<bool>("bMovable", theMovable);
+  if(theMovable)
+  {
+    float anAngle = GQE::ToRadians(GQE::Random(0.0f, 360.0f));
+    anEntity->mProperties.Add<sf::Vector2f>("vVelocity",
+        sf::Vector2f(mSpeed * cos(anAngle), mSpeed * sin(anAngle)));
+    anEntity->mProperties.Add<bool>("bContinuous", mContinuous);
+  }
+
+  mTransformSystem.AddEntity(anEntity);
+  mCollisionSystem->AddEntity(anEntity);
+}
+
+sf::Vector2f BenchState::MakePosition(void)
+{
+  if(mDistribution == "clustered")
+  {
+    // Crowd each IEntity toward the center of a random cluster
+    const sf::Vector2f& anCenter = mClusters[GQE::Random(0U, mClusterCount - 1)];
+    float anSpread = mWorldSize / (4.0f * sqrt((float)mClusterCount));
+    float anDistance = GQE::Random(0.0f, 1.0f);
+    float anAngle = GQE::ToRadians(GQE::Random(0.0f, 360.0f));
+    anDistance *= anDistance * anSpread;
+    return anCenter + sf::Vector2f(anDistance * cos(anAngle), anDistance * sin(anAngle));
+  }
+  return sf::Vector2f(GQE::Random(0.0f, mWorldSize), GQE::Random(0.0f, mWorldSize));
+}
+
+void BenchState::RunBenchmark(BenchResults& theResults)
+{
+  // Let the contact cache and every container reach its working size
+  for(GQE::Uint32 anTick = 0; anTick < mWarmup; ++anTick)
+  {
+    mTransformSystem.UpdateFixed();
+    mCollisionSystem->UpdateFixed();
+  }
+
+  sf::Clock anClock;
+  for(GQE::Uint32 anTick = 0; anTick < mTicks; ++anTick)
+  {
+    mTransformSystem.UpdateFixed();
+
+    // Only the collision update itself is measured
+    GQE::Uint64 anAllocations = GetAllocationCount();
+    GQE::Uint64 anBytes = GetAllocationBytes();
+    anClock.restart();
+    mCollisionSystem->UpdateFixed();
+    GQE::Uint64 anNanoseconds = (GQE::Uint64)anClock.getElapsedTime().asMicroseconds() * 1000;
+    theResults.Allocations += GetAllocationCount() - anAllocations;
+    theResults.Bytes += GetAllocationBytes() - anBytes;
+
+    theResults.Nanoseconds += anNanoseconds;
+    if(anTick == 0 || anNanoseconds < theResults.MinNanoseconds)
+    {
+      theResults.MinNanoseconds = anNanoseconds;
+    }
+    if(anNanoseconds > theResults.MaxNanoseconds)
+    {
+      theResults.MaxNanoseconds = anNanoseconds;
+    }
+
+    const GQE::CollisionStats& anStats = mCollisionSystem->GetStats();
+    theResults.Proxies += anStats.Proxies;
+    theResults.Pairs += anStats.Pairs;
+    theResults.Tests += anStats.Tests;
+    theResults.Contacts += anStats.Contacts;
+  }
+}
+
+void BenchState::WriteResults(const BenchResults& theResults, std::ostream& theStream,
+    const bool theHeader) const
+{
+  double anTicks = (double)mTicks;
+  theStream << std::fixed << std::setprecision(1);
+  if(mFormat == "json")
+  {
+    theStream << "{" << std::endl
+      << "  \"label\": \"" << mLabel << "\"," << std::endl
+      << "  \"version\": \"" << GQE_VERSION_MAJOR << "." << GQE_VERSION_MINOR << "\"," << std::endl
+      << "  \"instructions\": \"" << GQE::GetSATInstructionSet() << "\"," << std::endl
+      << "  \"statics\": " << mStaticCount << "," << std::endl
+      << "  \"moving\": " << mMovingCount << "," << std::endl
+      << "  \"ticks\": " << mTicks << "," << std::endl
+      << "  \"distribution\": \"" << mDistribution << "\"," << std::endl
+      << "  \"shape\": \"" << mShape << "\"," << std::endl
+      << "  \"continuous\": " << (mContinuous ? "true" : "false") << "," << std::endl
+      << "  \"axes\": " << mSweepAxes << "," << std::endl
+      << "  \"threads\": " << mThreadCount << "," << std::endl
+      << "  \"ns_per_tick\": " << theResults.Nanoseconds / anTicks << "," << std::endl
+      << "  \"ns_min\": " << theResults.MinNanoseconds << "," << std::endl
+      << "  \"ns_max\": " << theResults.MaxNanoseconds << "," << std::endl
+      << "  \"proxies_per_tick\": " << theResults.Proxies / anTicks << "," << std::endl
+      << "  \"pairs_per_tick\": " << theResults.Pairs / anTicks << "," << std::endl
+      << "  \"tests_per_tick\": " << theResults.Tests / anTicks << "," << std::endl
+      << "  \"contacts_per_tick\": " << theResults.Contacts / anTicks << "," << std::endl
+      << "  \"allocations_per_tick\": " << theResults.Allocations / anTicks << "," << std::endl
+      << "  \"bytes_per_tick\": " << theResults.Bytes / anTicks << std::endl
+      << "}" << std::endl;
+  }
+  else if(mFormat == "csv")
+  {
+    if(theHeader)
+    {
+      theStream << "label,version,instructions,statics,moving,ticks,distribution,"
+        << "shape,continuous,axes,threads,ns_per_tick,ns_min,ns_max,"
+        << "proxies_per_tick,pairs_per_tick,tests_per_tick,contacts_per_tick,"
+        << "allocations_per_tick,bytes_per_tick" << std::endl;
+    }
+    theStream << mLabel << "," << GQE_VERSION_MAJOR << "." << GQE_VERSION_MINOR << ","
+      << GQE::GetSATInstructionSet() << "," << mStaticCount << "," << mMovingCount << ","
+      << mTicks << "," << mDistribution << "," << mShape << "," << (mContinuous ? 1 : 0) << ","
+      << mSweepAxes << "," << mThreadCount << ","
+      << theResults.Nanoseconds / anTicks << "," << theResults.MinNanoseconds << ","
+      << theResults.MaxNanoseconds << "," << theResults.Proxies / anTicks << ","
+      << theResults.Pairs / anTicks << "," << theResults.Tests / anTicks << ","
+      << theResults.Contacts / anTicks << "," << theResults.Allocations / anTicks << ","
+      << theResults.Bytes / anTicks << std::endl;
+  }
+  else
+  {
+    theStream << "CollisionBench " << mLabel << std::endl
+      << "  " << mStaticCount << " static and " << mMovingCount << " moving "
+      << mShape << " colliders (" << mDistribution << "), " << mTicks << " ticks, "
+      << mThreadCount << " threads, " << GQE::GetSATInstructionSet() << std::endl
+      << "  ns/tick: " << theResults.Nanoseconds / anTicks << " (min "
+      << theResults.MinNanoseconds << ", max " << theResults.MaxNanoseconds << ")" << std::endl
+      << "  per tick: " << theResults.Proxies / anTicks << " proxies, "
+      << theResults.Pairs / anTicks << " pairs, " << theResults.Tests / anTicks << " tests, "
+      << theResults.Contacts / anTicks << " contacts, "
+      << theResults.Allocations / anTicks << " allocations ("
+      << theResults.Bytes / anTicks << " bytes)" << std::endl;
+  }
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,219 @@
+/**
+ * Provides the BenchState class which fills a BenchCollisionSystem with
+ * static and moving colliders and measures each collision update.
+ *
+ * @file examples/collisionbench/src/BenchState.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Note that allocations are only counted with one thread
+ */
+#ifndef   BENCH_STATE_HPP_INCLUDED
+#define   BENCH_STATE_HPP_INCLUDED
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/interfaces/IState.hpp>
+#include <GQE/Entity/interfaces/IEntity.hpp>
+#include <GQE/Entity/classes/PolygonShape.hpp>
+#include <GQE/Entity/systems/TransformSystem.hpp>
+#include "BenchCollisionSystem.hpp"
+
+/// Provides the IEntity class added to each system by the BenchState
+class BenchEntity : public GQE::IEntity
+{
+  public:
+    /**
+     * BenchEntity constructor
+     */
+    BenchEntity();
+
+    /**
+     * BenchEntity deconstructor
+     */
+    virtual ~BenchEntity();
+
+    /**
+     * Destroy will remove this BenchEntity from every ISystem.
+     */
+    virtual void Destroy(void);
+}; // class BenchEntity
+
+/// Stores the totals of every timed update made by the BenchState
+struct BenchResults
+{
+  GQE::Uint64 Nanoseconds;
+  GQE::Uint64 MinNanoseconds;
+  GQE::Uint64 MaxNanoseconds;
+  GQE::Uint64 Proxies;
+  GQE::Uint64 Pairs;
+  GQE::Uint64 Tests;
+  GQE::Uint64 Contacts;
+  GQE::Uint64 Allocations;
+  GQE::Uint64 Bytes;
+  BenchResults() :
+    Nanoseconds(0),
+    MinNanoseconds(0),
+    MaxNanoseconds(0),
+    Proxies(0),
+    Pairs(0),
+    Tests(0),
+    Contacts(0),
+    Allocations(0),
+    Bytes(0)
+  {
+  }
+};
+
+/// Provides the benchmark for the CollisionBench example
+class BenchState : public GQE::IState
+{
+  public:
+    /**
+     * BenchState constructor
+     * @param[in] theApp is a pointer to the App class.
+     */
+    BenchState(GQE::IApp& theApp);
+
+    /**
+     * BenchState deconstructor
+     */
+    virtual ~BenchState(void);
+
+    /**
+     * DoInit is responsible for reading the benchmark settings and adding
+     * every IEntity to the systems being measured.
+     */
+    virtual void DoInit(void);
+
+    /**
+     * ReInit is responsible for Reseting this state when the
+     * StateManager::ResetActiveState() method is called.
+     */
+    virtual void ReInit(void);
+
+    /**
+     * UpdateFixed will run every update of the benchmark at once, write the
+     * results and then quit the application. The updates aren't paced by
+     * the game loop so the update rate doesn't limit the benchmark.
+     */
+    virtual void UpdateFixed(void);
+
+    /**
+     * UpdateVariable is not used by the benchmark.
+     * @param[in] theElapsedTime since the last Draw was called
+     */
+    virtual void UpdateVariable(float theElapsedTime);
+
+    /**
+     * Draw is not used by the console only benchmark.
+     */
+    virtual void Draw(void);
+
+  protected:
+    /**
+     * HandleCleanup is responsible for removing every IEntity created.
+     */
+    virtual void HandleCleanup(void);
+
+  private:
+    /**
+     * LoadSettings will read the [benchmark] section of settings.cfg.
+     */
+    void LoadSettings(void);
+
+    /**
+     * AddEntity will create a single IEntity with a random collider and add
+     * it to each system.
+     * @param[in] theMovable indicates the IEntity should move every update
+     */
+    void AddEntity(const bool theMovable);
+
+    /**
+     * MakePosition will return a random position using the distribution
+     * chosen in settings.cfg.
+     * @return the position of the next IEntity
+     */
+    sf::Vector2f MakePosition(void);
+
+    /**
+     * RunBenchmark will perform the untimed warmup updates followed by the
+     * timed updates whose totals are added to theResults provided.
+     * @param[out] theResults to add the totals to
+     */
+    void RunBenchmark(BenchResults& theResults);
+
+    /**
+     * WriteResults will write theResults provided to theStream using the
+     * format chosen in settings.cfg.
+     * @param[in] theResults to write
+     * @param[in] theStream to write to
+     * @param[in] theHeader indicates the CSV column names should be written
+     */
+    void WriteResults(const BenchResults& theResults, std::ostream& theStream,
+        const bool theHeader) const;
+
+    // Variables
+    /////////////////////////////////////////////////////////////////////////
+    /// Moves each IEntity by its velocity every update
+    GQE::TransformSystem mTransformSystem;
+    /// The collision system being measured
+    BenchCollisionSystem* mCollisionSystem;
+    /// The concave outline shared by every concave collider
+    GQE::PolygonShape mConcaveShape;
+    /// Every IEntity created
+    std::vector<BenchEntity*> mEntities;
+    /// The center of each cluster used by the clustered distribution
+    std::vector<sf::Vector2f> mClusters;
+    GQE::Uint32 mStaticCount;
+    GQE::Uint32 mMovingCount;
+    GQE::Uint32 mWarmup;
+    GQE::Uint32 mTicks;
+    GQE::Uint32 mClusterCount;
+    GQE::Uint32 mSweepAxes;
+    GQE::Uint32 mThreadCount;
+    GQE::Uint32 mSeed;
+    float mWorldSize;
+    float mMinSize;
+    float mMaxSize;
+    float mSpeed;
+    bool mContinuous;
+    std::string mDistribution;
+    std::string mShape;
+    std::string mFormat;
+    std::string mOutput;
+    std::string mLabel;
+}; // class BenchState
+
+#endif // BENCH_STATE_HPP_INCLUDED
+
+/**
+ * @class BenchState
+ * @ingroup Examples
+ * The BenchState class provides the CollisionBench example. It places the
+ * number of static and moving colliders given in settings.cfg in a square
+ * world, runs a number of fixed updates of the collision system and reports
+ * the time taken by each update along with the proxies, candidate pairs,
+ * narrowphase tests, contacts and heap allocations of an average update.
+ * Heap allocations are only counted correctly when threads=1.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
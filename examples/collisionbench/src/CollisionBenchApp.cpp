@@ -0,0 +1,56 @@
+/**
+ * Provides the CollisionBench application which measures the collision
+ * system without opening a window.
+ *
+ * @file examples/collisionbench/src/CollisionBenchApp.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+#include "CollisionBenchApp.hpp"
+#include "BenchState.hpp"
+
+CollisionBenchApp::CollisionBenchApp(const std::string theTitle) :
+  GQE::IApp(theTitle)
+{
+}
+
+CollisionBenchApp::~CollisionBenchApp()
+{
+}
+
+void CollisionBenchApp::InitAssetHandlers(void)
+{
+  // No custom asset handlers needed or provided
+}
+
+void CollisionBenchApp::InitScreenFactory(void)
+{
+  // The benchmark is the only state
+  mStateManager.AddActiveState(new(std::nothrow) BenchState(*this));
+}
+
+void CollisionBenchApp::HandleCleanup(void)
+{
+  // No custom cleanup needed
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
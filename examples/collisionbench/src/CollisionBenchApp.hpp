@@ -0,0 +1,75 @@
+/**
+ * Provides the CollisionBench application which measures the collision
+ * system without opening a window.
+ *
+ * @file examples/collisionbench/src/CollisionBenchApp.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+#ifndef   COLLISION_BENCH_APP_HPP_INCLUDED
+#define   COLLISION_BENCH_APP_HPP_INCLUDED
+
+#include <GQE/Core/interfaces/IApp.hpp>
+
+/// Provides the console only application for the CollisionBench example.
+class CollisionBenchApp : public GQE::IApp
+{
+  public:
+    /**
+     * CollisionBenchApp constructor
+     * @param[in] theTitle is the title of the application
+     */
+    CollisionBenchApp(const std::string theTitle = "CollisionBench");
+
+    /**
+     * CollisionBenchApp deconstructor
+     */
+    virtual ~CollisionBenchApp();
+
+  protected:
+    /**
+      * InitAssetHandlers is responsible for registering custom IAssetHandler
+      * derived classes for a specific game application.
+      */
+    virtual void InitAssetHandlers(void);
+
+    /**
+      * InitScreenFactory is responsible for adding the BenchState as the
+      * active state.
+      */
+    virtual void InitScreenFactory(void);
+
+    /**
+      * HandleCleanup is responsible for performing any custom last minute
+      * Application cleanup steps before exiting the Application.
+      */
+    virtual void HandleCleanup(void);
+}; // class CollisionBenchApp
+
+#endif // COLLISION_BENCH_APP_HPP_INCLUDED
+
+/**
+ * @class CollisionBenchApp
+ * @ingroup Examples
+ * The CollisionBenchApp class runs the BenchState in console only mode
+ * (bWindowConsole) so the benchmark can run on machines without a display.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
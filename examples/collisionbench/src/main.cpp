@@ -0,0 +1,71 @@
+/**
+ * Headless benchmark for the ICollisionSystem class. It fills the collision
+ * system with the static and moving colliders described by the [benchmark]
+ * section of resources/settings.cfg, runs a number of fixed updates and
+ * reports the time, broadphase pairs, narrowphase tests, contacts and heap
+ * allocations of an average update as text, JSON or CSV.
+ *
+ * @file examples/collisionbench/src/main.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <GQE/Core.hpp>
+#include "CollisionBenchApp.hpp"
+
+/**
+ * The starting point of the CollisionBench application
+ * @param[in] argc the number of command line arguments provided
+ * @param[in] argv[] the array of command line arguments provided as an array
+ * @return the result returned by the CollisionBench application
+ */
+int main(int argc, char* argv[])
+{
+  // Default anExitCode to a specific value
+  int anExitCode = GQE::StatusNoError;
+
+  // Log to a file so the console only shows the results
+  GQE::FileLogger anLogger("output.txt", true);
+
+  // Create our benchmark application
+  GQE::IApp* anApp = new(std::nothrow) CollisionBenchApp();
+  assert(NULL != anApp && "main() Can't create Application");
+
+  // Process command line arguments
+  anApp->ProcessArguments(argc, argv);
+
+  // Run the benchmark and write the results
+  anExitCode = anApp->Run();
+
+  // Cleanup ourselves by deleting the benchmark application
+  delete anApp;
+
+  // Don't keep pointers to objects we have just deleted
+  anApp = NULL;
+
+  // return our exit code
+  return anExitCode;
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
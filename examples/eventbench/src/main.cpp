@@ -0,0 +1,208 @@
+/**
+ * Microbenchmark for EventManager dispatch. It registers a number of events
+ * and reports the number of dispatches per second when looking each event up
+ * in a string keyed map (the way EventManager used to), by name, by the
+ * typeEventIndex each name is interned as and when queued and delivered to a
+ * TBatchEvent handler by Flush.
+ *
+ * @file examples/eventbench/src/main.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add queued batch dispatch
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <SFML/System.hpp>
+#include <GQE/Core/classes/EventManager.hpp>
+
+/// Handler used by every event so only the dispatch itself is measured
+class BenchHandler
+{
+  public:
+    BenchHandler() :
+      mTotal(0)
+    {
+    }
+
+    void EventCount(GQE::Uint32* theContext)
+    {
+      mTotal += *theContext;
+    }
+
+    void EventBatch(GQE::Uint32* theContexts, GQE::Uint32 theCount)
+    {
+      for(GQE::Uint32 anIndex = 0; anIndex < theCount; ++anIndex)
+      {
+        mTotal += theContexts[anIndex];
+      }
+    }
+
+    GQE::Uint64 mTotal;
+};
+
+/// Map of events keyed by name the way EventManager stored them before
+typedef std::map<const GQE::typeEventID, GQE::IEvent*> typeEventMap;
+
+/**
+ * DoMapEvent will dispatch theEventID the way EventManager::DoEvent did
+ * before event IDs were interned (theEventID is passed by value on purpose).
+ * @param[in] theMap of events to search
+ * @param[in] theEventID to dispatch
+ * @param[in] theContext to provide to the event
+ */
+void DoMapEvent(typeEventMap& theMap, GQE::typeEventID theEventID, void* theContext)
+{
+  typeEventMap::const_iterator anIter = theMap.find(theEventID);
+  if(anIter != theMap.end())
+  {
+    anIter->second->DoEvent(theContext);
+  }
+}
+
+/**
+ * PrintResult will print the number of dispatches per second.
+ * @param[in] theName of the dispatch method
+ * @param[in] theDispatches done
+ * @param[in] theSeconds it took
+ * @param[in] theTotal counted by the handler, to check every event was done
+ */
+void PrintResult(const char* theName, double theDispatches, float theSeconds,
+    GQE::Uint64 theTotal)
+{
+  std::cout << theName << ": " << (GQE::Uint64)(theDispatches / theSeconds)
+    << " dispatches/s (" << theTotal << " handled)" << std::endl;
+}
+
+/**
+ * The starting point of the EventBench application
+ * @param[in] argc the number of command line arguments provided
+ * @param[in] argv[] the array of command line arguments provided as an array
+ * @return the result returned by the EventBench application
+ */
+int main(int argc, char* argv[])
+{
+  // Optional arguments are the number of events and iterations to run
+  GQE::Uint32 anEventCount = (argc > 1) ? (GQE::Uint32)atoi(argv[1]) : 64;
+  GQE::Uint32 anIterations = (argc > 2) ? (GQE::Uint32)atoi(argv[2]) : 100000;
+  if(anEventCount == 0)
+  {
+    anEventCount = 1;
+  }
+
+  // Use names that share a long prefix like most game event names do
+  BenchHandler anHandler;
+  GQE::EventManager anManager;
+  typeEventMap anMap;
+  std::vector<GQE::typeEventID> anNames;
+  std::vector<GQE::typeEventIndex> anIndexes;
+  std::vector<GQE::typeEventIndex> anBatches;
+  for(GQE::Uint32 anEvent = 0; anEvent < anEventCount; ++anEvent)
+  {
+    char anName[32];
+    sprintf(anName, "PlayerInputEvent%u", anEvent);
+    anNames.push_back(anName);
+    anManager.Add<BenchHandler, GQE::Uint32>(anName, anHandler, &BenchHandler::EventCount);
+    anIndexes.push_back(anManager.GetIndex(anName));
+    anMap.insert(typeEventMap::value_type(anName,
+          new(std::nothrow) GQE::TEvent<BenchHandler, GQE::Uint32>(anName, anHandler,
+            &BenchHandler::EventCount)));
+    sprintf(anName, "PlayerBatchEvent%u", anEvent);
+    anManager.SubscribeBatch<BenchHandler, GQE::Uint32>(anName, anHandler, &BenchHandler::EventBatch);
+    anBatches.push_back(anManager.GetIndex(anName));
+  }
+
+  GQE::Uint32 anContext = 1;
+  double anDispatches = (double)anEventCount * anIterations;
+  std::cout << "Dispatching " << anEventCount << " events " << anIterations
+    << " times each" << std::endl;
+
+  anHandler.mTotal = 0;
+  sf::Clock anClock;
+  for(GQE::Uint32 anIteration = 0; anIteration < anIterations; ++anIteration)
+  {
+    for(GQE::Uint32 anEvent = 0; anEvent < anEventCount; ++anEvent)
+    {
+      DoMapEvent(anMap, anNames[anEvent], &anContext);
+    }
+  }
+  PrintResult("String map (before)", anDispatches,
+      anClock.getElapsedTime().asSeconds(), anHandler.mTotal);
+
+  anHandler.mTotal = 0;
+  anClock.restart();
+  for(GQE::Uint32 anIteration = 0; anIteration < anIterations; ++anIteration)
+  {
+    for(GQE::Uint32 anEvent = 0; anEvent < anEventCount; ++anEvent)
+    {
+      anManager.DoEvent(anNames[anEvent], &anContext);
+    }
+  }
+  PrintResult("Event ID", anDispatches,
+      anClock.getElapsedTime().asSeconds(), anHandler.mTotal);
+
+  anHandler.mTotal = 0;
+  anClock.restart();
+  for(GQE::Uint32 anIteration = 0; anIteration < anIterations; ++anIteration)
+  {
+    for(GQE::Uint32 anEvent = 0; anEvent < anEventCount; ++anEvent)
+    {
+      anManager.DoEvent(anIndexes[anEvent], &anContext);
+    }
+  }
+  PrintResult("Event index", anDispatches,
+      anClock.getElapsedTime().asSeconds(), anHandler.mTotal);
+
+  // Queue each event a few times per flush like a busy fixed update would
+  const GQE::Uint32 anPerFlush = 8;
+  anHandler.mTotal = 0;
+  anClock.restart();
+  for(GQE::Uint32 anIteration = 0; anIteration < anIterations; anIteration += anPerFlush)
+  {
+    for(GQE::Uint32 anEvent = 0; anEvent < anEventCount; ++anEvent)
+    {
+      for(GQE::Uint32 anQueued = 0; anQueued < anPerFlush; ++anQueued)
+      {
+        anManager.Queue(anBatches[anEvent], anContext);
+      }
+    }
+    anManager.Flush(GQE::EventPhaseFixed);
+  }
+  PrintResult("Queued batch", (double)anEventCount *
+      ((anIterations + anPerFlush - 1) / anPerFlush) * anPerFlush,
+      anClock.getElapsedTime().asSeconds(), anHandler.mTotal);
+
+  // Cleanup the events used by the string map
+  typeEventMap::iterator anIter;
+  for(anIter = anMap.begin(); anIter != anMap.end(); ++anIter)
+  {
+    delete anIter->second;
+  }
+  anMap.clear();
+
+  return 0;
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
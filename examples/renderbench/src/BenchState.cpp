@@ -0,0 +1,332 @@
+/**
+ * Provides the BenchState class which fills a RenderSystem with static and
+ * moving sprites and measures each frame drawn to a NullRenderTarget.
+ *
+ * @file examples/renderbench/src/BenchState.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add bake setting to mark the static sprites bStatic
+ */
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <math.h>
+#include <GQE/Core/assets/ConfigAsset.hpp>
+#include <GQE/Core/interfaces/IApp.hpp>
+#include <GQE/Core/utils/MathUtil.hpp>
+#include "BenchState.hpp"
+
+BenchEntity::BenchEntity(GQE::Uint32 theOrder) :
+  GQE::IEntity(theOrder)
+{
+}
+
+BenchEntity::~BenchEntity()
+{
+  DropAllSystems();
+}
+
+void BenchEntity::Destroy(void)
+{
+  DropAllSystems();
+}
+
+BenchState::BenchState(GQE::IApp& theApp) :
+  GQE::IState("Bench", theApp),
+  mTarget(),
+  mTransformSystem(theApp),
+  mRenderSystem(theApp),
+  mStaticCount(0),
+  mMovingCount(0),
+  mTextureCount(1),
+  mLayerCount(1),
+  mWarmup(0),
+  mFrames(1),
+  mSeed(1),
+  mBake(true),
+  mWorldSize(1.0f),
+  mSpriteSize(1.0f),
+  mSpeed(0.0f),
+  mPan(0.0f),
+  mViewSize(1.0f, 1.0f)
+{
+}
+
+BenchState::~BenchState(void)
+{
+  HandleCleanup();
+}
+
+void BenchState::DoInit(void)
+{
+  // First call our base class implementation
+  IState::DoInit();
+
+  LoadSettings();
+
+  // Every frame is counted by our NullRenderTarget instead of being drawn
+  mApp.SetRenderTarget(&mTarget);
+  mTransformSystem.SetRenderSystem(&mRenderSystem);
+
+  // Size the textures first since each IEntity keeps a pointer to one
+  mTextures.resize(mTextureCount);
+
+  // Use a fixed seed so every run creates the same world
+  GQE::SetSeed(mSeed);
+  for(GQE::Uint32 anIndex = 0; anIndex < mStaticCount; ++anIndex)
+  {
+    AddEntity(false);
+  }
+  for(GQE::Uint32 anIndex = 0; anIndex < mMovingCount; ++anIndex)
+  {
+    AddEntity(true);
+  }
+}
+
+void BenchState::ReInit(void)
+{
+}
+
+void BenchState::UpdateFixed(void)
+{
+  BenchResults anResults;
+  RunBenchmark(anResults);
+
+  if(mOutput.empty())
+  {
+    WriteResults(anResults, std::cout, true);
+  }
+  else
+  {
+    // Only start a CSV file with the column names if the file is empty so
+    // each run can be appended to the same file
+    bool anHeader = true;
+    if(mFormat == "csv")
+    {
+      std::ifstream anExisting(mOutput.c_str());
+      anHeader = !anExisting.is_open() || anExisting.peek() == std::ifstream::traits_type::eof();
+    }
+    std::ofstream anFile(mOutput.c_str(),
+        mFormat == "csv" ? std::ios::out | std::ios::app : std::ios::out | std::ios::trunc);
+    if(!anFile.is_open())
+    {
+      std::cerr << "Unable to open " << mOutput << std::endl;
+      mApp.Quit(GQE::StatusError);
+      return;
+    }
+    WriteResults(anResults, anFile, anHeader);
+  }
+
+  mApp.Quit(GQE::StatusAppOK);
+}
+
+void BenchState::UpdateVariable(float theElapsedTime)
+{
+}
+
+void BenchState::Draw(void)
+{
+}
+
+void BenchState::HandleCleanup(void)
+{
+  // Each BenchEntity drops itself from every system
+  std::vector<BenchEntity*>::iterator anIter;
+  for(anIter = mEntities.begin(); anIter != mEntities.end(); ++anIter)
+  {
+    delete *anIter;
+  }
+  mEntities.clear();
+
+  // Don't leave the IApp drawing to our NullRenderTarget
+  mApp.SetRenderTarget(NULL);
+}
+
+void BenchState::LoadSettings(void)
+{
+  GQE::ConfigAsset anSettingsConfig(GQE::IApp::APP_SETTINGS);
+  GQE::ConfigReader& anConfig = anSettingsConfig.GetAsset();
+  mStaticCount = anConfig.GetUint32("benchmark", "statics", 20000);
+  mMovingCount = anConfig.GetUint32("benchmark", "moving", 2000);
+  mTextureCount = anConfig.GetUint32("benchmark", "textures", 8);
+  mTextureCount = mTextureCount > 0 ? mTextureCount : 1;
+  mLayerCount = anConfig.GetUint32("benchmark", "layers", 4);
+  mLayerCount = mLayerCount > 0 ? mLayerCount : 1;
+  mWarmup = anConfig.GetUint32("benchmark", "warmup", 30);
+  mFrames = anConfig.GetUint32("benchmark", "frames", 300);
+  mFrames = mFrames > 0 ? mFrames : 1;
+  mWorldSize = anConfig.GetFloat("benchmark", "world", 8000.0f);
+  mSpriteSize = anConfig.GetFloat("benchmark", "size", 32.0f);
+  mSpeed = anConfig.GetFloat("benchmark", "speed", 4.0f);
+  mPan = anConfig.GetFloat("benchmark", "pan", 2.0f);
+  mViewSize.x = anConfig.GetFloat("benchmark", "viewwidth", 1280.0f);
+  mViewSize.y = anConfig.GetFloat("benchmark", "viewheight", 720.0f);
+  mSeed = anConfig.GetUint32("benchmark", "seed", 1);
+  mBake = anConfig.GetBool("benchmark", "bake", true);
+  mFormat = anConfig.GetString("benchmark", "format", "text");
+  mOutput = anConfig.GetString("benchmark", "output", "");
+  mLabel = anConfig.GetString("benchmark", "label", "");
+}
+
+void BenchState::AddEntity(const bool theMovable)
+{
+  BenchEntity* anEntity = new(std::nothrow) BenchEntity(GQE::Random(0U, mLayerCount - 1));
+  if(NULL == anEntity)
+  {
+    return;
+  }
+  mEntities.push_back(anEntity);
+
+  // Set our properties before each system adds its default values
+  GQE::Uint32 anSize = (GQE::Uint32)mSpriteSize;
+  sf::Texture* anTexture = &mTextures[GQE::Random(0U, mTextureCount - 1)];
+  anEntity->mProperties.Add<sf::Texture*>("Texture", anTexture);
+  anEntity->mProperties.Add<sf::IntRect>("rTextureRect", sf::IntRect(0, 0, anSize, anSize));
+  anEntity->mProperties.Add<sf::Vector2f>("vOrigin", sf::Vector2f(0.5f, 0.5f));
+  anEntity->mProperties.Add<sf::Vector2f>("vPosition",
+      sf::Vector2f(GQE::Random(0.0f, mWorldSize), GQE::Random(0.0f, mWorldSize)));
+  anEntity->mProperties.Add<bool>("bMovable", theMovable);
+  anEntity->mProperties.Add<bool>("bStatic", !theMovable && mBake);
+  if(theMovable)
+  {
+    float anAngle = GQE::ToRadians(GQE::Random(0.0f, 360.0f));
+    anEntity->mProperties.Add<sf::Vector2f>("vVelocity",
+        sf::Vector2f(mSpeed * cos(anAngle), mSpeed * sin(anAngle)));
+  }
+
+  mTransformSystem.AddEntity(anEntity);
+  mRenderSystem.AddEntity(anEntity);
+}
+
+GQE::Uint64 BenchState::DrawFrame(const GQE::Uint32 theFrame)
+{
+  mTransformSystem.UpdateFixed();
+
+  // Pan the view diagonally across the world and wrap around at the end
+  float anTravel = mWorldSize > mViewSize.x ? mWorldSize - mViewSize.x : 1.0f;
+  float anOffset = fmod(mPan * theFrame, anTravel);
+  sf::View anView(sf::Vector2f(mViewSize.x / 2 + anOffset,
+        mViewSize.y / 2 + anOffset * mViewSize.y / mViewSize.x), mViewSize);
+  mRenderSystem.SetView("", anView);
+
+  // Only the RenderSystem::Draw call itself is measured
+  sf::Clock anClock;
+  mTarget.Reset();
+  mRenderSystem.Draw();
+  return (GQE::Uint64)anClock.getElapsedTime().asMicroseconds() * 1000;
+}
+
+void BenchState::RunBenchmark(BenchResults& theResults)
+{
+  // Let the SpatialGrid, render queue and every cache reach its working size
+  GQE::Uint32 anFrame;
+  for(anFrame = 0; anFrame < mWarmup; ++anFrame)
+  {
+    DrawFrame(anFrame);
+  }
+
+  for(GQE::Uint32 anTimed = 0; anTimed < mFrames; ++anTimed, ++anFrame)
+  {
+    GQE::Uint64 anNanoseconds = DrawFrame(anFrame);
+    theResults.Nanoseconds += anNanoseconds;
+    if(anTimed == 0 || anNanoseconds < theResults.MinNanoseconds)
+    {
+      theResults.MinNanoseconds = anNanoseconds;
+    }
+    if(anNanoseconds > theResults.MaxNanoseconds)
+    {
+      theResults.MaxNanoseconds = anNanoseconds;
+    }
+
+    const GQE::RenderStats& anStats = mRenderSystem.GetStats();
+    theResults.Candidates += anStats.Candidates;
+    theResults.Items += anStats.Items;
+    theResults.DrawCalls += mTarget.GetDrawCalls();
+    theResults.Vertices += mTarget.GetVertexCount();
+    theResults.StateChanges += mTarget.GetStateChanges();
+    theResults.Chunks += anStats.Chunks;
+  }
+}
+
+void BenchState::WriteResults(const BenchResults& theResults, std::ostream& theStream,
+    const bool theHeader) const
+{
+  double anFrames = (double)mFrames;
+  theStream << std::fixed << std::setprecision(1);
+  if(mFormat == "json")
+  {
+    theStream << "{" << std::endl
+      << "  \"label\": \"" << mLabel << "\"," << std::endl
+      << "  \"version\": \"" << GQE_VERSION_MAJOR << "." << GQE_VERSION_MINOR << "\"," << std::endl
+      << "  \"statics\": " << mStaticCount << "," << std::endl
+      << "  \"moving\": " << mMovingCount << "," << std::endl
+      << "  \"textures\": " << mTextureCount << "," << std::endl
+      << "  \"layers\": " << mLayerCount << "," << std::endl
+      << "  \"bake\": " << (mBake ? "true" : "false") << "," << std::endl
+      << "  \"frames\": " << mFrames << "," << std::endl
+      << "  \"ns_per_frame\": " << theResults.Nanoseconds / anFrames << "," << std::endl
+      << "  \"ns_min\": " << theResults.MinNanoseconds << "," << std::endl
+      << "  \"ns_max\": " << theResults.MaxNanoseconds << "," << std::endl
+      << "  \"candidates_per_frame\": " << theResults.Candidates / anFrames << "," << std::endl
+      << "  \"visible_per_frame\": " << theResults.Items / anFrames << "," << std::endl
+      << "  \"draw_calls_per_frame\": " << theResults.DrawCalls / anFrames << "," << std::endl
+      << "  \"vertices_per_frame\": " << theResults.Vertices / anFrames << "," << std::endl
+      << "  \"state_changes_per_frame\": " << theResults.StateChanges / anFrames << "," << std::endl
+      << "  \"chunks_per_frame\": " << theResults.Chunks / anFrames << std::endl
+      << "}" << std::endl;
+  }
+  else if(mFormat == "csv")
+  {
+    if(theHeader)
+    {
+      theStream << "label,version,statics,moving,textures,layers,bake,frames,"
+        << "ns_per_frame,ns_min,ns_max,candidates_per_frame,visible_per_frame,"
+        << "draw_calls_per_frame,vertices_per_frame,state_changes_per_frame,"
+        << "chunks_per_frame" << std::endl;
+    }
+    theStream << mLabel << "," << GQE_VERSION_MAJOR << "." << GQE_VERSION_MINOR << ","
+      << mStaticCount << "," << mMovingCount << "," << mTextureCount << ","
+      << mLayerCount << "," << (mBake ? 1 : 0) << "," << mFrames << ","
+      << theResults.Nanoseconds / anFrames << "," << theResults.MinNanoseconds << ","
+      << theResults.MaxNanoseconds << "," << theResults.Candidates / anFrames << ","
+      << theResults.Items / anFrames << "," << theResults.DrawCalls / anFrames << ","
+      << theResults.Vertices / anFrames << "," << theResults.StateChanges / anFrames << ","
+      << theResults.Chunks / anFrames << std::endl;
+  }
+  else
+  {
+    theStream << "RenderBench " << mLabel << std::endl
+      << "  " << mStaticCount << " static and " << mMovingCount << " moving sprites, "
+      << mTextureCount << " textures, " << mLayerCount << " layers, "
+      << mFrames << " frames" << (mBake ? ", statics baked" : "") << std::endl
+      << "  ns/frame: " << theResults.Nanoseconds / anFrames << " (min "
+      << theResults.MinNanoseconds << ", max " << theResults.MaxNanoseconds << ")" << std::endl
+      << "  per frame: " << theResults.Candidates / anFrames << " candidates, "
+      << theResults.Items / anFrames << " visible, "
+      << theResults.DrawCalls / anFrames << " draw calls, "
+      << theResults.Vertices / anFrames << " vertices, "
+      << theResults.StateChanges / anFrames << " state changes, "
+      << theResults.Chunks / anFrames << " chunks" << std::endl;
+  }
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
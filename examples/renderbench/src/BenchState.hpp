@@ -0,0 +1,220 @@
+/**
+ * Provides the BenchState class which fills a RenderSystem with static and
+ * moving sprites and measures each frame drawn to a NullRenderTarget.
+ *
+ * @file examples/renderbench/src/BenchState.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add bake setting to mark the static sprites bStatic
+ */
+#ifndef   BENCH_STATE_HPP_INCLUDED
+#define   BENCH_STATE_HPP_INCLUDED
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/classes/NullRenderTarget.hpp>
+#include <GQE/Core/interfaces/IState.hpp>
+#include <GQE/Entity/interfaces/IEntity.hpp>
+#include <GQE/Entity/systems/RenderSystem.hpp>
+#include <GQE/Entity/systems/TransformSystem.hpp>
+
+/// Provides the IEntity class added to each system by the BenchState
+class BenchEntity : public GQE::IEntity
+{
+  public:
+    /**
+     * BenchEntity constructor
+     * @param[in] theOrder is the layer to draw this BenchEntity in
+     */
+    BenchEntity(GQE::Uint32 theOrder);
+
+    /**
+     * BenchEntity deconstructor
+     */
+    virtual ~BenchEntity();
+
+    /**
+     * Destroy will remove this BenchEntity from every ISystem.
+     */
+    virtual void Destroy(void);
+}; // class BenchEntity
+
+/// Stores the totals of every timed frame drawn by the BenchState
+struct BenchResults
+{
+  GQE::Uint64 Nanoseconds;
+  GQE::Uint64 MinNanoseconds;
+  GQE::Uint64 MaxNanoseconds;
+  GQE::Uint64 Candidates;
+  GQE::Uint64 Items;
+  GQE::Uint64 DrawCalls;
+  GQE::Uint64 Vertices;
+  GQE::Uint64 StateChanges;
+  GQE::Uint64 Chunks;
+  BenchResults() :
+    Nanoseconds(0),
+    MinNanoseconds(0),
+    MaxNanoseconds(0),
+    Candidates(0),
+    Items(0),
+    DrawCalls(0),
+    Vertices(0),
+    StateChanges(0),
+    Chunks(0)
+  {
+  }
+};
+
+/// Provides the benchmark for the RenderBench example
+class BenchState : public GQE::IState
+{
+  public:
+    /**
+     * BenchState constructor
+     * @param[in] theApp is a pointer to the App class.
+     */
+    BenchState(GQE::IApp& theApp);
+
+    /**
+     * BenchState deconstructor
+     */
+    virtual ~BenchState(void);
+
+    /**
+     * DoInit is responsible for reading the benchmark settings and adding
+     * every IEntity to the systems being measured.
+     */
+    virtual void DoInit(void);
+
+    /**
+     * ReInit is responsible for Reseting this state when the
+     * StateManager::ResetActiveState() method is called.
+     */
+    virtual void ReInit(void);
+
+    /**
+     * UpdateFixed will draw every frame of the benchmark at once, write the
+     * results and then quit the application. The frames aren't paced by
+     * the game loop so the update rate doesn't limit the benchmark.
+     */
+    virtual void UpdateFixed(void);
+
+    /**
+     * UpdateVariable is not used by the benchmark.
+     * @param[in] theElapsedTime since the last Draw was called
+     */
+    virtual void UpdateVariable(float theElapsedTime);
+
+    /**
+     * Draw is not used by the benchmark, see UpdateFixed.
+     */
+    virtual void Draw(void);
+
+  protected:
+    /**
+     * HandleCleanup is responsible for removing every IEntity created.
+     */
+    virtual void HandleCleanup(void);
+
+  private:
+    /**
+     * LoadSettings will read the [benchmark] section of settings.cfg.
+     */
+    void LoadSettings(void);
+
+    /**
+     * AddEntity will create a single IEntity with a random Texture, layer
+     * and position and add it to each system.
+     * @param[in] theMovable indicates the IEntity should move every frame
+     */
+    void AddEntity(const bool theMovable);
+
+    /**
+     * DrawFrame will move every moving IEntity and the view and then draw
+     * a single frame to the NullRenderTarget.
+     * @param[in] theFrame number used to place the view
+     * @return the time taken by RenderSystem::Draw in nanoseconds
+     */
+    GQE::Uint64 DrawFrame(const GQE::Uint32 theFrame);
+
+    /**
+     * RunBenchmark will draw the untimed warmup frames followed by the
+     * timed frames whose totals are added to theResults provided.
+     * @param[out] theResults to add the totals to
+     */
+    void RunBenchmark(BenchResults& theResults);
+
+    /**
+     * WriteResults will write theResults provided to theStream using the
+     * format chosen in settings.cfg.
+     * @param[in] theResults to write
+     * @param[in] theStream to write to
+     * @param[in] theHeader indicates the CSV column names should be written
+     */
+    void WriteResults(const BenchResults& theResults, std::ostream& theStream,
+        const bool theHeader) const;
+
+    // Variables
+    /////////////////////////////////////////////////////////////////////////
+    /// Counts each draw call instead of drawing it
+    GQE::NullRenderTarget mTarget;
+    /// Moves each IEntity by its velocity every frame
+    GQE::TransformSystem mTransformSystem;
+    /// The render system being measured
+    GQE::RenderSystem mRenderSystem;
+    /// The textures shared by every IEntity, they are never loaded
+    std::vector<sf::Texture> mTextures;
+    /// Every IEntity created
+    std::vector<BenchEntity*> mEntities;
+    GQE::Uint32 mStaticCount;
+    GQE::Uint32 mMovingCount;
+    GQE::Uint32 mTextureCount;
+    GQE::Uint32 mLayerCount;
+    GQE::Uint32 mWarmup;
+    GQE::Uint32 mFrames;
+    GQE::Uint32 mSeed;
+    /// True if the static sprites are baked into RenderSystem chunks
+    bool mBake;
+    float mWorldSize;
+    float mSpriteSize;
+    float mSpeed;
+    float mPan;
+    sf::Vector2f mViewSize;
+    std::string mFormat;
+    std::string mOutput;
+    std::string mLabel;
+}; // class BenchState
+
+#endif // BENCH_STATE_HPP_INCLUDED
+
+/**
+ * @class BenchState
+ * @ingroup Examples
+ * The BenchState class provides the RenderBench example. It places the number
+ * of static and moving sprites given in settings.cfg in a square world, pans
+ * a view across it and reports the time taken by each RenderSystem::Draw
+ * along with the visible sprites, draw calls, vertices and state changes of
+ * an average frame. Every frame is drawn to a NullRenderTarget and the
+ * textures are never loaded so no window or OpenGL context is needed.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
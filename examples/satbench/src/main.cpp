@@ -0,0 +1,283 @@
+/**
+ * Microbenchmark for the separating axis tests provided by CollisionUtil. It
+ * creates random convex polygon pairs and reports the number of pair tests per
+ * second for the scalar, SSE2 and AVX2 versions as well as any pair where the
+ * SIMD versions disagree with the scalar version. The exit code is non-zero
+ * if any version disagrees.
+ *
+ * @file examples/satbench/src/main.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Compare the result and translation, add irregular polygons and fail on mismatches
+ * @date 20261018 - Set the Center used to orient the minimum translation
+ * @date 20261018 - Skip the SSE2 and AVX2 rows the library wasn't built with
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <math.h>
+#include <SFML/System.hpp>
+#include <GQE/Core/utils/MathUtil.hpp>
+#include <GQE/Entity/utils/CollisionUtil.hpp>
+
+/// Signature shared by each of the separating axis test versions
+typedef bool (*typeSATFunction)(const GQE::CollisionCache&,
+    const GQE::CollisionCache&, sf::Vector2f&);
+
+/// Result of a separating axis test of one pair
+struct SATResult
+{
+  /// True if the pair intersects
+  bool Hit;
+  /// Minimum translation vector provided by the test
+  sf::Vector2f Translation;
+};
+
+/// Returns true if thePointA comes before thePointB from left to right
+bool ComparePoints(const sf::Vector2f& thePointA, const sf::Vector2f& thePointB)
+{
+  return thePointA.x < thePointB.x || (thePointA.x == thePointB.x && thePointA.y < thePointB.y);
+}
+
+/// Returns the cross product of the edges from theOrigin to theA and theB
+float Cross(const sf::Vector2f& theOrigin, const sf::Vector2f& theA, const sf::Vector2f& theB)
+{
+  return (theA.x - theOrigin.x) * (theB.y - theOrigin.y) -
+    (theA.y - theOrigin.y) * (theB.x - theOrigin.x);
+}
+
+/**
+ * MakeHull will replace thePoints provided with their convex hull in the
+ * same winding as the regular polygons made by MakePolygon.
+ * @param[in,out] thePoints to replace with their convex hull
+ */
+void MakeHull(std::vector<sf::Vector2f>& thePoints)
+{
+  std::sort(thePoints.begin(), thePoints.end(), ComparePoints);
+
+  // Build the lower and then the upper hull (Andrew's monotone chain)
+  std::vector<sf::Vector2f> anHull(thePoints.size() * 2);
+  size_t anCount = 0;
+  for(size_t anIndex = 0; anIndex < thePoints.size(); ++anIndex)
+  {
+    while(anCount >= 2 && Cross(anHull[anCount-2], anHull[anCount-1], thePoints[anIndex]) <= 0.0f)
+    {
+      anCount--;
+    }
+    anHull[anCount++] = thePoints[anIndex];
+  }
+  size_t anLower = anCount + 1;
+  for(size_t anIndex = thePoints.size() - 1; anIndex > 0; --anIndex)
+  {
+    while(anCount >= anLower && Cross(anHull[anCount-2], anHull[anCount-1], thePoints[anIndex-1]) <= 0.0f)
+    {
+      anCount--;
+    }
+    anHull[anCount++] = thePoints[anIndex-1];
+  }
+
+  // The last point is the same as the first one
+  anHull.resize(anCount - 1);
+  thePoints.swap(anHull);
+}
+
+/**
+ * MakePolygon will fill theCache provided with a random convex polygon
+ * centered at theCenter provided. A regular polygon has its points evenly
+ * spaced on a circle, an irregular one is the convex hull of random points
+ * within the circle.
+ * @param[in] theCache to fill
+ * @param[in] theCenter of the polygon
+ * @param[in] theIrregular is true to make an irregular polygon
+ */
+void MakePolygon(GQE::CollisionCache& theCache, sf::Vector2f theCenter, bool theIrregular)
+{
+  GQE::Uint32 anPointCount = GQE::Random(3U, 12U);
+  float anRadius = GQE::Random(5.0f, 25.0f);
+  float anRotation = GQE::Random(0.0f, 360.0f);
+
+  theCache.Points.clear();
+  theCache.Normals.clear();
+  if(theIrregular)
+  {
+    // Keep adding random points until their hull has at least 3 corners
+    std::vector<sf::Vector2f> anPoints;
+    while(theCache.Points.size() < 3)
+    {
+      for(GQE::Uint32 anIndex = 0; anIndex < anPointCount; ++anIndex)
+      {
+        float anAngle = GQE::ToRadians(GQE::Random(0.0f, 360.0f));
+        float anDistance = anRadius * sqrt(GQE::Random(0.0f, 1.0f));
+        anPoints.push_back(theCenter +
+            sf::Vector2f(anDistance * cos(anAngle), anDistance * sin(anAngle)));
+      }
+      theCache.Points = anPoints;
+      MakeHull(theCache.Points);
+    }
+    anPointCount = (GQE::Uint32)theCache.Points.size();
+  }
+  else
+  {
+    for(GQE::Uint32 anIndex = 0; anIndex < anPointCount; ++anIndex)
+    {
+      float anAngle = GQE::ToRadians(anRotation + (360.0f * anIndex) / anPointCount);
+      theCache.Points.push_back(theCenter +
+          sf::Vector2f(anRadius * cos(anAngle), anRadius * sin(anAngle)));
+    }
+  }
+
+  sf::Vector2f anMin = theCache.Points[0];
+  sf::Vector2f anMax = theCache.Points[0];
+  for(GQE::Uint32 anIndex = 0; anIndex < anPointCount; ++anIndex)
+  {
+    const sf::Vector2f& anPointA = theCache.Points[anIndex];
+    const sf::Vector2f& anPointB = theCache.Points[(anIndex + 1) % anPointCount];
+    theCache.Normals.push_back(GQE::NormalizeVector(
+          sf::Vector2f(anPointB.y - anPointA.y, -(anPointB.x - anPointA.x))));
+    anMin.x = anPointA.x < anMin.x ? anPointA.x : anMin.x;
+    anMin.y = anPointA.y < anMin.y ? anPointA.y : anMin.y;
+    anMax.x = anPointA.x > anMax.x ? anPointA.x : anMax.x;
+    anMax.y = anPointA.y > anMax.y ? anPointA.y : anMax.y;
+  }
+  theCache.Bounds = sf::FloatRect(anMin.x, anMin.y, anMax.x - anMin.x, anMax.y - anMin.y);
+  theCache.Center = sf::Vector2f(anMin.x + (anMax.x - anMin.x) / 2.0f,
+      anMin.y + (anMax.y - anMin.y) / 2.0f);
+  GQE::PadCollisionCache(theCache);
+}
+
+/**
+ * RunBenchmark will call theFunction for every pair theIterations times and
+ * print the number of pair tests per second.
+ * @param[in] theName of the version being tested
+ * @param[in] theFunction to call
+ * @param[in] theCaches to test as pairs (0,1), (2,3), ...
+ * @param[in] theIterations to run over every pair
+ * @param[in] theResults from the scalar version to compare against
+ * @return the number of pairs whose result or translation differ
+ */
+GQE::Uint32 RunBenchmark(const char* theName, typeSATFunction theFunction,
+    const std::vector<GQE::CollisionCache>& theCaches, GQE::Uint32 theIterations,
+    const std::vector<SATResult>& theResults)
+{
+  size_t anPairCount = theCaches.size() / 2;
+  GQE::Uint32 anHits = 0;
+  GQE::Uint32 anMismatches = 0;
+  sf::Vector2f anTranslation;
+
+  // Check each pair against the scalar results before timing anything
+  for(size_t anPair = 0; anPair < anPairCount; ++anPair)
+  {
+    anTranslation = sf::Vector2f(0.0f, 0.0f);
+    bool anHit = theFunction(theCaches[anPair*2], theCaches[anPair*2+1], anTranslation);
+    if(anHit != theResults[anPair].Hit ||
+        0 != memcmp(&anTranslation, &theResults[anPair].Translation, sizeof(sf::Vector2f)))
+    {
+      anMismatches++;
+    }
+  }
+
+  sf::Clock anClock;
+  for(GQE::Uint32 anIteration = 0; anIteration < theIterations; ++anIteration)
+  {
+    for(size_t anPair = 0; anPair < anPairCount; ++anPair)
+    {
+      if(theFunction(theCaches[anPair*2], theCaches[anPair*2+1], anTranslation))
+      {
+        anHits++;
+      }
+    }
+  }
+  float anSeconds = anClock.getElapsedTime().asSeconds();
+  double anTests = (double)anPairCount * theIterations;
+
+  // No rate or intersection count can be given without any iterations
+  GQE::Uint64 anRate = anSeconds > 0.0f ? (GQE::Uint64)(anTests / anSeconds) : 0;
+  GQE::Uint32 anIntersections = theIterations > 0 ? anHits / theIterations : 0;
+
+  std::cout << theName << ": " << anRate
+    << " pair tests/s (" << anIntersections << " of " << anPairCount
+    << " pairs intersect, " << anMismatches << " mismatches)" << std::endl;
+
+  // Return the number of pairs that disagree with the scalar version
+  return anMismatches;
+}
+
+/**
+ * The starting point of the SATBench application
+ * @param[in] argc the number of command line arguments provided
+ * @param[in] argv[] the array of command line arguments provided as an array
+ * @return the result returned by the SATBench application
+ */
+int main(int argc, char* argv[])
+{
+  // Optional arguments are the number of pairs and iterations to run
+  GQE::Uint32 anPairCount = (argc > 1) ? (GQE::Uint32)atoi(argv[1]) : 4096;
+  GQE::Uint32 anIterations = (argc > 2) ? (GQE::Uint32)atoi(argv[2]) : 200;
+
+  // Use a fixed seed so every run tests the same polygons
+  GQE::SetSeed(1);
+  std::vector<GQE::CollisionCache> anCaches(anPairCount * 2);
+  std::vector<SATResult> anResults(anPairCount);
+  for(GQE::Uint32 anPair = 0; anPair < anPairCount; ++anPair)
+  {
+    // Test every combination of regular and irregular polygons
+    MakePolygon(anCaches[anPair*2],
+        sf::Vector2f(GQE::Random(0.0f, 60.0f), GQE::Random(0.0f, 60.0f)), anPair % 2 == 1);
+    MakePolygon(anCaches[anPair*2+1],
+        sf::Vector2f(GQE::Random(0.0f, 60.0f), GQE::Random(0.0f, 60.0f)), (anPair / 2) % 2 == 1);
+    anResults[anPair].Translation = sf::Vector2f(0.0f, 0.0f);
+    anResults[anPair].Hit = GQE::SATIntersectionScalar(anCaches[anPair*2],
+        anCaches[anPair*2+1], anResults[anPair].Translation);
+  }
+
+  // Versions the library wasn't built with fall back to the next best one,
+  // so only run the rows that really use their instructions
+  const char* anInstructions = GQE::GetSATInstructionSet();
+  std::cout << "SATIntersection uses " << anInstructions
+    << " instructions" << std::endl;
+  GQE::Uint32 anMismatches = 0;
+  anMismatches += RunBenchmark("Scalar", GQE::SATIntersectionScalar, anCaches, anIterations, anResults);
+  if(strcmp(anInstructions, "Scalar") != 0)
+  {
+    anMismatches += RunBenchmark("SSE2", GQE::SATIntersectionSSE2, anCaches, anIterations, anResults);
+  }
+  else
+  {
+    std::cout << "SSE2: skipped, not built with SSE2" << std::endl;
+  }
+  if(strcmp(anInstructions, "AVX2") == 0)
+  {
+    anMismatches += RunBenchmark("AVX2", GQE::SATIntersectionAVX2, anCaches, anIterations, anResults);
+  }
+  else
+  {
+    std::cout << "AVX2: skipped, not built with AVX2 (see BUILD_AVX2)" << std::endl;
+  }
+
+  // Fail if any version disagrees with the scalar version
+  return anMismatches > 0 ? 1 : 0;
+}
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
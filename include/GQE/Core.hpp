@@ -15,6 +15,10 @@
  * @date 20130107 - Added new INetClient, INetPacket, INetServer, and IProcess classes
  * @date 20130111 - Added new INetPool class
  * @date 20130927 - Added IShape, TVector2 and Line classes.
+ * @date 20261018 - Added RenderCommandList and RenderThread classes
+ * @date 20261018 - Added IRenderTarget, NullRenderTarget and WindowRenderTarget classes
+ * @date 20261018 - Added TextureAtlas class
+ * @date 20261018 - Added IEventQueue, TBatchEvent and TEventQueue classes
  */
 #ifndef   GQE_CORE_HPP_INCLUDED
 #define   GQE_CORE_HPP_INCLUDED
@@ -38,13 +42,35 @@
 #include <GQE/Core/classes/AssetManager.hpp>
 #include <GQE/Core/classes/ConfigReader.hpp>
 #include <GQE/Core/classes/EventManager.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// NullRenderTarget requires SFML 2
+#else
+#include <GQE/Core/classes/NullRenderTarget.hpp>
+#endif
 #include <GQE/Core/classes/PropertyManager.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// RenderCommandList and RenderThread require SFML 2
+#else
+#include <GQE/Core/classes/RenderCommandList.hpp>
+#include <GQE/Core/classes/RenderThread.hpp>
+#endif
 #include <GQE/Core/classes/StatManager.hpp>
 #include <GQE/Core/classes/StateManager.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// TextureAtlas requires SFML 2
+#else
+#include <GQE/Core/classes/TextureAtlas.hpp>
+#endif
 #include <GQE/Core/classes/VersionInfo.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// WindowRenderTarget requires SFML 2
+#else
+#include <GQE/Core/classes/WindowRenderTarget.hpp>
+#endif
 #include <GQE/Core/interfaces/IApp.hpp>
 #include <GQE/Core/interfaces/IAssetHandler.hpp>
 #include <GQE/Core/interfaces/IEvent.hpp>
+#include <GQE/Core/interfaces/IEventQueue.hpp>
 #include <GQE/Core/interfaces/ILogger.hpp>
 #include <GQE/Core/interfaces/INetClient.hpp>
 #include <GQE/Core/interfaces/INetPacket.hpp>
@@ -52,10 +78,17 @@
 #include <GQE/Core/interfaces/INetServer.hpp>
 #include <GQE/Core/interfaces/IProcess.hpp>
 #include <GQE/Core/interfaces/IProperty.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// IRenderTarget requires SFML 2
+#else
+#include <GQE/Core/interfaces/IRenderTarget.hpp>
+#endif
 #include <GQE/Core/interfaces/IState.hpp>
 #include <GQE/Core/interfaces/TAsset.hpp>
 #include <GQE/Core/interfaces/TAssetHandler.hpp>
+#include <GQE/Core/interfaces/TBatchEvent.hpp>
 #include <GQE/Core/interfaces/TEvent.hpp>
+#include <GQE/Core/interfaces/TEventQueue.hpp>
 #include <GQE/Core/interfaces/TProperty.hpp>
 #include <GQE/Core/loggers/Log_macros.hpp>
 #include <GQE/Core/loggers/FatalLogger.hpp>
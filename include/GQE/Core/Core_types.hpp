@@ -18,6 +18,11 @@
  * @date 20120720 - Moved PropertyManager to Core library from Entity library
  * @date 20130107 - Added new INetClient, INetPacket, INetServer, and IProcess classes
  * @date 20130111 - Added new INetPool class
+ * @date 20261018 - Added RenderCommandList and RenderThread classes
+ * @date 20261018 - Added IRenderTarget, NullRenderTarget and WindowRenderTarget classes
+ * @date 20261018 - Added TextureAtlas class
+ * @date 20261018 - Added typeEventIndex typedef
+ * @date 20261018 - Added EventPhase enumeration and IEventQueue interface
  */
 #ifndef   GQE_CORE_TYPES_HPP_INCLUDED
 #define   GQE_CORE_TYPES_HPP_INCLUDED
@@ -77,6 +82,15 @@ namespace GQE
     HighRange = 2  ///< Recommend using HighRange graphics (128x128 pixels)
   };
 
+  /// Enumeration of the game loop phases queued events are delivered at
+  enum EventPhase
+  {
+    EventPhaseInput    = 0, ///< After input is processed, before UpdateFixed
+    EventPhaseFixed    = 1, ///< After each UpdateFixed of the active state
+    EventPhaseVariable = 2, ///< After UpdateVariable, before Draw
+    EventPhaseCount    = 3  ///< Number of phases, not a phase itself
+  };
+
   /// Enumeration of all Network Protocols supported
   enum NetProtocol
   {
@@ -116,6 +130,7 @@ namespace GQE
   class IApp;
   class IAssetHandler;
   class IEvent;
+  class IEventQueue;
   class ILogger;
   class INetClient;
   class INetPacket;
@@ -123,14 +138,20 @@ namespace GQE
   class INetServer;
   class IProcess;
   class IProperty;
+  class IRenderTarget;
   class IState;
 	class IShape;
   // Forward declare GQE core classes provided
   class AssetManager;
   class ConfigReader;
   class EventManager;
+  class NullRenderTarget;
   class PropertyManager;
+  class RenderCommandList;
+  class RenderThread;
+  class WindowRenderTarget;
   class StateManager;
+  class TextureAtlas;
 	class Line;
   // Forward declare GQE core assets provided
   class ConfigAsset;
@@ -171,6 +192,9 @@ namespace GQE
   /// Declare Event ID typedef which is used for identifying Event objects
   typedef std::string typeEventID;
 
+  /// Declare Event Index typedef which is the dense number an Event ID is interned as
+  typedef Uint32 typeEventIndex;
+
   /// Declare Net Alias typedef which is a text version for each client/server
   typedef std::string typeNetAlias;
 
@@ -5,14 +5,21 @@
  * @file include/GQE/Core/assets/ImageHandler.hpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Add TextureAtlas used to pack small images into shared pages
  */
 #pragma once//added to make MSVC 2010 stop complaining.
 #ifndef   CORE_IMAGE_HANDLER_HPP_INCLUDED
 #define   CORE_IMAGE_HANDLER_HPP_INCLUDED
  
+#include <map>
 #include <SFML/Graphics.hpp>
 #include <GQE/Core/Core_types.hpp>
 #include <GQE/Core/interfaces/TAssetHandler.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// TextureAtlas requires SFML 2
+#else
+#include <GQE/Core/classes/TextureAtlas.hpp>
+#endif
 
 namespace GQE
 {
@@ -34,8 +41,42 @@ namespace GQE
      * ImageHandler deconstructor
      */
     virtual ~ImageHandler();
+
+#if (SFML_VERSION_MAJOR < 2)
+    // TextureAtlas requires SFML 2
+#else
+    /**
+     * GetAtlas will return the TextureAtlas used to pack small images into
+     * shared page textures. Images must be added and the TextureAtlas built
+     * before the RenderSystem first draws an IEntity that uses them.
+     * @return the TextureAtlas for this ImageHandler
+     */
+    TextureAtlas& GetAtlas(void);
+
+    /**
+     * GetAtlasRegion will return the page texture and sub rectangle of the
+     * TextureAtlas that holds the same image as theTexture provided.
+     * @param[in] theTexture loaded by this ImageHandler
+     * @param[out] thePage texture holding the image
+     * @param[out] theRect of the image on thePage
+     * @return true if the image of theTexture was packed, false otherwise
+     */
+    bool GetAtlasRegion(const sf::Texture* theTexture, const sf::Texture*& thePage,
+        sf::IntRect& theRect) const;
+#endif
  
   protected:
+#if (SFML_VERSION_MAJOR < 2)
+    // TextureAtlas requires SFML 2
+#else
+    /**
+     * ReleaseAsset will forget theAsset provided before deleting it.
+     * @param[in] theAssetID of the asset to be released
+     * @param[in] theAsset to be released
+     */
+    virtual void ReleaseAsset(const typeAssetID theAssetID, sf::Texture* theAsset);
+#endif
+
     /**
      * LoadFromFile is responsible for loading theAsset from a file and must
      * be defined by the derived class since the interface for TYPE is
@@ -79,6 +120,14 @@ namespace GQE
 #endif
 
   private:
+#if (SFML_VERSION_MAJOR < 2)
+    // TextureAtlas requires SFML 2
+#else
+    /// The TextureAtlas of small images packed into shared pages
+    TextureAtlas mAtlas;
+    /// The asset ID of each texture loaded from a file
+    std::map<const sf::Texture*, typeAssetID> mTextureIDs;
+#endif
   }; // class ImageHandler
 } // namespace GQE
 
@@ -88,7 +137,12 @@ namespace GQE
  * @class GQE::ImageHandler
  * @ingroup Core
  * The ImageHandler class is used to reference count and manage all sf::Image
- * classes used in a GQE application.
+ * classes used in a GQE application. Under SFML 2 it also owns a TextureAtlas
+ * which packs small images into shared page textures, the RenderSystem uses
+ * GetAtlasRegion to draw an IEntity from the page holding its Texture instead
+ * of the Texture itself so that IEntity classes using different images can
+ * still be drawn together. Each packed image is still loaded into its own
+ * texture so sprites and ImageAsset classes keep working unchanged.
  *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
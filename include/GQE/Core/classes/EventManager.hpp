@@ -6,16 +6,23 @@
  * @file include/GQE/Core/classes/EventManager.hpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Intern each Event ID as a typeEventIndex and dispatch through a vector
+ * @date 20261018 - Add multiple handlers per event and queued events delivered in batches
+ * @date 20261018 - Check the context type of each queued batch
  */
 #ifndef EVENT_MANAGER_HPP_INCLUDED
 #define EVENT_MANAGER_HPP_INCLUDED
 
 #include <map>
+#include <vector>
 #include <typeinfo>
 #include <GQE/Core/Core_types.hpp>
 #include <GQE/Core/loggers/Log_macros.hpp>
 #include <GQE/Core/interfaces/IEvent.hpp>
+#include <GQE/Core/interfaces/IEventQueue.hpp>
+#include <GQE/Core/interfaces/TBatchEvent.hpp>
 #include <GQE/Core/interfaces/TEvent.hpp>
+#include <GQE/Core/interfaces/TEventQueue.hpp>
 
 namespace GQE
 {
@@ -23,6 +30,9 @@ namespace GQE
   class GQE_API EventManager
   {
     public:
+      /// The typeEventIndex of the empty Event ID, no IEvent is ever done for it
+      static const typeEventIndex NO_EVENT = 0;
+
       /**
        * EventManager default constructor
        */
@@ -33,6 +43,31 @@ namespace GQE
        */
       virtual ~EventManager();
 
+      /**
+       * GetIndex will return the typeEventIndex theEventID provided was
+       * interned as, interning it the first time it is seen so bindings and
+       * timers can be resolved before their IEvent is added.
+       * @param[in] theEventID to lookup or intern
+       * @return the index of theEventID or NO_EVENT if theEventID is empty
+       */
+      typeEventIndex GetIndex(const typeEventID& theEventID);
+
+      /**
+       * FindIndex will return the typeEventIndex theEventID provided was
+       * interned as without interning it.
+       * @param[in] theEventID to lookup
+       * @return the index of theEventID or NO_EVENT if it was never interned
+       */
+      typeEventIndex FindIndex(const typeEventID& theEventID) const;
+
+      /**
+       * GetName will return the Event ID theEventIndex provided was interned
+       * from, which is useful for logging and writing config files.
+       * @param[in] theEventIndex to lookup
+       * @return the Event ID or an empty string if theEventIndex is unknown
+       */
+      const typeEventID& GetName(const typeEventIndex theEventIndex) const;
+
       /**
        * HasID returns true if theEventID specified exists in this
        * EventManager.
@@ -43,28 +78,121 @@ namespace GQE
 
       /**
        * DoEvents should be called to execute the DoEvent method for each
-       * IEvent stored in this EventManager.
+       * IEvent stored in this EventManager in the order they were interned
+       * and then subscribed.
        * @param[in] theContext for the event, typically a different class
        */
       void DoEvents(void* theContext = NULL);
       /**
-      * DoEvent should be called to execute the DoEvent method for a single
-      * IEvent stored in this EventManager.
+      * DoEvent should be called to execute the DoEvent method of every IEvent
+      * subscribed to theEventID right away. This looks up theEventID each
+      * call, use GetIndex once and the typeEventIndex version when possible.
       * @param[in] theEventID for the event.
       * @param[in] theContext for the event, typically a different class
       */
-      void DoEvent(typeEventID theEventID, void* theContext = NULL);
+      void DoEvent(const typeEventID& theEventID, void* theContext = NULL);
+      /**
+      * DoEvent should be called to execute the DoEvent method of every IEvent
+      * subscribed to theEventIndex returned by GetIndex right away.
+      * @param[in] theEventIndex for the event.
+      * @param[in] theContext for the event, typically a different class
+      */
+      void DoEvent(const typeEventIndex theEventIndex, void* theContext = NULL);
+      /**
+       * Queue will add a copy of theContext to the queue of theEventIndex
+       * for thePhase provided. Every context queued for an event is delivered
+       * to each IEvent subscribed to it as one batch (see TBatchEvent) when
+       * the IApp game loop calls Flush for thePhase, so handlers never run
+       * in the middle of whatever loop queued the event.
+       * @param[in] theEventIndex returned by GetIndex to queue
+       * @param[in] theContext to copy, every context of an event must be the same type
+       * @param[in] thePhase of the game loop to deliver the event at
+       */
+      template<class TCONTEXT>
+      void Queue(const typeEventIndex theEventIndex, const TCONTEXT& theContext,
+        const EventPhase thePhase = EventPhaseFixed)
+      {
+        if(theEventIndex == NO_EVENT || theEventIndex >= mNames.size() ||
+            thePhase >= EventPhaseCount)
+        {
+          return;
+        }
+
+        // Create the queue the first time the event is queued for thePhase
+        std::vector<IEventQueue*>& anQueues = mQueues[thePhase];
+        if(anQueues.size() <= theEventIndex)
+        {
+          anQueues.resize(mNames.size(), NULL);
+        }
+        if(anQueues[theEventIndex] == NULL)
+        {
+          anQueues[theEventIndex] = new(std::nothrow) TEventQueue<TCONTEXT>();
+          if(anQueues[theEventIndex] == NULL)
+          {
+            ELOG() << "EventManager::Queue(" << mNames[theEventIndex]
+              << ") unable to allocate memory for the queue!" << std::endl;
+            return;
+          }
+        }
+
+        TEventQueue<TCONTEXT>* anQueue =
+          dynamic_cast<TEventQueue<TCONTEXT>*>(anQueues[theEventIndex]);
+        if(anQueue == NULL)
+        {
+          ELOG() << "EventManager::Queue(" << mNames[theEventIndex]
+            << ") context type doesn't match the queued contexts!" << std::endl;
+        }
+        else if(anQueue->Push(theContext))
+        {
+          // Remember the queue has something to deliver
+          mPending[thePhase].push_back(theEventIndex);
+        }
+      }
+
       /**
-       * Get returns the IEvent that matches theEventID specified that was
-       * previously added to the EventManager using the Add methods.
+       * Queue will add a copy of theContext to the queue of theEventID for
+       * thePhase provided. This looks up theEventID each call, use GetIndex
+       * once and the typeEventIndex version when possible.
+       * @param[in] theEventID to queue
+       * @param[in] theContext to copy, every context of an event must be the same type
+       * @param[in] thePhase of the game loop to deliver the event at
+       */
+      template<class TCONTEXT>
+      void Queue(const typeEventID& theEventID, const TCONTEXT& theContext,
+        const EventPhase thePhase = EventPhaseFixed)
+      {
+        Queue<TCONTEXT>(GetIndex(theEventID), theContext, thePhase);
+      }
+
+      /**
+       * Flush will deliver every event queued for thePhase provided in the
+       * order each event was first queued. Each IEvent subscribed to an
+       * event receives all of its queued contexts in a single DoBatch call.
+       * Events queued while flushing wait for the next Flush of thePhase.
+       * @param[in] thePhase of the game loop to deliver the events of
+       */
+      void Flush(const EventPhase thePhase);
+
+      /**
+       * Get returns the first IEvent that matches theEventID specified that
+       * was previously added to the EventManager using the Add methods.
        * @param[in] theEventID to lookup in this EventManager
        * @return a pointer to the IEvent class or NULL otherwise
        */
       IEvent* Get(const typeEventID theEventID);
 
+      /**
+       * Get returns the first IEvent that matches theEventIndex specified
+       * that was previously added to the EventManager using the Add methods.
+       * @param[in] theEventIndex to lookup in this EventManager
+       * @return a pointer to the IEvent class or NULL otherwise
+       */
+      IEvent* Get(const typeEventIndex theEventIndex);
+
       /**
        * Add adds a new TEvent to be managed by the EventManager using the
-       * class and member function specified without a context class specified.
+       * class and member function specified without a context class specified
+       * unless theEventID already has an IEvent (see Subscribe).
        * @param[in] theEventID to use when creating the TEvent class
        * @param[in] theEventClass to use when calling theEventFunc
        * @param[in] theEventFunc to call in theEventClass
@@ -74,20 +202,22 @@ namespace GQE
         typename TEvent<TCLASS, void>::typeEventFunc theEventFunc)
       {
         // Only add the event if it doesn't already exist
-        if(mList.find(theEventID) == mList.end())
+        typeEventIndex anIndex = GetIndex(theEventID);
+        if(anIndex != NO_EVENT && mEvents[anIndex].empty())
         {
           TEvent<TCLASS,void>* anEvent =
             new(std::nothrow) TEvent<TCLASS,void>(theEventID, theEventClass, theEventFunc);
           if(anEvent != NULL)
           {
-            mList.insert(std::pair<const typeEventID, IEvent*>(theEventID, anEvent));
+            mEvents[anIndex].push_back(anEvent);
           }
         }
       }
 
       /**
        * Add adds a new TEvent to be managed by the EventManager using the
-       * class and member function and context class type specified.
+       * class and member function and context class type specified unless
+       * theEventID already has an IEvent (see Subscribe).
        * @param[in] theEventID to use when creating the TEvent class
        * @param[in] theEventClass to use when calling theEventFunc
        * @param[in] theEventFunc to call in theEventClass
@@ -97,13 +227,14 @@ namespace GQE
         typename TEvent<TCLASS, TCONTEXT>::typeEventFunc theEventFunc)
       {
         // Only add the event if it doesn't already exist
-        if(mList.find(theEventID) == mList.end())
+        typeEventIndex anIndex = GetIndex(theEventID);
+        if(anIndex != NO_EVENT && mEvents[anIndex].empty())
         {
           TEvent<TCLASS,TCONTEXT>* anEvent =
             new(std::nothrow) TEvent<TCLASS,TCONTEXT>(theEventID, theEventClass, theEventFunc);
           if(anEvent != NULL)
           {
-            mList.insert(std::pair<const typeEventID, IEvent*>(theEventID, anEvent));
+            mEvents[anIndex].push_back(anEvent);
           }
         }
       }
@@ -114,15 +245,60 @@ namespace GQE
        * @param[in] theEvent is a pointer to a class that derives from IEvent
        */
       void Add(IEvent* theEvent);
-      // Variables
-      ///////////////////////////////////////////////////////////////////////////
-      /// A map of all events available for this EventManager class
-      std::map<const typeEventID, IEvent*> mList;
-    protected:
 
-    private:
+      /**
+       * Subscribe adds a new TEvent to the IEvent classes of theEventID using
+       * the class and member function and context class type specified, even
+       * if theEventID already has other IEvent classes.
+       * @param[in] theEventID to use when creating the TEvent class
+       * @param[in] theEventClass to use when calling theEventFunc
+       * @param[in] theEventFunc to call in theEventClass
+       */
+      template<class TCLASS, class TCONTEXT>
+      void Subscribe(const typeEventID theEventID, TCLASS& theEventClass,
+        typename TEvent<TCLASS, TCONTEXT>::typeEventFunc theEventFunc)
+      {
+        Subscribe(new(std::nothrow) TEvent<TCLASS,TCONTEXT>(theEventID, theEventClass, theEventFunc));
+      }
 
+      /**
+       * SubscribeBatch adds a new TBatchEvent to the IEvent classes of
+       * theEventID using the class and member function and context class type
+       * specified, theBatchFunc receives every queued context at once.
+       * @param[in] theEventID to use when creating the TBatchEvent class
+       * @param[in] theEventClass to use when calling theBatchFunc
+       * @param[in] theBatchFunc to call in theEventClass
+       */
+      template<class TCLASS, class TCONTEXT>
+      void SubscribeBatch(const typeEventID theEventID, TCLASS& theEventClass,
+        typename TBatchEvent<TCLASS, TCONTEXT>::typeBatchFunc theBatchFunc)
+      {
+        Subscribe(new(std::nothrow) TBatchEvent<TCLASS,TCONTEXT>(theEventID, theEventClass, theBatchFunc));
+      }
 
+      /**
+       * Subscribe will manage theEvent provided in this EventManager along
+       * with any other IEvent classes already using the same Event ID.
+       * @param[in] theEvent is a pointer to a class that derives from IEvent
+       */
+      void Subscribe(IEvent* theEvent);
+    protected:
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The typeEventIndex each Event ID was interned as
+      std::map<const typeEventID, typeEventIndex> mIndexes;
+      /// The Event ID of each typeEventIndex
+      std::vector<typeEventID> mNames;
+      /// The IEvent classes subscribed to each typeEventIndex
+      std::vector<std::vector<IEvent*> > mEvents;
+      /// The queue of each typeEventIndex for each EventPhase or NULL if never queued
+      std::vector<IEventQueue*> mQueues[EventPhaseCount];
+      /// The typeEventIndex of each queue with contexts to deliver for each EventPhase
+      std::vector<typeEventIndex> mPending[EventPhaseCount];
+      /// The typeEventIndex of each queue being delivered by Flush for each EventPhase
+      std::vector<typeEventIndex> mFlushing[EventPhaseCount];
   }; // EventManager class
 } // namespace GQE
 #endif
@@ -132,7 +308,16 @@ namespace GQE
  * @ingroup Core
  * The EventManager class is responsible for providing management for all
  * IEvent based classes used to provide Event calls to member functions of any
- * class provided.
+ * class provided. Each Event ID is interned as a dense typeEventIndex the
+ * first time it is seen (by GetIndex or Add) so DoEvent can find the IEvent
+ * with a vector lookup instead of comparing strings. Event IDs read from
+ * config files still work by name through the typeEventID methods.
+ *
+ * Add keeps a single IEvent per Event ID while Subscribe lets any number of
+ * IEvent classes handle the same Event ID in the order they subscribed.
+ * DoEvent calls each of them right away. Queue instead copies the context
+ * into a queue that Flush delivers at a fixed phase of the IApp game loop
+ * (see EventPhase), giving every IEvent the whole batch in one DoBatch call.
  *
  * Copyright (c) 2010-2012 Ryan Lindeman
  * Permission is hereby granted, free of charge, to any person obtaining a copy
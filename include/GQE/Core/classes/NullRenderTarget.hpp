@@ -0,0 +1,141 @@
+/**
+ * Provides the NullRenderTarget class in the GQE namespace which counts each
+ * draw call instead of drawing anything.
+ *
+ * @file include/GQE/Core/classes/NullRenderTarget.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_NULL_RENDER_TARGET_HPP_INCLUDED
+#define   CORE_NULL_RENDER_TARGET_HPP_INCLUDED
+
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/Core_types.hpp>
+#include <GQE/Core/interfaces/IRenderTarget.hpp>
+
+namespace GQE
+{
+  /// Provides the NullRenderTarget class for counting draw calls
+  class GQE_API NullRenderTarget : public IRenderTarget
+  {
+    public:
+      /**
+       * NullRenderTarget default constructor
+       */
+      NullRenderTarget();
+
+      /**
+       * NullRenderTarget deconstructor
+       */
+      virtual ~NullRenderTarget();
+
+      /**
+       * Reset will set every count back to zero, typically at the start of
+       * each frame.
+       */
+      void Reset(void);
+
+      /**
+       * GetDrawCalls will return the number of draw calls since Reset.
+       * @return the number of draw calls
+       */
+      Uint32 GetDrawCalls(void) const;
+
+      /**
+       * GetVertexCount will return the number of vertices drawn since Reset.
+       * Sprites count as 4 vertices and texts as 4 vertices per character.
+       * @return the number of vertices drawn
+       */
+      Uint32 GetVertexCount(void) const;
+
+      /**
+       * GetStateChanges will return the number of view changes plus the
+       * number of draw calls that used a different texture than the draw
+       * call before them since Reset. Each text is counted as a state change.
+       * @return the number of state changes
+       */
+      Uint32 GetStateChanges(void) const;
+
+      /**
+       * SetView will count a state change.
+       * @param[in] theView to use
+       */
+      virtual void SetView(const sf::View& theView);
+
+      /**
+       * Draw will count a draw call of theCount vertices provided.
+       * @param[in] theVertices to draw
+       * @param[in] theCount of vertices to draw
+       * @param[in] thePrimitive type to draw theVertices with
+       * @param[in] theTexture to draw with or NULL for none
+       */
+      virtual void Draw(const sf::Vertex* theVertices, Uint32 theCount,
+          sf::PrimitiveType thePrimitive, const sf::Texture* theTexture = NULL);
+
+      /**
+       * Draw will count a draw call of theSprite provided.
+       * @param[in] theSprite to draw
+       */
+      virtual void Draw(const sf::Sprite& theSprite);
+
+      /**
+       * Draw will count a draw call of theText provided.
+       * @param[in] theText to draw
+       */
+      virtual void Draw(const sf::Text& theText);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The texture (or text) used by the last draw call
+      const void* mState;
+      /// The number of draw calls since Reset
+      Uint32      mDrawCalls;
+      /// The number of vertices drawn since Reset
+      Uint32      mVertices;
+      /// The number of state changes since Reset
+      Uint32      mStateChanges;
+      /// True until the first draw call since Reset
+      bool        mFirst;
+
+      /**
+       * CountDraw will count a draw call of theCount vertices using theState
+       * provided.
+       * @param[in] theCount of vertices drawn
+       * @param[in] theState (texture or text) used by the draw call
+       */
+      void CountDraw(Uint32 theCount, const void* theState);
+  }; // class NullRenderTarget
+} // namespace GQE
+
+#endif // CORE_NULL_RENDER_TARGET_HPP_INCLUDED
+
+/**
+ * @class GQE::NullRenderTarget
+ * @ingroup Core
+ * The NullRenderTarget class is an IRenderTarget that never needs a window or
+ * an OpenGL context. It only counts the draw calls, vertices and state changes
+ * it is given, which makes it useful for measuring the CPU cost of building
+ * each frame on servers and on machines without a graphics driver. Give it to
+ * IApp::SetRenderTarget to have every frame drawn to it instead of the render
+ * window.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
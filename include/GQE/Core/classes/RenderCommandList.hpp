@@ -0,0 +1,158 @@
+/**
+ * Provides the RenderCommandList class in the GQE namespace which records the
+ * draw calls of a frame so they can be replayed later, typically by the
+ * RenderThread class.
+ *
+ * @file include/GQE/Core/classes/RenderCommandList.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Derive from the new IRenderTarget interface
+ */
+#ifndef   CORE_RENDER_COMMAND_LIST_HPP_INCLUDED
+#define   CORE_RENDER_COMMAND_LIST_HPP_INCLUDED
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/Core_types.hpp>
+#include <GQE/Core/interfaces/IRenderTarget.hpp>
+
+namespace GQE
+{
+  /// Provides the RenderCommandList class for recording draw calls
+  class GQE_API RenderCommandList : public IRenderTarget
+  {
+    public:
+      /**
+       * RenderCommandList default constructor
+       */
+      RenderCommandList();
+
+      /**
+       * RenderCommandList deconstructor
+       */
+      virtual ~RenderCommandList();
+
+      /**
+       * Clear will forget every recorded command but keep the memory used so
+       * recording the next frame doesn't need to allocate.
+       */
+      void Clear(void);
+
+      /**
+       * GetCommandCount will return the number of commands recorded since the
+       * last call to Clear.
+       * @return the number of recorded commands
+       */
+      Uint32 GetCommandCount(void) const;
+
+      /**
+       * SetView will record a view change, every draw recorded after it will
+       * use theView provided.
+       * @param[in] theView to copy and use
+       */
+      virtual void SetView(const sf::View& theView);
+
+      /**
+       * Draw will record a copy of theVertices provided.
+       * @param[in] theVertices to copy
+       * @param[in] theCount of vertices to copy
+       * @param[in] thePrimitive type to draw theVertices with
+       * @param[in] theTexture to draw with which must outlive the replay
+       */
+      virtual void Draw(const sf::Vertex* theVertices, Uint32 theCount,
+          sf::PrimitiveType thePrimitive, const sf::Texture* theTexture = NULL);
+
+      /**
+       * Draw will record a copy of theSprite provided.
+       * @param[in] theSprite to copy, its texture must outlive the replay
+       */
+      virtual void Draw(const sf::Sprite& theSprite);
+
+      /**
+       * Draw will record a copy of theText provided.
+       * @param[in] theText to copy, its font must outlive the replay
+       */
+      virtual void Draw(const sf::Text& theText);
+
+      /**
+       * Replay will issue every recorded command to theTarget in the order
+       * they were recorded.
+       * @param[in] theTarget to draw to
+       */
+      void Replay(sf::RenderTarget& theTarget) const;
+
+    private:
+      /// The types of commands that can be recorded
+      enum CommandType
+      {
+        CommandView,     ///< Change the view using mViews
+        CommandVertices, ///< Draw a range of mVertices
+        CommandSprite,   ///< Draw one of mSprites
+        CommandText      ///< Draw one of mTexts
+      };
+
+      /// A single recorded command
+      struct Command
+      {
+        CommandType        Type;      ///< Which of the lists below to use
+        Uint32             Index;     ///< Index of the first item to use
+        Uint32             Count;     ///< Number of vertices to draw
+        sf::PrimitiveType  Primitive; ///< Primitive type of the vertices
+        const sf::Texture* Texture;   ///< Texture to draw the vertices with
+      };
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The commands in the order they were recorded
+      std::vector<Command>    mCommands;
+      /// The vertices copied by each vertices command
+      std::vector<sf::Vertex> mVertices;
+      /// The views copied by each view command
+      std::vector<sf::View>   mViews;
+      /// The sprites copied by each sprite command
+      std::vector<sf::Sprite> mSprites;
+      /// The texts copied by each text command
+      std::vector<sf::Text>   mTexts;
+      /// The number of mViews used since the last Clear
+      Uint32                  mViewCount;
+      /// The number of mSprites used since the last Clear
+      Uint32                  mSpriteCount;
+      /// The number of mTexts used since the last Clear
+      Uint32                  mTextCount;
+  }; // class RenderCommandList
+} // namespace GQE
+
+#endif // CORE_RENDER_COMMAND_LIST_HPP_INCLUDED
+
+/**
+ * @class GQE::RenderCommandList
+ * @ingroup Core
+ * The RenderCommandList class is an IRenderTarget that records the draw calls
+ * of a frame instead of issuing them to a window right away. Everything needed to replay a command
+ * (vertices, views, sprites and texts) is copied when it is recorded, so the
+ * caller is free to change or reuse its own copies as soon as the method
+ * returns. Textures and fonts are only referenced and must outlive the replay.
+ * Clear keeps the memory of every list so a frame that looks like the
+ * previous one can be recorded without any allocations. The RenderThread
+ * class uses a pair of RenderCommandList classes to let the game loop record
+ * the next frame while the previous one is being replayed.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
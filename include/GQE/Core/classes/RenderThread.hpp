@@ -0,0 +1,136 @@
+/**
+ * Provides the RenderThread class in the GQE namespace which owns the render
+ * window context and replays each frame recorded by the game loop in its own
+ * thread.
+ *
+ * @file include/GQE/Core/classes/RenderThread.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_RENDER_THREAD_HPP_INCLUDED
+#define   CORE_RENDER_THREAD_HPP_INCLUDED
+
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/Core_types.hpp>
+#include <GQE/Core/classes/RenderCommandList.hpp>
+#include <GQE/Core/interfaces/IProcess.hpp>
+
+namespace GQE
+{
+  /// Provides the RenderThread class for replaying frames in their own thread
+  class GQE_API RenderThread : public IProcess
+  {
+    public:
+      /**
+       * RenderThread default constructor
+       */
+      RenderThread();
+
+      /**
+       * RenderThread deconstructor
+       */
+      virtual ~RenderThread();
+
+      /**
+       * SetWindow will set theWindow to replay each frame to, this must be
+       * done before the Start method is called. The caller gives up the
+       * window context until the Stop method returns.
+       * @param[in] theWindow to replay each frame to
+       */
+      void SetWindow(sf::RenderWindow& theWindow);
+
+      /**
+       * GetCommandList will return the RenderCommandList the game loop should
+       * record the current frame into.
+       * @return the RenderCommandList being recorded
+       */
+      RenderCommandList& GetCommandList(void);
+
+      /**
+       * Submit will hand the frame recorded so far to the render thread and
+       * provide an empty RenderCommandList for the next frame. The caller
+       * is only blocked if the previous frame is still being replayed.
+       */
+      void Submit(void);
+
+    protected:
+      /**
+       * IsReady will return true if SetWindow has been called.
+       * @return true if the render thread is ready to start
+       */
+      virtual bool IsReady(void);
+
+      /**
+       * Process will take the window context and replay and display each
+       * frame provided by Submit until the Stop method is called.
+       */
+      virtual void Process(void);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The window each frame is replayed to
+      sf::RenderWindow* mWindow;
+      /// Protects mRecord and mPending below
+      sf::Mutex         mMutex;
+      /// The pair of lists being recorded and replayed
+      RenderCommandList mLists[2];
+      /// Index into mLists of the list being recorded by the game loop
+      Uint32            mRecord;
+      /// True if the list not being recorded is waiting to be replayed
+      bool              mPending;
+
+      /**
+       * ReplayFrame will replay and display the pending frame if there is one.
+       * @return true if a frame was replayed
+       */
+      bool ReplayFrame(void);
+
+      /**
+       * RenderThread copy constructor is private because we do not allow
+       * copies of our RenderThread class
+       */
+      RenderThread(const RenderThread&);  // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our RenderThread class
+       */
+      RenderThread& operator=(const RenderThread&); // Intentionally undefined
+  }; // class RenderThread
+} // namespace GQE
+
+#endif // CORE_RENDER_THREAD_HPP_INCLUDED
+
+/**
+ * @class GQE::RenderThread
+ * @ingroup Core
+ * The RenderThread class moves the replay of each frame and the call to
+ * display (which waits for vertical sync) off the game loop thread. The game
+ * loop records frame N+1 into one RenderCommandList while the render thread
+ * replays frame N from the other; Submit swaps the two lists once frame N has
+ * been displayed. The render thread owns the window context while it is
+ * running, so nothing else may draw to the window directly until Stop
+ * returns. Events are still polled by the game loop thread. The IApp class
+ * uses a RenderThread when the renderthread value of the [window] section of
+ * its settings is set.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -16,10 +16,13 @@
  * @date 20120421 - Use arial.ttf font since SFML 2 crashes on exit when using default font
  * @date 20120518 - Use sf::Font instead of FontAsset to remove circular dependency
  * @date 20121107 - Padding StatManager class
+ * @date 20261018 - Added SetStat and GetStat for custom statistics
  */
 #ifndef   CORE_STAT_MANAGER_HPP_INCLUDED
 #define   CORE_STAT_MANAGER_HPP_INCLUDED
 
+#include <map>
+#include <string>
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include <GQE/Core/Core_types.hpp>
@@ -80,6 +83,23 @@ namespace GQE
        */
       Uint32 GetFrames(void) const;
 
+      /**
+       * SetStat will set the current value of the custom statistic named
+       * theName provided. Custom statistics are displayed below the Frames
+       * and Updates per second and are refreshed once per second.
+       * @param[in] theName of the statistic to set
+       * @param[in] theValue to set for the statistic
+       */
+      void SetStat(const std::string& theName, Uint32 theValue);
+
+      /**
+       * GetStat will return the current value of the custom statistic named
+       * theName provided.
+       * @param[in] theName of the statistic to return
+       * @return the value of the statistic or 0 if it was never set
+       */
+      Uint32 GetStat(const std::string& theName) const;
+
       /**
        * RegisterApp will register a pointer to the App class so it can be used
        * by the StatManager for error handling and log reporting.
@@ -133,6 +153,14 @@ namespace GQE
 #else
       sf::Text*   mUPS;
 #endif
+      /// Custom statistics provided to SetStat
+      std::map<std::string, Uint32> mStats;
+#if (SFML_VERSION_MAJOR < 2)
+      /// Debug string to display that shows the custom statistics
+      sf::String* mStatsText;
+#else
+      sf::Text*   mStatsText;
+#endif
 
       /**
        * StatManager copy constructor is private because we do not allow copies
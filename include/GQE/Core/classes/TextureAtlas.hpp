@@ -0,0 +1,234 @@
+/**
+ * Provides the TextureAtlas class in the GQE namespace which packs many small
+ * images into a few shared page textures.
+ *
+ * @file include/GQE/Core/classes/TextureAtlas.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add GetGeneration and check the size and time of each cached image
+ */
+#ifndef   CORE_TEXTURE_ATLAS_HPP_INCLUDED
+#define   CORE_TEXTURE_ATLAS_HPP_INCLUDED
+
+#include <map>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/Core_types.hpp>
+
+namespace GQE
+{
+  /// Provides the TextureAtlas class for packing images into page textures
+  class GQE_API TextureAtlas
+  {
+    public:
+      /**
+       * TextureAtlas default constructor
+       * @param[in] theMaxImageSize is the largest width or height packed
+       * @param[in] thePageSize is the width and height of each page texture
+       */
+      TextureAtlas(Uint32 theMaxImageSize = 256, Uint32 thePageSize = 2048);
+
+      /**
+       * TextureAtlas deconstructor
+       */
+      virtual ~TextureAtlas();
+
+      /**
+       * SetSizes will change the largest image packed and the size of each
+       * page, it only takes effect the next time Build is called.
+       * @param[in] theMaxImageSize is the largest width or height packed
+       * @param[in] thePageSize is the width and height of each page texture
+       */
+      void SetSizes(Uint32 theMaxImageSize, Uint32 thePageSize);
+
+      /**
+       * AddImage will add theAssetID to the list of images packed the next
+       * time Build is called.
+       * @param[in] theAssetID of the image to pack
+       * @param[in] theFilename to load the image from, theAssetID if empty
+       */
+      void AddImage(const typeAssetID theAssetID, const std::string theFilename = "");
+
+      /**
+       * Build will pack every image added so far into page textures. If
+       * theCacheFilename is provided and describes the same images, image
+       * files and sizes the pages are loaded from it instead, otherwise the
+       * pages are packed and saved there for the next time. The page textures
+       * of any previous Build are deleted, see GetGeneration.
+       * @param[in] theCacheFilename to load or save the packing results
+       * @return true if every page texture was created
+       */
+      bool Build(const std::string theCacheFilename = "");
+
+      /**
+       * Clear will drop every page texture, region and image added.
+       */
+      void Clear(void);
+
+      /**
+       * GetRegion will return the page texture and sub rectangle theAssetID
+       * was packed into.
+       * @param[in] theAssetID of the image to find
+       * @param[out] thePage texture holding the image
+       * @param[out] theRect of the image on thePage
+       * @return true if theAssetID was packed, false otherwise
+       */
+      bool GetRegion(const typeAssetID theAssetID, const sf::Texture*& thePage,
+          sf::IntRect& theRect) const;
+
+      /**
+       * GetPageCount will return the number of page textures built.
+       * @return the number of page textures
+       */
+      Uint32 GetPageCount(void) const;
+
+      /**
+       * GetGeneration will return a number that changes every time the page
+       * textures are deleted by Build or Clear. Anything holding a page
+       * texture or region must look it up again once this changes.
+       * @return the generation of the current page textures
+       */
+      Uint32 GetGeneration(void) const;
+
+    private:
+      /// Region of an image on one of the pages
+      struct Region
+      {
+        /// Index of the page holding the image
+        Uint32 Page;
+        /// Rectangle of the image on its page
+        sf::IntRect Rect;
+      };
+      /// Segment of the skyline of a page
+      struct Segment
+      {
+        Uint32 X;
+        Uint32 Y;
+        Uint32 Width;
+      };
+
+      /**
+       * Pack will load every image added and place it on thePages using a
+       * skyline packer, tallest images first.
+       * @param[out] thePages images to copy each packed image to
+       * @return true if every image was loaded
+       */
+      bool Pack(std::vector<sf::Image>& thePages);
+
+      /**
+       * Place will find the lowest spot on theSkyline of a page that fits
+       * theWidth by theHeight and raise the skyline over it.
+       * @param[in,out] theSkyline of the page
+       * @param[in] theWidth of the rectangle to place
+       * @param[in] theHeight of the rectangle to place
+       * @param[out] theX where the rectangle was placed
+       * @param[out] theY where the rectangle was placed
+       * @return true if the rectangle fits on the page
+       */
+      bool Place(std::vector<Segment>& theSkyline, Uint32 theWidth,
+          Uint32 theHeight, Uint32& theX, Uint32& theY) const;
+
+      /**
+       * ReadCache will load the regions and page images from
+       * theCacheFilename if it describes the images and sizes in use and the
+       * size and modification time of each image file still match.
+       * @param[in] theCacheFilename to load from
+       * @param[out] thePages images loaded
+       * @return true if the cache was loaded
+       */
+      bool ReadCache(const std::string theCacheFilename, std::vector<sf::Image>& thePages);
+
+      /**
+       * WriteCache will save the regions and thePages to theCacheFilename.
+       * @param[in] theCacheFilename to save to
+       * @param[in] thePages images to save
+       */
+      void WriteCache(const std::string theCacheFilename,
+          const std::vector<sf::Image>& thePages) const;
+
+      /**
+       * DropPages will delete every page texture and forget every region.
+       */
+      void DropPages(void);
+
+      /**
+       * GetPageFilename will return the filename page theIndex is cached to.
+       * @param[in] theCacheFilename the pages belong to
+       * @param[in] theIndex of the page
+       * @return the filename of the page image
+       */
+      static std::string GetPageFilename(const std::string theCacheFilename,
+          Uint32 theIndex);
+
+      /**
+       * TextureAtlas copy constructor is private because we do not allow copies
+       * of our class
+       */
+      TextureAtlas(const TextureAtlas&);  // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our class
+       */
+      TextureAtlas& operator=(const TextureAtlas&); // Intentionally undefined
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// Largest width or height of an image that will be packed
+      Uint32 mMaxImageSize;
+      /// Width and height of each page
+      Uint32 mPageSize;
+      /// Filename of each image added, by asset ID
+      std::map<const typeAssetID, std::string> mFilenames;
+      /// Region of each image packed, by asset ID
+      std::map<const typeAssetID, Region> mRegions;
+      /// Width and height of each image loaded by the last Pack, by asset ID
+      std::map<const typeAssetID, sf::Vector2u> mImageSizes;
+      /// The page textures built
+      std::vector<sf::Texture*> mPages;
+      /// Incremented each time the page textures are deleted
+      Uint32 mGeneration;
+  }; // class TextureAtlas
+} // namespace GQE
+
+#endif // CORE_TEXTURE_ATLAS_HPP_INCLUDED
+
+/**
+ * @class GQE::TextureAtlas
+ * @ingroup Core
+ * The TextureAtlas class packs images that are no larger than a configurable
+ * size into a few shared page textures so the RenderSystem can draw sprites
+ * that use different images with the same texture, and therefore with the
+ * same draw call. Images are packed tallest first with a skyline packer and
+ * a one pixel gap between them. Images that don't fit on the page being
+ * filled start a new page and images that are too large are left out and
+ * keep using their own texture. Packing only happens in Build, and if a cache
+ * filename is provided the layout and page images are saved so the next
+ * Build with the same images and sizes can load them instead. The width,
+ * height, file size and modification time of each image are saved with the
+ * layout so an image changed on disk causes the pages to be packed again.
+ * Each Build deletes the page textures of the last one and changes
+ * GetGeneration, which the RenderSystem checks before each Draw to rebuild
+ * anything drawn from the old pages. The ImageHandler class owns the
+ * TextureAtlas used by the RenderSystem, see ImageHandler::GetAtlas.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
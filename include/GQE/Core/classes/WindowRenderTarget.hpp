@@ -0,0 +1,108 @@
+/**
+ * Provides the WindowRenderTarget class in the GQE namespace which issues
+ * each draw call to an SFML render target right away.
+ *
+ * @file include/GQE/Core/classes/WindowRenderTarget.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_WINDOW_RENDER_TARGET_HPP_INCLUDED
+#define   CORE_WINDOW_RENDER_TARGET_HPP_INCLUDED
+
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/Core_types.hpp>
+#include <GQE/Core/interfaces/IRenderTarget.hpp>
+
+namespace GQE
+{
+  /// Provides the WindowRenderTarget class for drawing to an sf::RenderTarget
+  class GQE_API WindowRenderTarget : public IRenderTarget
+  {
+    public:
+      /**
+       * WindowRenderTarget constructor
+       * @param[in] theTarget to issue each draw call to
+       */
+      WindowRenderTarget(sf::RenderTarget& theTarget);
+
+      /**
+       * WindowRenderTarget deconstructor
+       */
+      virtual ~WindowRenderTarget();
+
+      /**
+       * SetView will change the view of the render target.
+       * @param[in] theView to use
+       */
+      virtual void SetView(const sf::View& theView);
+
+      /**
+       * Draw will draw theVertices provided to the render target.
+       * @param[in] theVertices to draw
+       * @param[in] theCount of vertices to draw
+       * @param[in] thePrimitive type to draw theVertices with
+       * @param[in] theTexture to draw with or NULL for none
+       */
+      virtual void Draw(const sf::Vertex* theVertices, Uint32 theCount,
+          sf::PrimitiveType thePrimitive, const sf::Texture* theTexture = NULL);
+
+      /**
+       * Draw will draw theSprite provided to the render target.
+       * @param[in] theSprite to draw
+       */
+      virtual void Draw(const sf::Sprite& theSprite);
+
+      /**
+       * Draw will draw theText provided to the render target.
+       * @param[in] theText to draw
+       */
+      virtual void Draw(const sf::Text& theText);
+
+    private:
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The render target each draw call is issued to
+      sf::RenderTarget& mTarget;
+
+      /**
+       * WindowRenderTarget copy constructor is private because we do not
+       * allow copies of our WindowRenderTarget class
+       */
+      WindowRenderTarget(const WindowRenderTarget&);  // Intentionally undefined
+
+      /**
+       * Our assignment operator is private because we do not allow copies
+       * of our WindowRenderTarget class
+       */
+      WindowRenderTarget& operator=(const WindowRenderTarget&); // Intentionally undefined
+  }; // class WindowRenderTarget
+} // namespace GQE
+
+#endif // CORE_WINDOW_RENDER_TARGET_HPP_INCLUDED
+
+/**
+ * @class GQE::WindowRenderTarget
+ * @ingroup Core
+ * The WindowRenderTarget class is the IRenderTarget used by the IApp class
+ * for its render window when neither the render thread nor a target given to
+ * IApp::SetRenderTarget is being used.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -22,6 +22,8 @@
  * @date 20121107 - Fix warning: type qualifiers ignored on function return type
  * @date 20121107 - Padding IApp class
  * @date 20141107 - Added a global EventManager member.
+ * @date 20261018 - Added GetRenderCommands and an optional RenderThread
+ * @date 20261018 - Replaced GetRenderCommands with Get/SetRenderTarget
  */
 #ifndef   CORE_APP_HPP_INCLUDED
 #define   CORE_APP_HPP_INCLUDED
@@ -37,6 +39,12 @@
 #include <GQE/Core/classes/StatManager.hpp>
 #include <GQE/Core/classes/StateManager.hpp>
 #include <GQE/Core/classes/EventManager.hpp>
+#if (SFML_VERSION_MAJOR < 2)
+// RenderThread requires SFML 2
+#else
+#include <GQE/Core/classes/RenderThread.hpp>
+#include <GQE/Core/classes/WindowRenderTarget.hpp>
+#endif
 #include <GQE/Core/Core_types.hpp>
 
 namespace GQE
@@ -161,6 +169,29 @@ namespace GQE
        */
       void Quit(int theExitCode = StatusAppOK);
 
+#if (SFML_VERSION_MAJOR < 2)
+      // RenderThread requires SFML 2
+#else
+      /**
+       * GetRenderTarget will return the IRenderTarget the current frame should
+       * be drawn to. This is the RenderCommandList of the render thread while
+       * it is running (see the renderthread value in the [window] section of
+       * settings.cfg), otherwise the IRenderTarget given to SetRenderTarget or
+       * mWindow if none was given. Nothing may be drawn to mWindow directly
+       * while the render thread is running.
+       * @return the IRenderTarget to draw the current frame to
+       */
+      IRenderTarget& GetRenderTarget(void);
+
+      /**
+       * SetRenderTarget will draw every frame to theTarget provided instead
+       * of mWindow, for example a NullRenderTarget in console only
+       * applications. The render thread is not used with theTarget.
+       * @param[in] theTarget to draw to or NULL to draw to mWindow again
+       */
+      void SetRenderTarget(IRenderTarget* theTarget);
+#endif
+
     protected:
       /**
        * App constructor
@@ -218,6 +249,16 @@ namespace GQE
       bool         mRunning;
       /// Padding
       char         pad_[7];
+#if (SFML_VERSION_MAJOR < 2)
+      // RenderThread requires SFML 2
+#else
+      /// Render thread that replays each frame when bWindowRenderThread is set
+      RenderThread mRenderThread;
+      /// Draws each frame to mWindow when no other IRenderTarget is used
+      WindowRenderTarget mWindowTarget;
+      /// The IRenderTarget given to SetRenderTarget or NULL for mWindowTarget
+      IRenderTarget* mRenderTarget;
+#endif
 
       /**
        * CalculateRange is responsible for returning the best GraphicRange
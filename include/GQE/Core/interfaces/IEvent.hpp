@@ -4,10 +4,13 @@
  * @file include/GQE/Core/interfaces/IEvent.hpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Add DoBatch for delivering queued contexts
+ * @date 20261018 - Check the context type of each queued batch
  */
 #ifndef IEVENT_HPP_INCLUDED
 #define IEVENT_HPP_INCLUDED
 
+#include <typeinfo>
 #include <GQE/Core/Core_types.hpp>
 
 namespace GQE
@@ -58,6 +61,25 @@ namespace GQE
        * the derived IEvent class.
        */
       virtual void DoEvent(void* theContext = NULL) = 0;
+
+      /**
+       * GetContextType will return the type of context DoEvent expects.
+       * @return the type_info of the context or NULL if any context is fine
+       */
+      virtual const std::type_info* GetContextType(void) const;
+
+      /**
+       * DoBatch will be called to perform the IEvent for every context queued
+       * since the last EventManager::Flush call. The default calls DoEvent
+       * once for each context, TBatchEvent hands them over in one call.
+       * Nothing is done if theType doesn't match GetContextType.
+       * @param[in] theContexts stored one after another
+       * @param[in] theCount of contexts provided
+       * @param[in] theSize of each context in bytes
+       * @param[in] theType of each context
+       */
+      virtual void DoBatch(void* theContexts, Uint32 theCount, size_t theSize,
+        const std::type_info& theType);
     protected:
       /**
        * SetType is responsible for setting the type of class this IEvent
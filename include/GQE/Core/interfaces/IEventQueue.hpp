@@ -0,0 +1,89 @@
+/**
+ * Provides the IEventQueue interface class for storing the contexts of
+ * events queued to be delivered later by the EventManager class.
+ *
+ * @file include/GQE/Core/interfaces/IEventQueue.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Check the context type of each queued batch
+ */
+#ifndef IEVENT_QUEUE_HPP_INCLUDED
+#define IEVENT_QUEUE_HPP_INCLUDED
+
+#include <typeinfo>
+#include <GQE/Core/Core_types.hpp>
+
+namespace GQE
+{
+  /// Provides the interface for all queues of event contexts
+  class GQE_API IEventQueue
+  {
+    public:
+      /**
+       * IEventQueue deconstructor
+       */
+      virtual ~IEventQueue()
+      {
+      }
+
+      /**
+       * IsEmpty will return true if no contexts are waiting to be delivered.
+       * @return true if the queue is empty, false otherwise
+       */
+      virtual bool IsEmpty(void) const = 0;
+
+      /**
+       * Swap will move every queued context to the delivered list, dropping
+       * the contexts delivered last time, so contexts queued while the
+       * delivered list is being handled wait for the next delivery.
+       * @return the number of contexts in the delivered list
+       */
+      virtual Uint32 Swap(void) = 0;
+
+      /**
+       * GetDelivered will return the first context of the delivered list.
+       * @return a pointer to the contexts which are stored one after another
+       */
+      virtual void* GetDelivered(void) = 0;
+
+      /**
+       * GetSize will return the size of each context in bytes.
+       * @return the size of each context
+       */
+      virtual size_t GetSize(void) const = 0;
+
+      /**
+       * GetContextType will return the type of each context.
+       * @return the type_info of the contexts queued
+       */
+      virtual const std::type_info& GetContextType(void) const = 0;
+  }; // class IEventQueue
+} // namespace GQE
+#endif // IEVENT_QUEUE_HPP_INCLUDED
+
+/**
+ * @class GQE::IEventQueue
+ * @ingroup Core
+ * The IEventQueue class provides an interface for the EventManager class to
+ * store the contexts of events queued by its Queue methods regardless of the
+ * context type. The TEventQueue class is the only implementation.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
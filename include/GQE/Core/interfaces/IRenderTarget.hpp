@@ -0,0 +1,93 @@
+/**
+ * Provides the IRenderTarget interface class in the GQE namespace which is
+ * responsible for receiving the draw calls of each frame.
+ *
+ * @file include/GQE/Core/interfaces/IRenderTarget.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#ifndef   CORE_IRENDER_TARGET_HPP_INCLUDED
+#define   CORE_IRENDER_TARGET_HPP_INCLUDED
+
+#include <SFML/Graphics.hpp>
+#include <GQE/Core/Core_types.hpp>
+
+namespace GQE
+{
+  /// Provides the IRenderTarget interface for receiving draw calls
+  class GQE_API IRenderTarget
+  {
+    public:
+      /**
+       * IRenderTarget deconstructor
+       */
+      virtual ~IRenderTarget();
+
+      /**
+       * SetView will change the view used by every draw call that follows.
+       * @param[in] theView to use
+       */
+      virtual void SetView(const sf::View& theView) = 0;
+
+      /**
+       * Draw will draw theVertices provided.
+       * @param[in] theVertices to draw
+       * @param[in] theCount of vertices to draw
+       * @param[in] thePrimitive type to draw theVertices with
+       * @param[in] theTexture to draw with or NULL for none
+       */
+      virtual void Draw(const sf::Vertex* theVertices, Uint32 theCount,
+          sf::PrimitiveType thePrimitive, const sf::Texture* theTexture = NULL) = 0;
+
+      /**
+       * Draw will draw theSprite provided.
+       * @param[in] theSprite to draw
+       */
+      virtual void Draw(const sf::Sprite& theSprite) = 0;
+
+      /**
+       * Draw will draw theText provided.
+       * @param[in] theText to draw
+       */
+      virtual void Draw(const sf::Text& theText) = 0;
+
+    protected:
+      /**
+       * IRenderTarget default constructor, only allow derived classes to
+       * create instances.
+       */
+      IRenderTarget();
+  }; // class IRenderTarget
+} // namespace GQE
+
+#endif // CORE_IRENDER_TARGET_HPP_INCLUDED
+
+/**
+ * @class GQE::IRenderTarget
+ * @ingroup Core
+ * The IRenderTarget interface class is what the RenderSystem, StatManager and
+ * SplashState classes draw each frame to (see IApp::GetRenderTarget). The
+ * WindowRenderTarget class issues each call to the render window right away,
+ * the RenderCommandList class records each call for the RenderThread class
+ * and the NullRenderTarget class only counts them so the cost of building a
+ * frame can be measured on machines without a display or graphics driver.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,112 @@
+/**
+ * Provides a system for storing custom Event capable classes that handle
+ * every queued context of an event at once.
+ *
+ * @file include/GQE/Core/interfaces/TBatchEvent.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Check the context type of each queued batch
+ */
+#ifndef TBATCH_EVENT_HPP_INCLUDED
+#define TBATCH_EVENT_HPP_INCLUDED
+
+#include <typeinfo>
+#include <GQE/Core/interfaces/IEvent.hpp>
+#include <GQE/Core/Core_types.hpp>
+
+namespace GQE
+{
+  /// The batch version of the TEvent class for custom event capable classes
+  template<class TCLASS, class TCONTEXT>
+    class TBatchEvent : public IEvent
+  {
+    public:
+      /// Declare the batch function typedef for people to use to pass functions
+      typedef void (TCLASS::*typeBatchFunc)(TCONTEXT* theContexts, Uint32 theCount);
+
+      /**
+       * TBatchEvent default constructor
+       * @param[in] theEventID to use for this event
+       */
+      TBatchEvent(const typeEventID theEventID, TCLASS& theEventClass, typeBatchFunc theBatchFunc) :
+        IEvent(typeid(TCLASS).name(), theEventID),
+        mEventClass(theEventClass),
+        mBatchFunc(theBatchFunc)
+      {
+      }
+
+      /**
+       * DoEvent will be called to perform the IEvent for a single context
+       * which is handed to the batch function as a batch of one.
+       */
+      virtual void DoEvent(void* theContext = NULL)
+      {
+        TCONTEXT* anContext = static_cast<TCONTEXT*>(theContext);
+        // Call the member method provided of the event class provided
+        (mEventClass.*mBatchFunc)(anContext, anContext != NULL ? 1 : 0);
+      }
+
+      /**
+       * GetContextType will return the type of context the batch function
+       * expects.
+       * @return the type_info of TCONTEXT
+       */
+      virtual const std::type_info* GetContextType(void) const
+      {
+        return &typeid(TCONTEXT);
+      }
+
+      /**
+       * DoBatch will be called to perform the IEvent once for every queued
+       * context provided.
+       * @param[in] theContexts stored one after another
+       * @param[in] theCount of contexts provided
+       * @param[in] theSize of each context in bytes
+       * @param[in] theType of each context
+       */
+      virtual void DoBatch(void* theContexts, Uint32 theCount, size_t theSize,
+        const std::type_info& theType)
+      {
+        // Contexts queued with a different type can't be handed over
+        if(theType == typeid(TCONTEXT))
+        {
+          (mEventClass.*mBatchFunc)(static_cast<TCONTEXT*>(theContexts), theCount);
+        }
+      }
+
+    private:
+      /// The address to the event class to use when calling the batch function
+      TCLASS&       mEventClass;
+      /// The function to call in the event class
+      typeBatchFunc mBatchFunc;
+  }; // class TBatchEvent
+} // namespace GQE
+#endif // TBATCH_EVENT_HPP_INCLUDED
+
+/**
+ * @class GQE::TBatchEvent
+ * @ingroup Core
+ * The TBatchEvent class is a version of the TEvent class whose member
+ * function receives every context queued for the event since the last
+ * EventManager::Flush call in one call, so the handler only has to do its
+ * setup once per batch instead of once per event.
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -4,6 +4,7 @@
  * @file include/GQE/Core/interfaces/TEvent.hpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Check the context type of each queued batch
  */
 #ifndef TEVENT_HPP_INCLUDED
 #define TEVENT_HPP_INCLUDED
@@ -44,6 +45,16 @@ namespace GQE
         (mEventClass.*mEventFunc)(anContext);
       }
 
+      /**
+       * GetContextType will return the type of context DoEvent expects.
+       * @return the type_info of TCONTEXT or NULL if TCONTEXT is void
+       */
+      virtual const std::type_info* GetContextType(void) const
+      {
+        // A handler without a context can be given any context
+        return typeid(TCONTEXT) == typeid(void) ? NULL : &typeid(TCONTEXT);
+      }
+
     private:
       /// The address to the event class to use when calling the event function
       TCLASS&       mEventClass;
@@ -0,0 +1,137 @@
+/**
+ * Provides the TEventQueue template class for storing the contexts of
+ * events queued to be delivered later by the EventManager class.
+ *
+ * @file include/GQE/Core/interfaces/TEventQueue.hpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Check the context type of each queued batch
+ */
+#ifndef TEVENT_QUEUE_HPP_INCLUDED
+#define TEVENT_QUEUE_HPP_INCLUDED
+
+#include <typeinfo>
+#include <vector>
+#include <GQE/Core/interfaces/IEventQueue.hpp>
+#include <GQE/Core/Core_types.hpp>
+
+namespace GQE
+{
+  /// The Template version of the IEventQueue class for each context type
+  template<class TCONTEXT>
+    class TEventQueue : public IEventQueue
+  {
+    public:
+      /**
+       * TEventQueue default constructor
+       */
+      TEventQueue()
+      {
+      }
+
+      /**
+       * TEventQueue deconstructor
+       */
+      virtual ~TEventQueue()
+      {
+        mQueued.clear();
+        mDelivered.clear();
+      }
+
+      /**
+       * Push will add a copy of theContext to the end of the queue.
+       * @param[in] theContext to queue
+       * @return true if the queue was empty before theContext was added
+       */
+      bool Push(const TCONTEXT& theContext)
+      {
+        bool anResult = mQueued.empty();
+        mQueued.push_back(theContext);
+        return anResult;
+      }
+
+      /**
+       * IsEmpty will return true if no contexts are waiting to be delivered.
+       * @return true if the queue is empty, false otherwise
+       */
+      virtual bool IsEmpty(void) const
+      {
+        return mQueued.empty();
+      }
+
+      /**
+       * Swap will move every queued context to the delivered list, dropping
+       * the contexts delivered last time. Both lists keep their memory so a
+       * queue that is flushed every tick stops allocating.
+       * @return the number of contexts in the delivered list
+       */
+      virtual Uint32 Swap(void)
+      {
+        mDelivered.clear();
+        mDelivered.swap(mQueued);
+        return (Uint32)mDelivered.size();
+      }
+
+      /**
+       * GetDelivered will return the first context of the delivered list.
+       * @return a pointer to the contexts or NULL if none were delivered
+       */
+      virtual void* GetDelivered(void)
+      {
+        return mDelivered.empty() ? NULL : &mDelivered[0];
+      }
+
+      /**
+       * GetSize will return the size of each context in bytes.
+       * @return the size of each context
+       */
+      virtual size_t GetSize(void) const
+      {
+        return sizeof(TCONTEXT);
+      }
+
+      /**
+       * GetContextType will return the type of each context.
+       * @return the type_info of the contexts queued
+       */
+      virtual const std::type_info& GetContextType(void) const
+      {
+        return typeid(TCONTEXT);
+      }
+
+    private:
+      /// The contexts waiting for the next delivery
+      std::vector<TCONTEXT> mQueued;
+      /// The contexts being delivered
+      std::vector<TCONTEXT> mDelivered;
+  }; // class TEventQueue
+} // namespace GQE
+#endif // TEVENT_QUEUE_HPP_INCLUDED
+
+/**
+ * @class GQE::TEventQueue
+ * @ingroup Core
+ * The TEventQueue class is a templatized version of the IEventQueue class
+ * that keeps a copy of each queued context of type TCONTEXT. The contexts
+ * are stored one after another so they can be delivered to each handler as
+ * a single batch (see TBatchEvent).
+ *
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
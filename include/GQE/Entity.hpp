@@ -9,6 +9,10 @@
  * @date 20120618 - Added missing Entity classes
  * @date 20120623 - Added AnimationSystem class
  * @date 20120720 - Moved PropertyManager to Core library
+ * @date 20261018 - Added SweepAndPrune class
+ * @date 20261018 - Added CollisionUtil functions
+ * @date 20261018 - Added CollisionLayers class
+ * @date 20261018 - Added SpatialGrid class
  */
 #ifndef ENTITY_HPP_INCLUDED
 #define ENTITY_HPP_INCLUDED
@@ -22,6 +26,11 @@
 #include <GQE/Entity/classes/PrototypeManager.hpp>
 #include <GQE/Entity/classes/Instance.hpp>
 #include <GQE/Entity/classes/Prototype.hpp>
+#include <GQE/Entity/classes/SweepAndPrune.hpp>
+#include <GQE/Entity/classes/CollisionLayers.hpp>
+#include <GQE/Entity/classes/PolygonShape.hpp>
+#include <GQE/Entity/classes/RectangleShape.hpp>
+#include <GQE/Entity/classes/SpatialGrid.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
 #include <GQE/Entity/interfaces/ISystem.hpp>
 #include <GQE/Entity/interfaces/ICollisionSystem.hpp>
@@ -29,6 +38,7 @@
 #include <GQE/Entity/systems/TransformSystem.hpp>
 #include <GQE/Entity/systems/RenderSystem.hpp>
 #include <GQE/Entity/systems/ActionSystem.hpp>
+#include <GQE/Entity/utils/CollisionUtil.hpp>
 #endif // ENTITY_HPP_INCLUDED
 
 /**
@@ -9,6 +9,25 @@
  * @date 20120623 - Add forward declaration of ISystem derived classes
  * @date 20120627 - Add forward declaration of ActionSystem classes
  * @date 20120720 - Moved PropertyManager to Core library
+ * @date 20261018 - Add CollisionPair struct for the SweepAndPrune broadphase
+ * @date 20261018 - Add CollisionCache struct for world space collision shapes
+ * @date 20261018 - Add ContactState enum to CollisionData
+ * @date 20261018 - Add ColliderType enum and circle/AABB data to CollisionCache
+ * @date 20261018 - Add CollisionHit struct for collision queries and ray casts
+ * @date 20261018 - Add TimeOfImpact and Sweep for continuous collisions
+ * @date 20261018 - Add convex Pieces of concave shapes to CollisionCache
+ * @date 20261018 - Add CollisionStats struct for collision benchmarks
+ * @date 20261018 - Add RenderItem and RenderStats structs for the render queue
+ * @date 20261018 - Add RenderCache struct and visited IEntity count to RenderStats
+ * @date 20261018 - Add cached vertices to RenderCache
+ * @date 20261018 - Add Source texture to RenderCache for packed images
+ * @date 20261018 - Add RenderChunkKey and RenderChunk structs for static IEntity classes
+ * @date 20261018 - Add typeClipID, AnimationClip and AnimationState for the AnimationSystem
+ * @date 20261018 - Add EventContext struct for input and timer events
+ * @date 20261018 - Store the typeEventIndex of each InputData event
+ * @date 20261018 - Add the transform properties World was built from to RenderCache
+ * @date 20261018 - Keep the AnimationState start time as a double
+ * @date 20261018 - Document the CollisionCache Center of every collider Type
  */
 #ifndef ENTITY_TYPES_HPP_INCLUDED
 #define ENTITY_TYPES_HPP_INCLUDED
@@ -32,6 +51,11 @@ namespace GQE
   class KeyBinder;
   class MouseBinder;
   class JoystickBinder;
+  class SweepAndPrune;
+  class SpatialGrid;
+  class CollisionLayers;
+  class PolygonShape;
+  class RectangleShape;
   // Forward declare GQE Entity systems provided
   class ActionSystem;
   class AnimationSystem;
@@ -44,6 +68,9 @@ namespace GQE
   /// Declare Entity ID typedef which is used for identifying IEntity objects
   typedef Uint32 typeEntityID;
 
+  /// Declare Clip ID typedef which is used for identifying AnimationClip objects
+  typedef Uint32 typeClipID;
+
   /// Declare Prototype ID typedef which is used for identifying Prototype objects
   typedef std::string typePrototypeID;
 
@@ -74,16 +101,38 @@ namespace GQE
     AXIS_VERT = 0x02,
     AXIS_POS = 0x04,
     AXIS_NEG = 0x08
+  };
+  enum ContactState
+  {
+    CONTACT_BEGIN,
+    CONTACT_STAY,
+    CONTACT_END
+  };
+  enum ColliderType
+  {
+    COLLIDER_POLYGON,
+    COLLIDER_CIRCLE,
+    COLLIDER_AABB
   };
 	/// Declare structs for handling data.
 	//InputData Struct stores input data.
 	struct InputData
 	{
-	  typeEventID EventID;
+	  /// The EventManager index of the event to do, 0 for no event
+	  typeEventIndex EventID;
 	  Uint32 Type;
     Uint32 Action;
     Uint32 Axis;
     Uint32 Device;
+    InputData() :
+      EventID(0),
+      Type(0),
+      Action(0),
+      Axis(0),
+      Device(0)
+    {
+
+    }
 	};
 
   struct CollisionData
@@ -91,6 +140,275 @@ namespace GQE
     IEntity* MovingEntity;
     IEntity* OtherEntity;
     sf::Vector2f MinimumTranslation;
+    ContactState State;
+    /// Fraction of the update the contact began at, 1 for discrete contacts
+    float TimeOfImpact;
+    CollisionData() :
+      MovingEntity(NULL),
+      OtherEntity(NULL),
+      State(CONTACT_BEGIN),
+      TimeOfImpact(1.0f)
+    {
+
+    }
+  };
+  //CollisionPair Struct stores two IEntity classes whose bounding boxes overlap.
+  struct CollisionPair
+  {
+    IEntity* First;
+    IEntity* Second;
+  };
+  //CollisionCache Struct stores the world space geometry of a CollisionShape.
+  struct CollisionCache
+  {
+    std::vector<sf::Vector2f> Points;
+    std::vector<float> PointsX;
+    std::vector<float> PointsY;
+    std::vector<sf::Vector2f> Normals;
+    sf::FloatRect Bounds;
+    /// Distance moved this update by a continuous collider, otherwise zero
+    sf::Vector2f Sweep;
+    /// Convex pieces of a concave shape, each tested in place of the whole
+    std::vector<CollisionCache> Pieces;
+    Uint32 Type;
+    /// Center of a circle or of the bounding box of any other collider
+    sf::Vector2f Center;
+    float Radius;
+    sf::Vector2f Position;
+    float Rotation;
+    sf::Vector2f Scale;
+    sf::Vector2f Origin;
+    bool Dirty;
+    CollisionCache() :
+      Type(COLLIDER_POLYGON),
+      Radius(0.0f),
+      Rotation(0.0f),
+      Dirty(true)
+    {
+
+    }
+  };
+  //CollisionStats Struct stores the work done by the last collision update.
+  struct CollisionStats
+  {
+    /// Number of IEntity classes given to the broadphase
+    Uint32 Proxies;
+    /// Number of pairs whose bounding boxes overlap
+    Uint32 Pairs;
+    /// Number of narrowphase tests performed
+    Uint32 Tests;
+    /// Number of contacts delivered, including ended contacts
+    Uint32 Contacts;
+    CollisionStats() :
+      Proxies(0),
+      Pairs(0),
+      Tests(0),
+      Contacts(0)
+    {
+
+    }
+  };
+  //RenderItem Struct stores one visible IEntity queued by the RenderSystem.
+  struct RenderItem
+  {
+    /// Sort key made of the view, layer, Texture and depth of the item
+    Uint64 Key;
+    /// The cached world vertices of the item
+    const sf::Vertex* Vertices;
+    /// Number of world vertices of the item
+    Uint32 Count;
+    /// Primitive type of the vertices, sf::Triangles unless points or lines
+    Uint32 Primitive;
+    /// Index of the view used by the item
+    Uint32 View;
+    /// Index of the Texture used by the item
+    Uint32 Texture;
+  };
+  //AnimationClip Struct stores the frames of an animation shared by every
+  //IEntity the AnimationSystem plays it on.
+  struct AnimationClip
+  {
+    std::string Name;
+    /// Texture rectangle of each frame in the order they are shown
+    typeRectList Frames;
+    float FramesPerSecond;
+    /// True if the clip starts over after the last frame
+    bool Loop;
+  };
+  //AnimationState Struct stores the clip an IEntity is playing.
+  struct AnimationState
+  {
+    IEntity* Entity;
+    typeClipID Clip;
+    /// Shared animation time the clip was started at
+    double Start;
+    /// Multiplies the frames per second of the clip
+    float Speed;
+    /// Index of the frame last shown
+    Uint32 Frame;
+  };
+  //RenderChunkKey Struct identifies the chunk a static IEntity is baked into
+  //by the RenderSystem.
+  struct RenderChunkKey
+  {
+    /// View used by every member
+    std::string View;
+    /// Layer (z-order) of every member
+    Uint32 Layer;
+    /// Texture used by every member
+    const sf::Texture* Texture;
+    /// Column and row of the chunk in the world
+    Int32 X;
+    Int32 Y;
+    RenderChunkKey() :
+      Layer(0),
+      Texture(NULL),
+      X(0),
+      Y(0)
+    {
+
+    }
+    bool operator<(const RenderChunkKey& theOther) const
+    {
+      if(View != theOther.View)
+      {
+        return View < theOther.View;
+      }
+      if(Layer != theOther.Layer)
+      {
+        return Layer < theOther.Layer;
+      }
+      if(Texture != theOther.Texture)
+      {
+        return Texture < theOther.Texture;
+      }
+      if(Y != theOther.Y)
+      {
+        return Y < theOther.Y;
+      }
+      return X < theOther.X;
+    }
+    bool operator==(const RenderChunkKey& theOther) const
+    {
+      return View == theOther.View && Layer == theOther.Layer &&
+        Texture == theOther.Texture && X == theOther.X && Y == theOther.Y;
+    }
+  };
+  //RenderChunk Struct stores the world vertices of every static IEntity the
+  //RenderSystem baked into one chunk so they are culled and drawn together.
+  struct RenderChunk
+  {
+    /// IDs of the static IEntity classes in the chunk
+    std::vector<typeEntityID> Members;
+    /// True if Vertices need to be baked again before the next draw
+    bool Dirty;
+    /// Lowest depth of the members, used to sort the chunk in the queue
+    Uint32 Depth;
+    /// Number of visible members baked into Vertices
+    Uint32 Visible;
+    /// World vertices of every visible member in depth order
+    std::vector<sf::Vertex> Vertices;
+    /// Bounds of every member
+    sf::FloatRect Bounds;
+    RenderChunk() :
+      Dirty(true),
+      Depth(0),
+      Visible(0)
+    {
+
+    }
+  };
+  //RenderCache Struct stores the vertices and bounds of an IEntity drawn by
+  //the RenderSystem between changes to its properties.
+  struct RenderCache
+  {
+    IEntity* Entity;
+    /// View whose SpatialGrid holds the IEntity
+    std::string View;
+    /// Order the IEntity was added to the RenderSystem in
+    Uint32 Depth;
+    /// True if the cache needs to be rebuilt before the next draw
+    bool Dirty;
+    /// The bVisible property when the cache was built
+    bool Visible;
+    /// True if Local was built from a VertexArray property
+    bool Custom;
+    /// True if World is baked into Chunk instead of being drawn on its own
+    bool Static;
+    /// The chunk World is baked into if Static is true
+    RenderChunkKey Chunk;
+    /// The texture Local is drawn with, a TextureAtlas page if Source was packed
+    const sf::Texture* Texture;
+    /// The Texture, rTextureRect and cColor properties Local was built from
+    const sf::Texture* Source;
+    sf::IntRect TextureRect;
+    sf::Color Color;
+    /// Size of rTextureRect, or of the Texture if rTextureRect is empty
+    sf::Vector2f Size;
+    /// Primitive type of Local and World, sf::Triangles unless points or lines
+    Uint32 Primitive;
+    /// Vertices before the IEntity transform is applied
+    std::vector<sf::Vertex> Local;
+    /// Bounds of Local
+    sf::FloatRect LocalBounds;
+    /// Vertices after the IEntity transform is applied
+    std::vector<sf::Vertex> World;
+    /// Bounds of World
+    sf::FloatRect Bounds;
+    /// The vPosition, fRotation, vScale and vOrigin properties World was built from
+    sf::Vector2f Position;
+    float Rotation;
+    sf::Vector2f Scale;
+    sf::Vector2f Origin;
+    RenderCache() :
+      Entity(NULL),
+      Depth(0),
+      Dirty(true),
+      Visible(true),
+      Custom(false),
+      Static(false),
+      Texture(NULL),
+      Source(NULL),
+      Primitive(0),
+      Rotation(0.0f)
+    {
+
+    }
+  };
+  //RenderStats Struct stores the work done by the last RenderSystem draw.
+  struct RenderStats
+  {
+    /// Number of IEntity classes found near each view by the SpatialGrid
+    Uint32 Candidates;
+    /// Number of visible items sorted by the render queue
+    Uint32 Items;
+    /// Number of draw calls submitted
+    Uint32 DrawCalls;
+    /// Number of view and Texture changes
+    Uint32 StateChanges;
+    /// Number of chunks of static IEntity classes queued
+    Uint32 Chunks;
+    RenderStats() :
+      Candidates(0),
+      Items(0),
+      DrawCalls(0),
+      StateChanges(0),
+      Chunks(0)
+    {
+
+    }
+  };
+  //CollisionHit Struct stores an IEntity found by a collision query or ray cast.
+  struct CollisionHit
+  {
+    typeEntityID EntityID;
+    IEntity* Entity;
+    /// Where the ray entered or the center of the query shape
+    sf::Vector2f Point;
+    /// Unit normal of the surface hit by a ray or from the query toward the IEntity
+    sf::Vector2f Normal;
+    /// Distance along the ray or how far the query shape overlaps the IEntity
+    float Distance;
   };
   struct TimerData
   {
@@ -120,6 +438,28 @@ namespace GQE
     }
   };
   typedef std::map<std::string, TimerData> typeTimerLists;
+  //EventContext Struct is provided to each event done by the KeyBinder,
+  //MouseBinder, JoystickBinder and TimerSystem classes.
+  struct EventContext
+  {
+    /// The IEntity the event was done for
+    IEntity* Entity;
+    /// The binding that did the event or NULL if a timer did the event
+    const InputData* Input;
+    /// The timer that did the event or NULL if a binding did the event
+    const TimerData* Timer;
+    /// The mouse position or joystick axis position of input events
+    sf::Vector2f Position;
+    EventContext(IEntity* theEntity = NULL, const InputData* theInput = NULL,
+        const TimerData* theTimer = NULL) :
+      Entity(theEntity),
+      Input(theInput),
+      Timer(theTimer),
+      Position(0.0f, 0.0f)
+    {
+
+    }
+  };
   typedef std::map<Uint32, InputData > typeInputDataList;
 }
 #endif // ENTITY_TYPES_HPP_INCLUDED
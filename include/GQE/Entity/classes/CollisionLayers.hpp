@@ -0,0 +1,142 @@
+/**
+ * Provides the CollisionLayers class which maps collision layer names to the
+ * bits used by the uCollisionLayer and uCollisionMask properties.
+ *
+ * @file include/GQE/Entity/classes/CollisionLayers.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+#ifndef COLLISION_LAYERS_HPP_INCLUDED
+#define COLLISION_LAYERS_HPP_INCLUDED
+
+#include <map>
+#include <string>
+#include <vector>
+#include <GQE/Core/classes/ConfigReader.hpp>
+#include <GQE/Entity/Entity_types.hpp>
+
+namespace GQE
+{
+  /// Provides the table of named collision layers and their default masks
+  class GQE_API CollisionLayers
+  {
+    public:
+      /// The name of the layer every IEntity is on by default
+      static const std::string DEFAULT_LAYER;
+      /// The mask used for layers that don't specify a mask
+      static const Uint32 ALL_LAYERS;
+
+      /**
+       * CollisionLayers default constructor
+       */
+      CollisionLayers();
+
+      /**
+       * CollisionLayers deconstructor
+       */
+      virtual ~CollisionLayers();
+
+      /**
+       * AddLayer will assign the next unused bit to theLayerName provided if
+       * it hasn't already been added.
+       * @param[in] theLayerName to add
+       * @return the bit assigned to theLayerName or 0 if all 32 are in use
+       */
+      Uint32 AddLayer(const std::string theLayerName);
+
+      /**
+       * GetLayer will return the bit assigned to theLayerName provided.
+       * @param[in] theLayerName to find
+       * @return the bit assigned or 0 if theLayerName doesn't exist
+       */
+      Uint32 GetLayer(const std::string theLayerName) const;
+
+      /**
+       * SetMask will set the default mask used by theLayerName provided.
+       * @param[in] theLayerName to set the mask for
+       * @param[in] theMask of layers theLayerName collides with
+       */
+      void SetMask(const std::string theLayerName, const Uint32 theMask);
+
+      /**
+       * GetMask will return the default mask used by theLayerName provided.
+       * @param[in] theLayerName to find
+       * @return the mask found or ALL_LAYERS if none was set
+       */
+      Uint32 GetMask(const std::string theLayerName) const;
+
+      /**
+       * ParseLayers will convert a comma separated list of layer names into
+       * a mask. The name "all" can be used to specify every layer.
+       * @param[in] theLayerNames to convert
+       * @return the mask of each layer found
+       */
+      Uint32 ParseLayers(const std::string theLayerNames) const;
+
+      /**
+       * LoadFromConfig will add each layer listed in the "layers" value of
+       * theSection and set the mask of each layer to the comma separated list
+       * of layer names given by the value with the same name as the layer.
+       * For example:
+       *   [collision]
+       *   layers=player,enemy,bullet,wall
+       *   bullet=enemy,wall
+       * @param[in] theConfig to read the layers from
+       * @param[in] theSection of theConfig to use
+       * @return true if any layers were found, false otherwise
+       */
+      bool LoadFromConfig(const ConfigReader& theConfig,
+          const std::string theSection = "collision");
+
+    private:
+      /**
+       * SplitNames will split a comma separated list of names into theResult
+       * provided after removing any spaces around each name.
+       * @param[in] theNames to split
+       * @param[out] theResult to add each name to
+       */
+      static void SplitNames(const std::string theNames,
+          std::vector<std::string>& theResult);
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The bit assigned to each layer name
+      std::map<const std::string, Uint32> mLayers;
+      /// The default mask for each layer name
+      std::map<const std::string, Uint32> mMasks;
+      /// The next bit to assign in AddLayer
+      Uint32 mNextLayer;
+  }; // CollisionLayers class
+} // namespace GQE
+
+#endif // COLLISION_LAYERS_HPP_INCLUDED
+
+/**
+ * @class GQE::CollisionLayers
+ * @ingroup Entity
+ * The CollisionLayers class assigns a bit to each named collision layer and
+ * keeps the default mask of layers each layer collides with. The
+ * ICollisionSystem class uses this table to convert the sCollisionLayer
+ * property of each IEntity into its uCollisionLayer and uCollisionMask
+ * properties. The "default" layer always uses the first bit and is the layer
+ * every IEntity is on unless told otherwise.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -5,6 +5,7 @@
  * @file include/GQE/Entity/classes/EntityEvents.hpp
  * @author Jacob Dix
  * @date 20140410 - Initial Release
+ * @date 20261018 - Use EventContext instead of a PropertyManager context
 */
 #ifndef ENTITY_EVENTS_HPP_INCLUDED
 #define ENTITY_EVENTS_HPP_INCLUDED
@@ -16,7 +17,7 @@ namespace GQE
   public:
     EntityEvents(IApp& theApp);
     virtual void RegisterEvents();
-    void EventDestroyEntity(PropertyManager* theContext);
+    void EventDestroyEntity(EventContext* theContext);
   protected:
     IApp& mApp;
   };
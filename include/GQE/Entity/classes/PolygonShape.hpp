@@ -1,44 +1,108 @@
 /**
- * A basic class for Triangle collision objects
+ * Provides the PolygonShape class which splits a concave outline into the
+ * convex pieces used by the ICollisionSystem class.
  *
- * @file include/GQE/Entity/classes/RectangleShape.hpp
+ * @file include/GQE/Entity/classes/PolygonShape.hpp
  * @author Jacob Dix
- * @date
+ * @date 20261018 - Cache the convex decomposition of concave outlines
  */
-#ifndef POLYGON_COLLISION_HPP_INCLUDED
-#define POLYGON_COLLISION_HPP_INCLUDED
+#ifndef POLYGON_SHAPE_HPP_INCLUDED
+#define POLYGON_SHAPE_HPP_INCLUDED
 
-#include <map>
-#include <GQE/Core/interfaces/IShape.hpp>
+#include <vector>
+#include <SFML/System.hpp>
 #include <GQE/Entity/Entity_types.hpp>
 
 namespace GQE
 {
-  /// Provides the TriangleShape class
-  class GQE_API PolygonShape : public IShape
+  /// Provides the PolygonShape class
+  class GQE_API PolygonShape
   {
     public:
       /**
-       * TriangleShape default constructor
+       * PolygonShape default constructor
+       * @param[in] thePoints of the outline in clockwise or counter clockwise order
        */
-			PolygonShape(std::vector<sf::Vector2f> thePoints);
+      PolygonShape(const std::vector<sf::Vector2f>& thePoints = std::vector<sf::Vector2f>());
 
       /**
-       * TriangleShape deconstructor
+       * PolygonShape deconstructor
        */
       virtual ~PolygonShape();
 
+      /**
+       * SetPoints will replace the outline of this PolygonShape and split it
+       * into convex pieces right away so the work is only done once.
+       * @param[in] thePoints of the outline in clockwise or counter clockwise order
+       */
+      void SetPoints(const std::vector<sf::Vector2f>& thePoints);
+
+      /**
+       * GetPoints will return the outline of this PolygonShape.
+       * @return the points of the outline
+       */
+      const std::vector<sf::Vector2f>& GetPoints(void) const;
+
+      /**
+       * GetPieceCount will return the number of convex pieces the outline
+       * was split into.
+       * @return the number of convex pieces, 0 if the outline is empty
+       */
+      Uint32 GetPieceCount(void) const;
+
+      /**
+       * GetPiece will return the points of the convex piece at theIndex
+       * provided in the same winding order as the outline.
+       * @param[in] theIndex of the piece to return
+       * @return the points of the convex piece
+       */
+      const std::vector<sf::Vector2f>& GetPiece(const Uint32 theIndex) const;
+
+      /**
+       * IsConvex will return true if the outline didn't need to be split.
+       * @return true if the outline is a single convex piece
+       */
+      bool IsConvex(void) const;
+
     protected:
+      /**
+       * Decompose will triangulate the outline by ear clipping and then merge
+       * the triangles back together as long as each merged piece is convex.
+       */
+      void Decompose(void);
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The outline provided to SetPoints
+      std::vector<sf::Vector2f> mPoints;
+      /// The convex pieces of the outline
+      std::vector<std::vector<sf::Vector2f> > mPieces;
 
     private:
-  };
+      /**
+       * IsConvexPiece will return true if every corner of thePiece turns the
+       * same way as a counter clockwise outline.
+       * @param[in] thePoints of the outline
+       * @param[in] thePiece indices into thePoints to check
+       * @return true if thePiece is convex
+       */
+      static bool IsConvexPiece(const std::vector<sf::Vector2f>& thePoints,
+          const std::vector<Uint32>& thePiece);
+  }; // PolygonShape class
 } // namespace GQE
 
-#endif // TRIANGLE_COLLISION_HPP_INCLUDED
+#endif // POLYGON_SHAPE_HPP_INCLUDED
 
 /**
- * @class GQE::TriangleShape
+ * @class GQE::PolygonShape
  * @ingroup Entity
+ * The PolygonShape class holds the outline of a possibly concave collision
+ * shape along with the convex pieces it was split into. The outline is split
+ * once when the points are provided (ear clipping followed by merging the
+ * triangles back into the fewest convex pieces it can) so a single
+ * PolygonShape can be shared by every Instance of a Prototype through the
+ * CollisionPolygon property of the ICollisionSystem class. The PolygonShape
+ * must outlive every IEntity that uses it.
  *
  * Copyright (c) 2010-2012 Jacob Dix
  * Permission is hereby granted, free of charge, to any person obtaining a copy
@@ -1,46 +1,52 @@
 /**
- * A basic class for rectangle collision objects
+ * Provides the RectangleShape class which is a PolygonShape with four corners.
  *
  * @file include/GQE/Entity/classes/RectangleShape.hpp
  * @author Jacob Dix
- * @date 
+ * @date 20261018 - Derive from PolygonShape
  */
-#ifndef RECTANGLE_COLLISION_HPP_INCLUDED
-#define RECTANGLE_COLLISION_HPP_INCLUDED
+#ifndef RECTANGLE_SHAPE_HPP_INCLUDED
+#define RECTANGLE_SHAPE_HPP_INCLUDED
 
-#include <map>
-#include <GQE/Core/interfaces/IShape.hpp>
+#include <GQE/Entity/classes/PolygonShape.hpp>
 #include <GQE/Entity/Entity_types.hpp>
 
 namespace GQE
 {
   /// Provides the RectangleShape class
-  class GQE_API RectangleShape : public IShape
+  class GQE_API RectangleShape : public PolygonShape
   {
     public:
       /**
        * RectangleShape default constructor
+       * @param[in] theWidth of the rectangle
+       * @param[in] theHeight of the rectangle
        */
-      RectangleShape(GQE::Uint32 theWidth=0,GQE::Uint32 theHeight=0);
+      RectangleShape(const Uint32 theWidth = 0, const Uint32 theHeight = 0);
 
       /**
        * RectangleShape deconstructor
        */
       virtual ~RectangleShape();
 
-			void GenerateRectangle(GQE::Uint32 theWidth=0,GQE::Uint32 theHeight=0);
-    protected:
-
-    private:
-  };
+      /**
+       * GenerateRectangle will replace the outline with a rectangle of
+       * theWidth and theHeight provided whose top left corner is at 0,0.
+       * @param[in] theWidth of the rectangle
+       * @param[in] theHeight of the rectangle
+       */
+      void GenerateRectangle(const Uint32 theWidth = 0, const Uint32 theHeight = 0);
+  }; // RectangleShape class
 } // namespace GQE
 
-#endif // RECTANGLE_COLLISION_HPP_INCLUDED
+#endif // RECTANGLE_SHAPE_HPP_INCLUDED
 
 /**
  * @class GQE::RectangleShape
  * @ingroup Entity
- * 
+ * The RectangleShape class is a PolygonShape whose outline is a rectangle,
+ * which is always a single convex piece.
+ *
  * Copyright (c) 2010-2012 Jacob Dix
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -0,0 +1,171 @@
+/**
+ * Provides the SpatialGrid class which finds the IEntity classes within a
+ * region without visiting every IEntity.
+ *
+ * @file include/GQE/Entity/classes/SpatialGrid.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Erase each cell once it is empty
+ */
+#ifndef SPATIAL_GRID_HPP_INCLUDED
+#define SPATIAL_GRID_HPP_INCLUDED
+
+#include <map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <GQE/Entity/Entity_types.hpp>
+
+namespace GQE
+{
+  /// Provides a loose grid for finding the IEntity classes within a region
+  class GQE_API SpatialGrid
+  {
+    public:
+      /**
+       * SpatialGrid default constructor
+       * @param[in] theCellSize is the width and height of each grid cell
+       */
+      SpatialGrid(const float theCellSize = 256.0f);
+
+      /**
+       * SpatialGrid deconstructor
+       */
+      virtual ~SpatialGrid();
+
+      /**
+       * GetCellSize will return the width and height of each grid cell.
+       * @return the size of each grid cell
+       */
+      float GetCellSize(void) const;
+
+      /**
+       * GetProxyCount will return the number of IEntity classes currently
+       * registered with this grid.
+       * @return the number of proxies registered
+       */
+      Uint32 GetProxyCount(void) const;
+
+      /**
+       * HasProxy will return true if theEntity provided currently has a
+       * bounding box registered with this grid.
+       * @param[in] theEntity to look for
+       * @return true if theEntity has a proxy, false otherwise
+       */
+      bool HasProxy(const IEntity* theEntity) const;
+
+      /**
+       * UpdateProxy will add or update the bounding box used for theEntity
+       * provided. Moving within the same cell only saves the new bounds.
+       * @param[in] theEntity to add or update
+       * @param[in] theBounds to use for theEntity in world coordinates
+       */
+      void UpdateProxy(IEntity* theEntity, const sf::FloatRect& theBounds);
+
+      /**
+       * DropProxy will remove theEntity from this grid.
+       * @param[in] theEntity to remove
+       */
+      void DropProxy(const IEntity* theEntity);
+
+      /**
+       * QueryAABB will add every IEntity whose bounding box overlaps theRect
+       * provided to theResult. Only the cells near theRect are visited.
+       * @param[in] theRect to search in world coordinates
+       * @param[out] theResult to add each IEntity found to
+       */
+      void QueryAABB(const sf::FloatRect& theRect,
+          std::vector<IEntity*>& theResult) const;
+
+    private:
+      /// Bounding box and cell of each registered IEntity
+      struct Proxy
+      {
+        IEntity* Entity;
+        sf::FloatRect Bounds;
+        /// Key of the cell holding the center, unused if Oversized
+        Uint64 Cell;
+        /// Index of this proxy in its cell or in mOversized
+        Uint32 Slot;
+        /// True if the bounds are larger than a cell
+        bool Oversized;
+      };
+
+      /**
+       * GetCellKey will return the key of the cell at theX and theY provided.
+       * @param[in] theX column of the cell
+       * @param[in] theY row of the cell
+       * @return the key for this cell
+       */
+      static Uint64 GetCellKey(const Int32 theX, const Int32 theY);
+
+      /**
+       * GetCellIndex will return the column or row containing theValue.
+       * @param[in] theValue to convert in world coordinates
+       * @return the column or row of theValue
+       */
+      Int32 GetCellIndex(const float theValue) const;
+
+      /**
+       * Link will add the proxy at theIndex to the cell its center is in or
+       * to the oversized list.
+       * @param[in] theIndex of the proxy to add
+       */
+      void Link(const Uint32 theIndex);
+
+      /**
+       * Unlink will remove the proxy at theIndex from its cell or from the
+       * oversized list. The cell is erased once it is empty.
+       * @param[in] theIndex of the proxy to remove
+       */
+      void Unlink(const Uint32 theIndex);
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The width and height of each grid cell
+      float mCellSize;
+      /// All proxies, unused proxies are listed in mFreeProxies
+      std::vector<Proxy> mProxies;
+      /// Proxy indexes that can be reused by UpdateProxy
+      std::vector<Uint32> mFreeProxies;
+      /// Proxy index for each IEntity ID registered
+      std::map<const typeEntityID, Uint32> mProxyIDs;
+      /// Proxy indexes of each cell holding the center of a proxy
+      std::map<const Uint64, std::vector<Uint32> > mCells;
+      /// Proxy indexes of proxies larger than a cell
+      std::vector<Uint32> mOversized;
+  }; // SpatialGrid class
+} // namespace GQE
+
+#endif // SPATIAL_GRID_HPP_INCLUDED
+
+/**
+ * @class GQE::SpatialGrid
+ * @ingroup Entity
+ * The SpatialGrid class is a loose grid used by the RenderSystem class to
+ * find the IEntity classes that are within a view without visiting every
+ * IEntity. Each IEntity is kept in the one cell that holds the center of its
+ * bounding box, so moving an IEntity only touches the cell it leaves and the
+ * cell it enters. Since an IEntity no larger than a cell can only reach half
+ * a cell past the cell holding its center, a query only needs to visit the
+ * cells overlapping the region grown by half a cell. IEntity classes larger
+ * than a cell are kept in a separate list that every query checks.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
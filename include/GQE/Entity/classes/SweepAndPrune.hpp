@@ -0,0 +1,225 @@
+/**
+ * Provides the SweepAndPrune class which is used as the broadphase by the
+ * ICollisionSystem class to find IEntity pairs whose bounding boxes overlap.
+ *
+ * @file include/GQE/Entity/classes/SweepAndPrune.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add collision layer and mask filtering of pairs
+ * @date 20261018 - Add QueryAABB for finding proxies within a region
+ */
+#ifndef SWEEP_AND_PRUNE_HPP_INCLUDED
+#define SWEEP_AND_PRUNE_HPP_INCLUDED
+
+#include <map>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <GQE/Entity/Entity_types.hpp>
+
+namespace GQE
+{
+  /// Provides a sort and sweep broadphase for finding overlapping IEntity pairs
+  class GQE_API SweepAndPrune
+  {
+    public:
+      /**
+       * SweepAndPrune default constructor
+       * @param[in] theAxes to sort along (AXIS_HORZ and/or AXIS_VERT)
+       */
+      SweepAndPrune(const Uint32 theAxes = AXIS_HORZ | AXIS_VERT);
+
+      /**
+       * SweepAndPrune deconstructor
+       */
+      virtual ~SweepAndPrune();
+
+      /**
+       * HasProxy will return true if theEntity provided currently has a
+       * bounding box registered with this broadphase.
+       * @param[in] theEntity to look for
+       * @return true if theEntity has a proxy, false otherwise
+       */
+      bool HasProxy(const IEntity* theEntity) const;
+
+      /**
+       * UpdateProxy will add or update the bounding box used for theEntity
+       * provided. The interval lists are not resorted until Update is called.
+       * Two proxies only form a pair if the layer of each is in the mask of
+       * the other.
+       * @param[in] theEntity to add or update
+       * @param[in] theBounds to use for theEntity in world coordinates
+       * @param[in] theLayer bits theEntity belongs to
+       * @param[in] theMask of layer bits theEntity can collide with
+       */
+      void UpdateProxy(IEntity* theEntity, const sf::FloatRect& theBounds,
+          const Uint32 theLayer = 0xFFFFFFFF, const Uint32 theMask = 0xFFFFFFFF);
+
+      /**
+       * DropProxy will remove theEntity from this broadphase and add each
+       * overlapping pair it was part of to the removed pairs list.
+       * @param[in] theEntity to remove
+       */
+      void DropProxy(const IEntity* theEntity);
+
+      /**
+       * Update will resort each interval list using an insertion sort which
+       * is nearly linear since most bounding boxes only move a little each
+       * tick. Pairs that begin or stop overlapping during the sort are added
+       * to the added or removed pairs list.
+       */
+      void Update(void);
+
+      /**
+       * QueryAABB will add every IEntity whose bounding box overlaps theRect
+       * provided and whose layer is in theMask provided to theResult. This
+       * uses the sorted lists from the last Update and doesn't change this
+       * broadphase, so it can be called by several threads at once as long as
+       * nothing else is changing this broadphase at the same time.
+       * @param[in] theRect to search in world coordinates
+       * @param[in] theMask of layer bits to include
+       * @param[out] theResult to add each IEntity found to
+       */
+      void QueryAABB(const sf::FloatRect& theRect, const Uint32 theMask,
+          std::vector<IEntity*>& theResult) const;
+
+      /**
+       * GetPairs will return every pair currently overlapping, ordered by
+       * the IEntity IDs of each pair.
+       * @return the map of overlapping pairs
+       */
+      const std::map<const Uint64, CollisionPair>& GetPairs(void) const;
+
+      /**
+       * GetAddedPairs will return the pairs that began overlapping since the
+       * last time ClearChanges was called.
+       * @return the vector of added pairs
+       */
+      const std::vector<CollisionPair>& GetAddedPairs(void) const;
+
+      /**
+       * GetRemovedPairs will return the pairs that stopped overlapping since
+       * the last time ClearChanges was called.
+       * @return the vector of removed pairs
+       */
+      const std::vector<CollisionPair>& GetRemovedPairs(void) const;
+
+      /**
+       * ClearChanges will clear the added and removed pairs lists.
+       */
+      void ClearChanges(void);
+
+      /**
+       * GetPairKey will return the key used to identify the pair of IEntity
+       * IDs provided regardless of the order they are provided in.
+       * @param[in] theFirstID of the pair
+       * @param[in] theSecondID of the pair
+       * @return the key for this pair
+       */
+      static Uint64 GetPairKey(const typeEntityID theFirstID,
+          const typeEntityID theSecondID);
+
+    private:
+      /// Bounding box and IEntity address for each registered IEntity
+      struct Proxy
+      {
+        IEntity* Entity;
+        sf::FloatRect Bounds;
+        Uint32 Layer;
+        Uint32 Mask;
+      };
+      /// Minimum or maximum edge of a Proxy along one axis
+      struct Endpoint
+      {
+        float Value;
+        Uint32 ProxyIndex;
+        bool Minimum;
+      };
+
+      /**
+       * SortAxis will insertion sort theEndpoints provided and will add or
+       * remove pairs as each minimum endpoint passes a maximum endpoint.
+       * @param[in] theEndpoints to sort
+       */
+      void SortAxis(std::vector<Endpoint>& theEndpoints);
+
+      /**
+       * Overlaps will return true if the Proxy layers and masks provided
+       * allow them to collide and their bounds overlap along every axis this
+       * broadphase is sorting along.
+       * @param[in] theFirst proxy index to compare
+       * @param[in] theSecond proxy index to compare
+       * @return true if both proxies overlap, false otherwise
+       */
+      bool Overlaps(const Uint32 theFirst, const Uint32 theSecond) const;
+
+      /**
+       * AddPair will add the pair of proxies provided to the overlapping
+       * pairs map if it isn't already there.
+       * @param[in] theFirst proxy index of the pair
+       * @param[in] theSecond proxy index of the pair
+       */
+      void AddPair(const Uint32 theFirst, const Uint32 theSecond);
+
+      /**
+       * RemovePair will remove the pair of proxies provided from the
+       * overlapping pairs map if it was there.
+       * @param[in] theFirst proxy index of the pair
+       * @param[in] theSecond proxy index of the pair
+       */
+      void RemovePair(const Uint32 theFirst, const Uint32 theSecond);
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The axes (AXIS_HORZ and/or AXIS_VERT) being sorted along
+      const Uint32 mAxes;
+      /// All proxies, unused proxies are listed in mFreeProxies
+      std::vector<Proxy> mProxies;
+      /// Proxy indexes that can be reused by UpdateProxy
+      std::vector<Uint32> mFreeProxies;
+      /// Proxy index for each IEntity ID registered
+      std::map<const typeEntityID, Uint32> mProxyIDs;
+      /// Sorted endpoints along the horizontal [0] and vertical [1] axes
+      std::vector<Endpoint> mEndpoints[2];
+      /// The largest proxy width [0] and height [1] found by the last Update
+      float mMaxExtent[2];
+      /// All pairs currently overlapping keyed by GetPairKey
+      std::map<const Uint64, CollisionPair> mPairs;
+      /// Pairs that began overlapping since ClearChanges was called
+      std::vector<CollisionPair> mAdded;
+      /// Pairs that stopped overlapping since ClearChanges was called
+      std::vector<CollisionPair> mRemoved;
+  }; // SweepAndPrune class
+} // namespace GQE
+
+#endif // SWEEP_AND_PRUNE_HPP_INCLUDED
+
+/**
+ * @class GQE::SweepAndPrune
+ * @ingroup Entity
+ * The SweepAndPrune class keeps the minimum and maximum edges of each IEntity
+ * bounding box in sorted lists along one or two axes. Since objects move very
+ * little from one tick to the next the lists stay nearly sorted and can be
+ * resorted each tick with an insertion sort. Every time a minimum edge passes
+ * a maximum edge the pair either begins or stops overlapping along that axis,
+ * which allows the overlapping pairs to be maintained incrementally instead
+ * of testing every IEntity against every other IEntity.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
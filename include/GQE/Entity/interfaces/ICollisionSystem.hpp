@@ -4,12 +4,28 @@
  * @file include/GQE/Entity/systems/ICollisionSystem.hpp
  * @author Jacob Dix
  * @date 20120611 Initial release
+ * @date 20261018 - Use SweepAndPrune broadphase to find pairs to test
+ * @date 20261018 - Cache world space collision geometry for each IEntity
+ * @date 20261018 - Add collision layers and masks checked in the broadphase
+ * @date 20261018 - Split the narrowphase tests across worker threads
+ * @date 20261018 - Keep a contact cache and report begin/stay/end contacts
+ * @date 20261018 - Add circle and AABB colliders selected by uColliderType
+ * @date 20261018 - Add point, region and ray cast queries over the broadphase
+ * @date 20261018 - Add swept tests for IEntity classes flagged as bContinuous
+ * @date 20261018 - Add CollisionPolygon for concave shapes split into convex pieces
+ * @date 20261018 - Add GetStats for the work done by the last update
+ * @date 20261018 - Only use sCollisionLayer names that were added to mLayers
+ * @date 20261018 - Keep each narrowphase worker thread running between updates
  */
 #ifndef ICOLLISION_SYSTEM_HPP_INCLUDED
 #define ICOLLISION_SYSTEM_HPP_INCLUDED
 
+#include <map>
+#include <vector>
 #include <SFML/System.hpp>
 #include <GQE/Entity/interfaces/ISystem.hpp>
+#include <GQE/Entity/classes/SweepAndPrune.hpp>
+#include <GQE/Entity/classes/CollisionLayers.hpp>
 #include <GQE/Entity/Entity_types.hpp>
 #include <GQE/Core/classes/EventManager.hpp>
 
@@ -23,8 +39,10 @@ namespace GQE
       /**
        * ICollisionSystem Constructor.
        * @param[in] theApp is the current GQE app.
+       * @param[in] theSweepAxes to sort along in the broadphase
        */
-      ICollisionSystem(IApp& theApp);
+      ICollisionSystem(IApp& theApp,
+          const Uint32 theSweepAxes = AXIS_HORZ | AXIS_VERT);
 
       /**
        * ICollisionSystem Destructor.
@@ -68,6 +86,106 @@ namespace GQE
        * class.
        */
       virtual void Draw(void);
+
+      /**
+       * InvalidateCollisionShape must be called after the CollisionShape,
+       * CollisionPolygon, uColliderType or fCollisionRadius property of
+       * theEntity is changed so its cached world space geometry is rebuilt
+       * on the next update even if theEntity did not move.
+       * @param[in] theEntity whose CollisionShape was changed
+       */
+      void InvalidateCollisionShape(const IEntity* theEntity);
+
+      /**
+       * QueryPoint will add a CollisionHit to theHits provided for every
+       * IEntity whose collider contains thePoint provided, ordered by ID.
+       * @param[in] thePoint to test in world coordinates
+       * @param[out] theHits to add each IEntity found to
+       * @param[in] theMask of collision layers to include
+       * @return the number of hits added to theHits
+       */
+      Uint32 QueryPoint(const sf::Vector2f& thePoint, std::vector<CollisionHit>& theHits,
+          const Uint32 theMask = CollisionLayers::ALL_LAYERS) const;
+
+      /**
+       * QueryAABB will add a CollisionHit to theHits provided for every
+       * IEntity whose collider overlaps theRect provided, ordered by ID.
+       * @param[in] theRect to test in world coordinates
+       * @param[out] theHits to add each IEntity found to
+       * @param[in] theMask of collision layers to include
+       * @return the number of hits added to theHits
+       */
+      Uint32 QueryAABB(const sf::FloatRect& theRect, std::vector<CollisionHit>& theHits,
+          const Uint32 theMask = CollisionLayers::ALL_LAYERS) const;
+
+      /**
+       * QueryCircle will add a CollisionHit to theHits provided for every
+       * IEntity whose collider overlaps the circle provided, ordered by ID.
+       * @param[in] theCenter of the circle in world coordinates
+       * @param[in] theRadius of the circle
+       * @param[out] theHits to add each IEntity found to
+       * @param[in] theMask of collision layers to include
+       * @return the number of hits added to theHits
+       */
+      Uint32 QueryCircle(const sf::Vector2f& theCenter, const float theRadius,
+          std::vector<CollisionHit>& theHits,
+          const Uint32 theMask = CollisionLayers::ALL_LAYERS) const;
+
+      /**
+       * RayCast will find the first IEntity hit by the ray provided.
+       * @param[in] theOrigin of the ray in world coordinates
+       * @param[in] theDirection of the ray (does not need to be a unit vector)
+       * @param[in] theMaxDistance the ray can travel
+       * @param[out] theHit found if any
+       * @param[in] theMask of collision layers to include
+       * @return true if any IEntity was hit, false otherwise
+       */
+      bool RayCast(const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+          const float theMaxDistance, CollisionHit& theHit,
+          const Uint32 theMask = CollisionLayers::ALL_LAYERS) const;
+
+      /**
+       * RayCastAll will add a CollisionHit to theHits provided for every
+       * IEntity hit by the ray provided, ordered by distance along the ray.
+       * @param[in] theOrigin of the ray in world coordinates
+       * @param[in] theDirection of the ray (does not need to be a unit vector)
+       * @param[in] theMaxDistance the ray can travel
+       * @param[out] theHits to add each IEntity hit to
+       * @param[in] theMask of collision layers to include
+       * @return the number of hits added to theHits
+       */
+      Uint32 RayCastAll(const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+          const float theMaxDistance, std::vector<CollisionHit>& theHits,
+          const Uint32 theMask = CollisionLayers::ALL_LAYERS) const;
+
+      /**
+       * SetThreadCount will set the number of threads (including the main
+       * thread) used to perform the narrowphase tests each update. The
+       * default of 1 performs every test on the main thread. Each extra
+       * thread is started here and waits for tests until it is removed.
+       * @param[in] theThreadCount to use, values below 1 are treated as 1
+       */
+      void SetThreadCount(const Uint32 theThreadCount);
+
+      /**
+       * GetThreadCount will return the number of threads used to perform the
+       * narrowphase tests each update.
+       * @return the number of threads used
+       */
+      Uint32 GetThreadCount(void) const;
+
+      /**
+       * GetStats will return the number of proxies, broadphase pairs,
+       * narrowphase tests and contacts from the last UpdateFixed call.
+       * @return the CollisionStats of the last update
+       */
+      const CollisionStats& GetStats(void) const;
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The collision layers used to resolve the sCollisionLayer property
+      CollisionLayers mLayers;
+
     protected:
       /**
        * HandleInit is called to allow each derived ISystem to perform any
@@ -83,17 +201,269 @@ namespace GQE
       virtual void HandleCleanup(IEntity* theEntity);
       /**
        * EntityCollision is to be derived by the a system in the game code. This allows handling of 
-       * Collision per game.
+       * Collision per game. It is called every update for each pair that
+       * intersects with a State of CONTACT_BEGIN on the first update and
+       * CONTACT_STAY on every update after that.
        */
       virtual void EntityCollision(CollisionData anCollisionData)=0;
+
+      /**
+       * EntityCollisionEnd is called once for a pair that intersected on the
+       * last update but no longer does, or when either IEntity is dropped
+       * from this ISystem. The MinimumTranslation provided is the last one
+       * found for the pair.
+       * @param[in] anCollisionData of the pair that no longer intersects
+       */
+      virtual void EntityCollisionEnd(CollisionData anCollisionData);
+
+      /**
+       * HandlePairAdded is called when the bounding boxes of thePair provided
+       * begin to overlap in the broadphase.
+       * @param[in] thePair of IEntity classes that now overlap
+       */
+      virtual void HandlePairAdded(const CollisionPair& thePair);
+
+      /**
+       * HandlePairRemoved is called when the bounding boxes of thePair
+       * provided no longer overlap in the broadphase or when either IEntity
+       * is dropped from this ISystem.
+       * @param[in] thePair of IEntity classes that no longer overlap
+       */
+      virtual void HandlePairRemoved(const CollisionPair& thePair);
+
       /**
        * Prooject a shape onto an axis.
        */
       static void ProjectOntoAxis(const sf::Shape& theShape, const sf::Vector2f& theAxis, float& theMin, float& theMax);
 
       static bool Intersection(sf::Shape& theMovingShape, sf::Shape& theOtherShape, sf::Vector2f& theMinimumTranslation);
+
+      /**
+       * ProjectOntoAxis will project the world space points of theCache
+       * provided onto theAxis and return the minimum and maximum found.
+       * @param[in] theCache containing the world space points to project
+       * @param[in] theAxis to project onto
+       * @param[out] theMin projection found
+       * @param[out] theMax projection found
+       */
+      static void ProjectOntoAxis(const CollisionCache& theCache, const sf::Vector2f& theAxis, float& theMin, float& theMax);
+
+      /**
+       * Intersection will use the separating axis theorem to test the cached
+       * world space geometry of two shapes and return the minimum translation
+       * vector if they intersect. The SIMD version of the test is used when
+       * available and circle or AABB colliders use their own tests (see
+       * ColliderIntersection).
+       * @param[in] theMovingCache of the moving shape
+       * @param[in] theOtherCache of the other shape
+       * @param[out] theMinimumTranslation found if they intersect
+       * @return true if both shapes intersect, false otherwise
+       */
+      static bool Intersection(const CollisionCache& theMovingCache, const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
     private:
-      std::vector<IEntity*> mMovables;
+      /// The fewest narrowphase tests worth giving to each extra thread
+      static const size_t MIN_TESTS_PER_THREAD = 256;
+
+      /// The results of the last narrowphase test between two IEntity classes
+      struct ContactCache
+      {
+        IEntity* MovingEntity;
+        IEntity* OtherEntity;
+        /// The last minimum translation found while intersecting
+        sf::Vector2f MinimumTranslation;
+        /// The last separating axis found or zero while intersecting
+        sf::Vector2f SeparatingAxis;
+        /// The update this pair was last tested in
+        Uint32 Update;
+        /// True if the pair intersected when last tested
+        bool Touching;
+      };
+
+      /// A narrowphase test found by the broadphase for this update
+      struct NarrowphaseTest
+      {
+        IEntity* MovingEntity;
+        IEntity* OtherEntity;
+        const CollisionCache* MovingCache;
+        const CollisionCache* OtherCache;
+        /// The contact for this test, only written by the worker testing it
+        ContactCache* Contact;
+      };
+
+      /// The range of narrowphase tests and contacts found by each thread
+      struct NarrowphaseWorker
+      {
+        /// The tests shared by every worker for this update
+        const std::vector<NarrowphaseTest>* Tests;
+        /// The first test this worker should perform
+        size_t Begin;
+        /// One past the last test this worker should perform
+        size_t End;
+        /// The contacts found by this worker, kept between updates
+        std::vector<CollisionData> Contacts;
+        /// The thread used by this worker or NULL for the main thread
+        sf::Thread* Thread;
+        /// Protects Running, Started and Pending below
+        sf::Mutex Mutex;
+        /// True until the worker is removed and its thread should exit
+        bool Running;
+        /// True once the thread has started waiting for tests
+        bool Started;
+        /// True while the tests from Begin to End are waiting to be performed
+        bool Pending;
+
+        /**
+         * Run will perform each test from Begin to End and add a contact to
+         * Contacts for every test that intersects or no longer intersects.
+         */
+        void Run(void);
+
+        /**
+         * Process is the thread of this worker, it will call Run each time
+         * Pending is set and clear it again until Running is cleared.
+         */
+        void Process(void);
+
+        /**
+         * Stop will clear Running and wait for the thread to exit.
+         */
+        void Stop(void);
+      };
+
+      /**
+       * UpdateCollisionCache will rebuild the world space geometry in
+       * theCache provided using the CollisionShape of theEntity moved to
+       * where theEntity will be after this update, but only if the
+       * transform of theEntity has changed or theCache was invalidated.
+       * @param[in] theEntity to get the CollisionShape from
+       * @param[in] theCache to update
+       * @return true if theCache has any points, false otherwise
+       */
+      static bool UpdateCollisionCache(IEntity* theEntity, CollisionCache& theCache);
+
+      /**
+       * BuildPolygonCache will fill theCache provided with thePoints of a
+       * convex polygon moved into world space by theTransform provided.
+       * @param[in] theTransform to move each point by
+       * @param[in] thePoints of the polygon in local space
+       * @param[in] theCache to fill
+       */
+      static void BuildPolygonCache(const sf::Transform& theTransform,
+          const std::vector<sf::Vector2f>& thePoints, CollisionCache& theCache);
+
+      /**
+       * CompareContacts is used to sort contacts by the ID of the moving
+       * IEntity and then by the ID of the other IEntity.
+       * @param[in] theFirst contact to compare
+       * @param[in] theSecond contact to compare
+       * @return true if theFirst should be delivered before theSecond
+       */
+      static bool CompareContacts(const CollisionData& theFirst, const CollisionData& theSecond);
+
+      /**
+       * CompareHitIDs is used to sort query hits by IEntity ID.
+       * @param[in] theFirst hit to compare
+       * @param[in] theSecond hit to compare
+       * @return true if theFirst should come before theSecond
+       */
+      static bool CompareHitIDs(const CollisionHit& theFirst, const CollisionHit& theSecond);
+
+      /**
+       * CompareHitDistances is used to sort ray cast hits by distance and
+       * then by IEntity ID.
+       * @param[in] theFirst hit to compare
+       * @param[in] theSecond hit to compare
+       * @return true if theFirst should come before theSecond
+       */
+      static bool CompareHitDistances(const CollisionHit& theFirst, const CollisionHit& theSecond);
+
+      /**
+       * QueryCollider will add a CollisionHit to theHits provided for every
+       * IEntity whose collider overlaps theQuery collider provided.
+       * @param[in] theQuery collider to test
+       * @param[in] thePoint to report as the CollisionHit Point
+       * @param[out] theHits to add each IEntity found to
+       * @param[in] theMask of collision layers to include
+       * @return the number of hits added to theHits
+       */
+      Uint32 QueryCollider(const CollisionCache& theQuery, const sf::Vector2f& thePoint,
+          std::vector<CollisionHit>& theHits, const Uint32 theMask) const;
+
+      /**
+       * RayCastCandidates will add a CollisionHit to theHits provided for
+       * every IEntity in the broadphase hit by the ray provided.
+       * @param[in] theOrigin of the ray in world coordinates
+       * @param[in] theDirection of the ray as a unit vector
+       * @param[in] theMaxDistance the ray can travel
+       * @param[out] theHits to add each IEntity hit to
+       * @param[in] theMask of collision layers to include
+       */
+      void RayCastCandidates(const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+          const float theMaxDistance, std::vector<CollisionHit>& theHits,
+          const Uint32 theMask) const;
+
+      /**
+       * GetContactKey will return the key used for the contact between
+       * theMovingID and theOtherID provided in mContactCache.
+       * @param[in] theMovingID of the moving IEntity
+       * @param[in] theOtherID of the other IEntity
+       * @return the key to use
+       */
+      static Uint64 GetContactKey(const typeEntityID theMovingID, const typeEntityID theOtherID);
+
+      /**
+       * AddTests will add the narrowphase tests for each movable IEntity of
+       * every overlapping pair found by the broadphase to mTests.
+       */
+      void AddTests(void);
+
+      /**
+       * AddTest will add a narrowphase test of theMovingEntity against
+       * theOtherEntity to mTests using the contact found in mContactCache.
+       * @param[in] theMovingEntity that is moving
+       * @param[in] theOtherEntity to test against
+       */
+      void AddTest(IEntity* theMovingEntity, IEntity* theOtherEntity);
+
+      /**
+       * RunTests will split mTests across the worker threads, wait for them
+       * to finish and merge their contacts into mContacts.
+       */
+      void RunTests(void);
+
+      /**
+       * ExpireContacts will remove every contact in mContactCache that was
+       * not tested this update and add an ended contact to mContacts for
+       * each one that was still touching.
+       */
+      void ExpireContacts(void);
+
+      /**
+       * DispatchPairChanges will call HandlePairAdded and HandlePairRemoved
+       * for each pair the broadphase added or removed since the last call.
+       */
+      void DispatchPairChanges(void);
+
+      // Variables
+      ///////////////////////////////////////////////////////////////////////////
+      /// The broadphase used to find the pairs to test each update
+      SweepAndPrune mBroadphase;
+      /// Every movable IEntity added to this ISystem
+      std::map<const typeEntityID, IEntity*> mMovables;
+      /// The world space collision geometry of each IEntity for this update
+      std::map<const typeEntityID, CollisionCache> mCaches;
+      /// The narrowphase tests to perform this update
+      std::vector<NarrowphaseTest> mTests;
+      /// The workers used to perform the narrowphase tests
+      std::vector<NarrowphaseWorker*> mWorkers;
+      /// The sorted contacts from every worker to deliver this update
+      std::vector<CollisionData> mContacts;
+      /// The last narrowphase results for each moving and other IEntity pair
+      std::map<const Uint64, ContactCache> mContactCache;
+      /// The number of updates performed, used to expire old contacts
+      Uint32 mUpdate;
+      /// The work done by the last update
+      CollisionStats mStats;
 
   }; // class ICollisionSystem
 } // namespace GQE
@@ -103,15 +473,68 @@ namespace GQE
 /**
  * @class GQE::ICollisionSystem
  * @ingroup Entity
- * The ICollisionSystem class is used as a base for collision systems.
- * following properties it provides:
- * - rBoundingBox: a rectangle for the size of the entity.
- * The MovementSystem class makes use of the following properties provided by the
- * RenderSystem class:
+ * The ICollisionSystem class is used as a base for collision systems. Each
+ * update the bounding box of every CollisionShape is given to a SweepAndPrune
+ * broadphase and only the pairs it reports as overlapping are tested using
+ * the separating axis theorem. These narrowphase tests only read the cached
+ * geometry and can be split across several threads (see SetThreadCount), the
+ * contacts found are then sorted by the ID of the moving IEntity and the ID of
+ * the other IEntity and EntityCollision is called for each one on the main
+ * thread so the order never depends on the number of threads used. Since
+ * every test uses the geometry from the start of the narrowphase, any
+ * response made in EntityCollision is not seen by the remaining tests until
+ * the next update. The result of each test is kept between updates so the
+ * axis that last separated a pair is tried first and EntityCollision can tell
+ * a new contact (CONTACT_BEGIN) from a resting one (CONTACT_STAY), while
+ * EntityCollisionEnd is called when a contact ends.
+ *
+ * An IEntity with bContinuous set is swept from vPosition to vPosition plus
+ * vVelocity against each other IEntity where it ends. If it doesn't intersect
+ * where it ends but touched during the sweep, EntityCollision is given the
+ * TimeOfImpact and a MinimumTranslation that moves it back to where it first
+ * touched, so fast objects don't pass through thin ones even at a low fixed
+ * update rate.
+ *
+ * The QueryPoint, QueryAABB, QueryCircle, RayCast and RayCastAll methods
+ * search the broadphase for the IEntity classes found in a region or along a
+ * ray using the collision geometry from the last update. They don't change
+ * this ISystem, so several threads can call them at once between updates but
+ * never while UpdateFixed is running or an IEntity is being added or dropped.
+ * The ICollisionSystem class provides the
+ * following properties:
+ * - CollisionShape: The sf::ConvexShape used for collision tests (a
+ *   COLLIDER_AABB uses its unrotated bounds and a COLLIDER_CIRCLE its center)
+ * - bDebugDraw: A boolean indicating the CollisionShape should be drawn
+ * - vCollisionOffset: The sf::Vector2f offset of the CollisionShape
+ * - fCollisionRotation: The rotation of the CollisionShape
+ * - bSolid: A boolean indicating this IEntity can collide with others
+ * - uCollisionLayer: The layer bits this IEntity belongs to
+ * - uCollisionMask: The layer bits this IEntity can collide with
+ * - sCollisionLayer: The name of a layer added to mLayers used to set both the
+ *   uCollisionLayer and uCollisionMask properties when the IEntity is added,
+ *   unknown names are reported and leave both properties unchanged
+ * - uColliderType: The ColliderType used for the CollisionShape, either
+ *   COLLIDER_POLYGON (default), COLLIDER_CIRCLE or COLLIDER_AABB
+ * - fCollisionRadius: The radius of a COLLIDER_CIRCLE, if 0 the radius is
+ *   fit to the bounds of the CollisionShape
+ * - bContinuous: A boolean indicating this IEntity moves fast enough to pass
+ *   through other colliders in one update and should be swept
+ * - CollisionPolygon: A PolygonShape pointer used in place of the
+ *   CollisionShape of a COLLIDER_POLYGON, NULL by default. A concave outline
+ *   is tested one cached convex piece at a time and reports the deepest
+ *   contact as a single contact with the IEntity. Every Instance of a
+ *   Prototype shares the same PolygonShape, which must outlive them
+ * The ICollisionSystem class makes use of the following properties provided
+ * by the TransformSystem class:
  * - vPosition: The sf::Vector2f representing the current IEntity position
- * The MovementSystem class makes use of the following properties provided by the
- * MovementSystem class:
- * * - bFixedMovement: A boolean indicating fixed movement math should be used
+ * - vVelocity: The sf::Vector2f representing the current IEntity velocity
+ * - vScale: The sf::Vector2f representing the current IEntity scale
+ * - fRotation: The current IEntity rotation
+ * - bMovable: A boolean indicating this IEntity moves and should be tested
+ * The ICollisionSystem class makes use of the following properties provided
+ * by the RenderSystem class:
+ * - vOrigin: The sf::Vector2f origin as a ratio of the IEntity size
+ *
  * Copyright (c) 2010-2012 Jacob Dix
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
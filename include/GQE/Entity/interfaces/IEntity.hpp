@@ -13,6 +13,7 @@
  * @date 20120623 - Adjusted scope of some IEntity variables
  * @date 20120630 - Add virtual Destroy method to be called to destroy an IEntity class
  * @date 20121108 - Fix warning: type qualifiers ignored on function return type
+ * @date 20261018 - Add GetSystem to find a registered ISystem by its ID
  */
 #ifndef IENTITY_HPP_INCLUDED
 #define IENTITY_HPP_INCLUDED
@@ -89,6 +90,14 @@ namespace GQE
        */
       bool HasSystem(const typeSystemID theSystemID) const;
 
+      /**
+       * GetSystem will return the ISystem registered with this IEntity class
+       * under theSystemID provided.
+       * @param[in] theSystemID to find
+       * @return a pointer to the ISystem or NULL if none was registered
+       */
+      ISystem* GetSystem(const typeSystemID theSystemID) const;
+
       /**
        * DropSystem removes a dependent system from the entity.
        * @param[in] theSystemID to find and drop from this entity
@@ -5,10 +5,18 @@
  * @author Jacob Dix
  * @date 20120623 - Initial Release
  * @date 20130918 - Revised Animation Methods.
+ * @date 20261018 - Tell the RenderSystem about each rTextureRect change
+ * @date 20261018 - Share AnimationClip frames and evaluate every IEntity from one clock
+ * @date 20261018 - Give each frame change to RenderSystem::UpdateFrame
+ * @date 20261018 - Count fixed updates in a Uint64 and show frames between them in UpdateVariable
+ * @date 20261018 - Tell the RenderSystem of each IEntity about its new frame without SetRenderSystem
+ * @date 20261018 - Only read uAnimationClip and fAnimationSpeed when an IEntity is added
  */
 #ifndef ANIMATION_SYSTEM_HPP_INCLUDED
 #define ANIMATION_SYSTEM_HPP_INCLUDED
 
+#include <map>
+#include <vector>
 #include <GQE/Entity/interfaces/ISystem.hpp>
 #include <GQE/Entity/Entity_types.hpp>
 
@@ -36,6 +44,59 @@ namespace GQE
        */
       virtual void AddProperties(IEntity* theEntity);
 
+      /**
+       * SetRenderSystem will set theRenderSystem to tell about each IEntity
+       * whose frame changes instead of the RenderSystem each IEntity was
+       * added to.
+       * @param[in] theRenderSystem to tell or NULL to use RenderSystem::Find
+       */
+      void SetRenderSystem(RenderSystem* theRenderSystem);
+
+      /**
+       * AddClip will add theFrames provided to the clip library under
+       * theClipName, or replace the frames of the clip already using that
+       * name, so every IEntity can share them.
+       * @param[in] theClipName to give the clip
+       * @param[in] theFrames of the clip in the order they are shown
+       * @param[in] theFramesPerSecond to show the frames at
+       * @param[in] theLoop indicates the clip starts over after the last frame
+       * @return the ID of the clip to provide to Play or uAnimationClip
+       */
+      typeClipID AddClip(const std::string theClipName, const typeRectList& theFrames,
+          float theFramesPerSecond = 6.0f, bool theLoop = true);
+
+      /**
+       * GetClip will return the ID of the clip added under theClipName.
+       * @param[in] theClipName of the clip to find
+       * @return the ID of the clip or 0 if no clip uses that name
+       */
+      typeClipID GetClip(const std::string theClipName) const;
+
+      /**
+       * Play will start theClipID provided from its first frame on theEntity.
+       * The uAnimationClip and fAnimationSpeed properties are not changed.
+       * @param[in] theEntity to animate
+       * @param[in] theClipID to play or 0 to stop animating theEntity
+       * @param[in] theSpeed to multiply the frames per second of the clip by
+       */
+      void Play(IEntity* theEntity, const typeClipID theClipID, float theSpeed = 1.0f);
+
+      /**
+       * GetFrame will return the index of the frame of its clip theEntity is
+       * showing.
+       * @param[in] theEntity to return the frame of
+       * @return the frame index or 0 if theEntity isn't animated
+       */
+      Uint32 GetFrame(const IEntity* theEntity) const;
+
+      /**
+       * GetTime will return the number of seconds of fixed updates this
+       * AnimationSystem has seen plus the seconds of variable updates since
+       * the last one, which every clip is played against.
+       * @return the shared animation time in seconds
+       */
+      double GetTime(void) const;
+
       /**
        * HandleEvents is responsible for letting each Instance class have a
        * chance to handle theEvent specified.
@@ -44,29 +105,21 @@ namespace GQE
       virtual void HandleEvents(sf::Event theEvent);
 
       /**
-       * UpdateFixed is called a specific number of times every game loop and
-       * this method will allow each Instance class a chance to have its
-       * UpdateFixed method called for each game loop iteration.
+       * UpdateFixed will advance the shared animation time by one fixed
+       * update and then work out the frame of every animated IEntity from it
+       * in a single pass.
        */
-      virtual void EntityUpdateFixed(IEntity* theEntity);
+      virtual void UpdateFixed(void);
 
       /**
-       * UpdateVariable is called every time the game loop draws a frame and
-       * includes the elapsed time between the last UpdateVariable call for
-       * use with equations that use time as a variable. (e.g. physics velocity
-       * and acceleration equations).
+       * UpdateVariable will advance the shared animation time by
+       * theElapsedTime provided, up to the time of the next fixed update, and
+       * then work out the frame of every animated IEntity from it so clips
+       * faster than the fixed update rate don't skip frames.
+       * @param[in] theElapsedTime since the last UpdateVariable call
        */
       virtual void UpdateVariable(float theElapsedTime);
 
-      /**
-       * EntityDraw is called during the game loop after events and the fixed update
-       * loop calls are completed and depends largely on the speed of the
-       * computer to determine how frequently it will be called. This gives the
-       * EntityManager a chance to call the Draw method for each Instance
-       * class.
-       */
-      virtual void EntityDraw(IEntity* theEntity);
-
     protected:
       /**
        * HandleInit is called to allow each derived ISystem to perform any
@@ -80,7 +133,26 @@ namespace GQE
        * to perform any custom work before the IEntity is deleted.
        */
       virtual void HandleCleanup(IEntity* theEntity);
+
+      /**
+       * UpdateFrames will work out the frame of every animated IEntity from
+       * the shared animation time and show it if it changed.
+       */
+      void UpdateFrames(void);
+
     private:
+      /// The RenderSystem to tell about each frame change
+      RenderSystem* mRenderSystem;
+      /// The clip library, the clip with ID N is at index N-1
+      std::vector<AnimationClip> mClips;
+      /// The clip each IEntity is playing, kept together for the update pass
+      std::vector<AnimationState> mStates;
+      /// The index into mStates of each IEntity added
+      std::map<const typeEntityID, Uint32> mStateIndex;
+      /// Number of fixed updates seen so far
+      Uint64 mTicks;
+      /// Seconds of variable updates since the last fixed update
+      float mPartial;
   }; // class AnimationSystem
 } // namespace GQE
 #endif // ANIMATION_SYSTEM_HPP_INCLUDED
@@ -88,24 +160,30 @@ namespace GQE
 /**
  * @class GQE::AnimationSystem
  * @ingroup Entity
- * The AnimationSystem class is used to update the SpriteRect property of each
- * IEntity to cause its Sprite image to show animation. The properties provided
- * by this ISystem are as follows:
- * - FrameClock: The sf::Clock which keeps track of when IEntity was last animated
- * - fFrameDelay: The float which determines in seconds when to animate next
- * - vFrameModifier: The sf::Vector2u to determine the next animation frame to use
- * - rFrameRect: The sf::IntRect which acounts for the animation boundaries
- * The AnimationSystem class makes use of the following properties provided by the
- * RenderSystem class:
- * - rSpriteRect: The sf::IntRect currently being shown
- * The math involved is essentially this:
- * rSpriteRect.x += (rSpriteRect.Width*FrameModifier.x)
- * rSpriteRect.y += (rSpriteRect.Height*FrameModifier.y)
- * And the resulting rSpriteRect.x and rSpriteRect.y values are limited to
- * rFrameRect.x and rFrameRect.y. Your vFrameModifier values will typically be set
- * to x=1,y=0 or vice-versa depending on how your animations are organized
- * (horizontal or vertical).
- * 
+ * The AnimationSystem class is used to update the rTextureRect property of
+ * each IEntity to cause its Sprite image to show animation. Animations are
+ * kept in a clip library (see AddClip) where the frames of each clip are
+ * stored once and referred to by a small clip ID, so a Prototype only needs
+ * to store the clip ID for every Instance to share the frames. The properties
+ * provided by this ISystem are as follows, both are only read when the
+ * IEntity is added so a Prototype can give every Instance its first clip:
+ * - uAnimationClip: The typeClipID of the clip to play when the IEntity is added
+ * - fAnimationSpeed: The float to multiply the frames per second of the clip by
+ * Once added, each IEntity only keeps its clip, the time it started and its
+ * speed (see Play) and no longer has a clock of its own. The shared animation
+ * time is the number of fixed updates seen, kept as a Uint64 so it never loses
+ * precision, divided by the update rate plus the time of the variable updates
+ * since the last fixed update. Each fixed and variable update advances it and
+ * works out the frame of each IEntity from it in a single pass:
+ * frame = (time - start) * speed * frames per second
+ * which either wraps around or stops on the last frame of the clip. The
+ * rTextureRect property provided by the RenderSystem is only set when the
+ * frame changes. Each IEntity whose frame changes is given to
+ * RenderSystem::UpdateFrame of the RenderSystem it was added to (or the one
+ * given to SetRenderSystem) along with its new rTextureRect, and the
+ * RenderSystem only moves the texture coordinates of those IEntity classes
+ * instead of rebuilding them.
+ *
  * Copyright (c) 2010-2012 Jacob Dix
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
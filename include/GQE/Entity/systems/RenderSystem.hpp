@@ -8,11 +8,26 @@
  * @date 20120618 - Use IEntity not Instance and changed AddPrototype to AddProperties
  * @date 20120622 - Changed HandleInit and HandleCleanup
  * @date 20120623 - Improved documentation and adjusted some properties
+ * @date 20261018 - Batch consecutive sprites sharing a texture and view
+ * @date 20261018 - Sort visible sprites by view, layer and texture with a radix sort
+ * @date 20261018 - Cull each view using a SpatialGrid of IEntity bounds
+ * @date 20261018 - Cache the vertices of each IEntity until its properties change
+ * @date 20261018 - Record each frame while the IApp render thread is running
+ * @date 20261018 - Draw each frame to IApp::GetRenderTarget
+ * @date 20261018 - Draw packed images from their ImageHandler TextureAtlas page
+ * @date 20261018 - Bake static IEntity classes into chunks drawn with one call each
+ * @date 20261018 - Only move the texture coordinates of IEntity classes given to UpdateFrame
+ * @date 20261018 - Take an EventContext in EventViewEntity and center the sView of the IEntity
+ * @date 20261018 - Find changed IEntity classes before each Draw unless SetDetectChanges is false
+ * @date 20261018 - Rebuild every IEntity after the TextureAtlas is built again
+ * @date 20261018 - Add Find and only compare IEntity classes against their cache if asked to
  */
 #ifndef RENDER_SYSTEM_HPP_INCLUDED
 #define RENDER_SYSTEM_HPP_INCLUDED
 
+#include <vector>
 #include <GQE/Entity/interfaces/ISystem.hpp>
+#include <GQE/Entity/classes/SpatialGrid.hpp>
 #include <GQE/Entity/Entity_types.hpp>
 
 namespace GQE
@@ -63,17 +78,112 @@ namespace GQE
       virtual void EntityUpdateVariable(IEntity* theEntity,float theElapsedTime);
 
       /**
-       * Draw is called during the game loop after events and the fixed update
-       * loop calls are completed and depends largely on the speed of the
-       * computer to determine how frequently it will be called. This gives the
-       * EntityManager a chance to call the Draw method for each Instance
-       * class.
+       * Draw will queue every IEntity the SpatialGrid of each view finds
+       * within that view, sort the queue by view, layer, Texture and depth and
+       * then submit a single draw call for each run of queued items that share
+       * the same Texture and view.
+       */
+      virtual void Draw(void);
+
+      /**
+       * EntityDraw will add the cached vertices of theEntity provided to the
+       * render queue if theEntity is visible in its view. The queue is sorted
+       * and submitted when Draw is finished.
+       * @param[in] theEntity to add to the render queue
        */
       virtual void EntityDraw(IEntity* theEntity);
 
+      /**
+       * ChunkDraw will add the baked vertices of theChunk provided to the
+       * render queue if any part of theChunk is visible in its view.
+       * @param[in] theKey of the chunk holding its view, layer and Texture
+       * @param[in] theChunk to add to the render queue
+       */
+      void ChunkDraw(const RenderChunkKey& theKey, const RenderChunk& theChunk);
+
+      /**
+       * SetChunkSize will set the width and height of the chunks each static
+       * IEntity is baked into, 512 by default.
+       * @param[in] theChunkSize in world units
+       */
+      void SetChunkSize(float theChunkSize);
+
+      /**
+       * GetChunkSize will return the width and height of the chunks each
+       * static IEntity is baked into.
+       * @return the chunk size in world units
+       */
+      float GetChunkSize(void) const;
+
+      /**
+       * GetStats will return the work done by the last call to Draw.
+       * @return the statistics of the last frame drawn
+       */
+      const RenderStats& GetStats(void) const;
+
+      /**
+       * GetVisibleCount will return the number of IEntity classes drawn in
+       * theViewID provided by the last call to Draw.
+       * @param[in] theViewID of the view to return the count for
+       * @return the number of IEntity classes drawn in the view
+       */
+      Uint32 GetVisibleCount(const std::string theViewID) const;
+
+      /**
+       * SetDetectChanges will decide if the properties of every IEntity that
+       * isn't static are compared against its cache before each Draw, which
+       * is off by default since it costs a few property lookups per IEntity
+       * every frame. Turn this on while porting a game that changes
+       * properties used by the RenderSystem without calling UpdateEntity.
+       * @param[in] theDetectChanges is true to find changed IEntity classes
+       */
+      void SetDetectChanges(bool theDetectChanges);
+
+      /**
+       * GetDetectChanges will return true if the properties of every IEntity
+       * are compared against its cache before each Draw.
+       * @return true if changed IEntity classes are found before each Draw
+       */
+      bool GetDetectChanges(void) const;
+
+      /**
+       * UpdateEntity must be called after any property used by the
+       * RenderSystem (position, rotation, scale, origin, Texture,
+       * rTextureRect, cColor, VertexArray, sView, bVisible or bStatic) of
+       * theEntity provided changes so its cached vertices and bounds are
+       * rebuilt before the next Draw. The TransformSystem calls this for each
+       * IEntity it moves and the AnimationSystem calls UpdateFrame instead.
+       * @param[in] theEntity whose properties have changed
+       */
+      void UpdateEntity(IEntity* theEntity);
+
+      /**
+       * Find will return the RenderSystem theEntity provided was added to so
+       * other ISystem classes can tell it about the properties they change.
+       * @param[in] theEntity to find the RenderSystem of
+       * @return the RenderSystem or NULL if theEntity wasn't added to one
+       */
+      static RenderSystem* Find(const IEntity* theEntity);
+
+      /**
+       * UpdateFrame is called by the AnimationSystem each time theEntity
+       * provided shows a new frame. If nothing else about theEntity changed
+       * only the texture coordinates of its cached vertices are moved to
+       * theTextureRect before the next Draw.
+       * @param[in] theEntity whose rTextureRect has changed
+       * @param[in] theTextureRect of the new frame
+       */
+      void UpdateFrame(IEntity* theEntity, const sf::IntRect& theTextureRect);
+
       virtual void SetView(std::string theViewID,sf::View theView);
       virtual sf::View GetView(std::string theViewID);
-      void EventViewEntity(PropertyManager* theContext);
+
+      /**
+       * EventViewEntity will center the view the IEntity of theContext is
+       * drawn in on the position of the IEntity.
+       * @param[in] theContext of the event
+       */
+      void EventViewEntity(EventContext* theContext);
 		protected:
       /**
        * HandleInit is called to allow each derived ISystem to perform any
@@ -88,9 +198,153 @@ namespace GQE
        */
       virtual void HandleCleanup(IEntity* theEntity);
 
+      /**
+       * RefreshEntities will rebuild the cache and update the SpatialGrid
+       * bounds of each IEntity provided to UpdateEntity since the last call
+       * to Draw, or of every IEntity if the TextureAtlas pages have changed.
+       */
+      void RefreshEntities(void);
+
+      /**
+       * DetectChanges will give each IEntity that isn't static and whose
+       * properties no longer match its cache to UpdateEntity.
+       */
+      void DetectChanges(void);
+
+      /**
+       * RefreshFrames will move the texture coordinates of each IEntity
+       * provided to UpdateFrame since the last call to Draw, or give it to
+       * UpdateEntity if its new frame can't be shown that way.
+       */
+      void RefreshFrames(void);
+
+      /**
+       * RefreshEntity will rebuild the world vertices and bounds of theCache
+       * provided. The local vertices are only rebuilt if the Texture,
+       * rTextureRect, cColor or VertexArray properties have changed.
+       * @param[in] theCache to rebuild
+       */
+      void RefreshEntity(RenderCache& theCache);
+
+      /**
+       * JoinChunk will add theCache provided to the chunk with theKey
+       * provided, or just mark that chunk to be baked again if theCache
+       * already belongs to it.
+       * @param[in] theCache of the static IEntity
+       * @param[in] theKey of the chunk to join
+       */
+      void JoinChunk(RenderCache& theCache, const RenderChunkKey& theKey);
+
+      /**
+       * LeaveChunk will remove theCache provided from its chunk and drop the
+       * chunk once it has no members left.
+       * @param[in] theCache of the static IEntity
+       */
+      void LeaveChunk(RenderCache& theCache);
+
+      /**
+       * BakeChunks will copy the world vertices of every visible member of
+       * each chunk marked by JoinChunk or LeaveChunk into the chunk.
+       */
+      void BakeChunks(void);
+
+      /**
+       * AppendVertices will add theVertices provided to theResult as a list
+       * of triangles. Primitives that can't be turned into triangles are
+       * added as they are.
+       * @param[in] theVertices to add to theResult
+       * @param[out] theResult to add the vertices to
+       * @return the primitive type of the vertices added
+       */
+      static sf::PrimitiveType AppendVertices(const sf::VertexArray& theVertices,
+          std::vector<sf::Vertex>& theResult);
+
+      /**
+       * SortQueue will sort the render queue by its keys using a stable
+       * radix sort one byte at a time.
+       */
+      void SortQueue(void);
+
+      /**
+       * SelectView will find or add theViewID provided to the views used this
+       * frame and make it the view of the next item queued.
+       * @param[in] theViewID of the view to select
+       */
+      void SelectView(const std::string& theViewID);
+
+      /**
+       * SelectTexture will find or add theTexture provided to the Textures
+       * used this frame and make it the Texture of the next item queued.
+       * @param[in] theTexture to select
+       */
+      void SelectTexture(const sf::Texture* theTexture);
+
+      /**
+       * QueueItem will add theVertices provided to the render queue using the
+       * view and Texture last selected.
+       * @param[in] theVertices to draw
+       * @param[in] theCount of theVertices
+       * @param[in] thePrimitive type of theVertices
+       * @param[in] theLayer (z-order) of the item
+       * @param[in] theDepth of the item within its layer
+       */
+      void QueueItem(const sf::Vertex* theVertices, Uint32 theCount,
+          Uint32 thePrimitive, Uint32 theLayer, Uint32 theDepth);
+
+      /**
+       * FlushBatch will submit the current batch as a single draw call using
+       * the current batch Texture and then empty the batch.
+       */
+      void FlushBatch(void);
 
     private:
       std::map<std::string, sf::View> mViews;
+      /// The bounds of each IEntity sorted into a grid for each view
+      std::map<std::string, SpatialGrid> mGrids;
+      /// The cached vertices, view and depth of each IEntity added
+      std::map<const typeEntityID, RenderCache> mCaches;
+      /// The chunks each static IEntity is baked into
+      std::map<RenderChunkKey, RenderChunk> mChunks;
+      /// The members of the chunk being baked in depth order, reused by BakeChunks
+      std::vector<const RenderCache*> mBakeOrder;
+      /// The IEntity IDs whose bounds need to be updated before Draw
+      std::vector<typeEntityID> mDirty;
+      /// The new rTextureRect of each IEntity given to UpdateFrame before Draw
+      std::vector<std::pair<typeEntityID, sf::IntRect> > mFrames;
+      /// The IEntity classes found within the view being queued
+      std::vector<IEntity*> mVisible;
+      /// The visible items queued this frame
+      std::vector<RenderItem> mQueue;
+      /// The second buffer used while sorting mQueue
+      std::vector<RenderItem> mSortBuffer;
+      /// The views used this frame, indexed by RenderItem::View
+      std::vector<std::string> mViewIDs;
+      /// The visible rectangle of each view in mViewIDs
+      std::vector<sf::FloatRect> mViewRects;
+      /// The number of IEntity classes drawn in each view in mViewIDs
+      std::vector<Uint32> mViewCounts;
+      /// The Textures used this frame, indexed by RenderItem::Texture
+      std::vector<const sf::Texture*> mTextures;
+      /// The vertices of the current batch in sorted order, reused every frame
+      std::vector<sf::Vertex> mBatch;
+      /// The Texture used by every vertex in the current batch
+      const sf::Texture* mBatchTexture;
+      /// The ImageHandler whose TextureAtlas holds packed images
+      ImageHandler* mImageHandler;
+      /// The TextureAtlas generation the cached vertices were built with
+      Uint32 mAtlasGeneration;
+      /// The depth given to the next IEntity added
+      Uint32 mNextDepth;
+      /// The width and height of each chunk
+      float mChunkSize;
+      /// The index into mViewIDs of the last view used
+      Uint32 mViewIndex;
+      /// The index into mTextures of the last Texture used
+      Uint32 mTextureIndex;
+      /// True if every IEntity is compared against its cache before Draw
+      bool mDetectChanges;
+      /// The work done by the last call to Draw
+      RenderStats mStats;
   }; // class RenderSystem
 } // namespace GQE
 
@@ -101,6 +355,7 @@ namespace GQE
  * @ingroup Entity
  * The RenderSystem class is used to render each IEntity as a Sprite and
  * provides the following properties (which are used in other ISystem classes):
+ * - bStatic: A boolean indicating this IEntity rarely changes and can be baked
  * - bVisible: A boolean indicating this IEntity is currently visible
  * - fRotation: The float representing the current IEntity rotation
  * - rTextureRect: The sf::IntRect to use on the Texture provided
@@ -111,6 +366,55 @@ namespace GQE
  * The RenderSystem can be combined with the MovementSystem to cause each
  * IEntity to be moved around in the game.
  *
+ * The vertices of each IEntity are transformed on the CPU and cached along
+ * with their bounds, which are kept in a SpatialGrid for the view it uses.
+ * Each frame only the IEntity classes near each view are visited and only
+ * their cached vertices are read. The cache is only rebuilt for IEntity
+ * classes given to UpdateEntity, which the TransformSystem does for each
+ * IEntity it moves and the AnimationSystem does for each frame change (see
+ * Find). Anything else that changes a property used by the RenderSystem must
+ * call UpdateEntity as well, or SetDetectChanges can be used to compare each
+ * IEntity that isn't static against its cache before every Draw instead.
+ * Moving an IEntity only transforms its cached local
+ * vertices again, they are only rebuilt when its Texture, rTextureRect,
+ * cColor or VertexArray change. The AnimationSystem calls UpdateFrame
+ * instead for each IEntity whose frame changes which, as long as the new
+ * frame is the same size as the last one, only moves the texture coordinates
+ * of the cached vertices. When the image of the Texture property was
+ * packed into the TextureAtlas of the ImageHandler (see
+ * ImageHandler::GetAtlas) the cached vertices use the atlas page instead and
+ * rTextureRect is moved onto the image's rectangle of that page, so IEntity
+ * classes using different small images can share one draw call. Every
+ * IEntity is rebuilt before the next Draw once the TextureAtlas is built
+ * again, since its old pages are deleted (see TextureAtlas::GetGeneration).
+ *
+ * Rather than drawing each IEntity on its own, the RenderSystem adds the
+ * cached vertices of each visible IEntity to a render queue.
+ * Each queued item has a 64 bit key made of its view, its layer (the z-order
+ * it was added to the RenderSystem with), its Texture and its depth (the order
+ * it was added to the RenderSystem in). The queue is radix sorted by these keys and walked in
+ * order, changing the view or Texture only when the key says so and
+ * submitting each run of items that share a Texture and view with one draw
+ * call. Within a layer, IEntity classes that share a Texture are drawn
+ * together so IEntity classes that overlap should be given different layers.
+ * The number of items sorted, draw calls and state changes of each frame are
+ * provided by GetStats and to the StatManager along with the number of
+ * IEntity classes drawn in each view.
+ *
+ * An IEntity with its bStatic property set (floors, walls and other scenery)
+ * is baked into a chunk (512 by 512 world units by default, see SetChunkSize)
+ * along with every other static IEntity whose center is in the same chunk and
+ * that shares its view, layer and Texture. Each chunk keeps the world
+ * vertices of all of its members in depth order and is culled and queued as
+ * a single item, so a static IEntity costs nothing per frame. A chunk is only
+ * baked again when UpdateEntity is called for one of its members. Static
+ * IEntity classes drawn with points or lines are kept in the SpatialGrid.
+ *
+ * Each view change and draw call is issued to IApp::GetRenderTarget. While
+ * the IApp render thread is running they are recorded into its
+ * RenderCommandList and replayed while the next frame is being updated, and
+ * a NullRenderTarget can be used to count them without a window.
+ *
  * Copyright (c) 2010-2012 Jacob Dix
  * Permis
  sion is hereby granted, free of charge, to any person obtaining a copy
@@ -4,10 +4,15 @@
 * @file include/GQE/Entity/systems/TimerSystem.hpp
 * @author Jacob Dix
 * @date 20140413 - Initial Release
+* @date 20261018 - Schedule every timer on one hierarchical timing wheel
+* @date 20261018 - Provide an EventContext instead of building a PropertyManager for each event
+* @date 20261018 - Resolve the typeEventIndex of each timer when it is started
 */
 #ifndef TIMER_SYSTEM_HPP_INCLUDED
 #define TIMER_SYSTEM_HPP_INCLUDED
 
+#include <map>
+#include <vector>
 #include <GQE/Entity/interfaces/ISystem.hpp>
 namespace GQE
 {
@@ -15,13 +20,13 @@ namespace GQE
   {
   public:
     /**
-    * CollisionSystem Constructor.
+    * TimerSystem Constructor.
     * @param[in] theApp is the current GQE app.
     */
     TimerSystem(GQE::IApp& theApp);
 
     /**
-    * CollisionSystem Destructor.
+    * TimerSystem Destructor.
     */
     virtual ~TimerSystem();
 
@@ -32,6 +37,42 @@ namespace GQE
     */
     virtual void AddProperties(GQE::IEntity* theEntity);
 
+    /**
+    * AddTimer will start a timer for theEntity provided under theTimerID,
+    * replacing any timer theEntity already has under that ID.
+    * @param[in] theEntity the timer belongs to
+    * @param[in] theTimerID to identify the timer with
+    * @param[in] theTime to wait before the timer fires
+    * @param[in] theEvent to do when the timer fires
+    * @param[in] theRepeat indicates the timer starts over each time it fires
+    * @param[in] theAction to provide with theEvent
+    */
+    void AddTimer(GQE::IEntity* theEntity, const std::string theTimerID,
+        sf::Time theTime, const std::string theEvent, bool theRepeat = false,
+        Uint32 theAction = 0);
+
+    /**
+    * CancelTimer will stop the timer theEntity has under theTimerID.
+    * @param[in] theEntity the timer belongs to
+    * @param[in] theTimerID of the timer to stop
+    */
+    void CancelTimer(GQE::IEntity* theEntity, const std::string theTimerID);
+
+    /**
+    * HasTimer will return true if theEntity has a timer under theTimerID
+    * that hasn't fired yet or that repeats.
+    * @param[in] theEntity the timer belongs to
+    * @param[in] theTimerID of the timer to find
+    * @return true if the timer is running
+    */
+    bool HasTimer(GQE::IEntity* theEntity, const std::string theTimerID) const;
+
+    /**
+    * UpdateFixed will advance the timing wheel by one tick and fire only the
+    * timers that expire on that tick.
+    */
+    virtual void UpdateFixed(void);
+
   protected:
     /**
     * HandleInit is called to allow each derived ISystem to perform any
@@ -46,8 +87,88 @@ namespace GQE
     */
     virtual void HandleCleanup(GQE::IEntity* theEntity);
 
-    void EntityUpdateFixed(GQE::IEntity* theEntity);
+  private:
+    /// Number of levels in the timing wheel
+    static const Uint32 LEVELS = 4;
+    /// Number of slots in each level, each level's slot spans a whole lower level
+    static const Uint32 SLOTS = 64;
+    /// Number of bits of the tick used to pick a slot in each level
+    static const Uint32 SLOT_BITS = 6;
+    /// Slot holding the timers being fired, after the slots of every level
+    static const Uint32 FIRING = LEVELS * SLOTS;
+    /// Index used for the end of a list
+    static const Uint32 NONE = 0xFFFFFFFF;
+
+    /// A timer scheduled on the timing wheel
+    struct Timer
+    {
+      GQE::IEntity* Entity;
+      std::string TimerID;
+      /// Time, Event, Repeat and Action the timer was started with
+      TimerData Data;
+      /// The EventManager index of Data.Event
+      typeEventIndex Event;
+      /// Number of ticks between each time a repeating timer fires
+      Uint32 Interval;
+      /// Tick the timer fires on
+      Uint64 Expires;
+      /// Slot the timer is linked into, NONE while it is free
+      Uint32 Slot;
+      /// Previous and next timer in the same slot or free list
+      Uint32 Prev;
+      Uint32 Next;
+    };
+
+    /**
+    * Schedule will link the timer at theIndex into the slot of the level
+    * that covers its Expires tick.
+    * @param[in] theIndex of the timer to schedule
+    */
+    void Schedule(Uint32 theIndex);
+
+    /**
+    * Link will add the timer at theIndex to the front of theSlot.
+    * @param[in] theIndex of the timer to link
+    * @param[in] theSlot to link it into
+    */
+    void Link(Uint32 theIndex, Uint32 theSlot);
+
+    /**
+    * Unlink will remove the timer at theIndex from the slot it is in.
+    * @param[in] theIndex of the timer to unlink
+    */
+    void Unlink(Uint32 theIndex);
+
+    /**
+    * Release will unlink the timer at theIndex, forget its IDs and return it
+    * to the free list to be reused by the next AddTimer call.
+    * @param[in] theIndex of the timer to release
+    */
+    void Release(Uint32 theIndex);
+
+    /**
+    * Cascade will schedule each timer of theSlot of theLevel again now that
+    * they fall within a lower level.
+    * @param[in] theLevel to cascade from
+    * @param[in] theSlot of theLevel to cascade
+    * @return theSlot, which is 0 when the next level needs to cascade too
+    */
+    Uint32 Cascade(Uint32 theLevel, Uint32 theSlot);
 
+    // Variables
+    ///////////////////////////////////////////////////////////////////////////
+    /// Every timer, both scheduled and free
+    std::vector<Timer> mTimers;
+    /// The first timer of each slot of each level, followed by the firing list
+    std::vector<Uint32> mSlots;
+    /// The first free timer
+    Uint32 mFree;
+    /// The next tick the timing wheel will process
+    Uint64 mTick;
+    /// The timer scheduled for each IEntity and timer ID
+    std::map<std::pair<typeEntityID, std::string>, Uint32> mTimerIDs;
+    /// The TimerData of the timer being fired, reused for every event
+    TimerData mFired;
   };
 }
 #endif
@@ -57,8 +178,19 @@ namespace GQE
 * @ingroup Entity
 * The TimerSystem class is used to make timed events. The properties provided
 * by this System are as follows:
-* - Timers: A map of TimeContext structure.
-* This class is very simple. It Iterates through each entitys list of timers and checks to see if they are triggerd.
+* - Timers: A map of TimerData structures started when the IEntity is added.
+* Timers are also started and stopped by (IEntity, timer ID) using AddTimer
+* and CancelTimer. Every timer is kept in a single hierarchical timing wheel
+* of four levels of 64 slots, each tick being one fixed update. A timer is
+* linked into the slot of the lowest level that reaches its expiry tick and
+* moves down a level each time the level above it comes around, so starting
+* or stopping a timer is O(1) and each tick only visits the timers that
+* expire on it (plus an occasional cascade). Repeating timers are linked
+* back into the wheel after they fire and stopped timers are kept in a free
+* list for the next AddTimer call, so neither allocates any memory. Timers
+* longer than 64^4 ticks are moved back up the wheel until they expire.
+* When a timer fires its Event is done with an EventContext holding the
+* IEntity and a TimerData describing the timer, neither of which allocate.
 *
 * Copyright (c) 2010-2012 Jacob Dix
 * Permission is hereby granted, free of charge, to any person obtaining a copy
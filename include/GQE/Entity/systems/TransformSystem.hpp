@@ -10,6 +10,9 @@
  * @date 20120623 - Improved documentation and adjusted some properties
  * @date 20120630 - Improve ScreenWrap functionality using SpriteRect values
  * @date 20130622 - Renamed TransformSystem to TransformSystem. vPosition, fRotation and vScale now properties of TransformSystem.
+ * @date 20261018 - Tell the RenderSystem about each IEntity moved
+ * @date 20261018 - Note that telling the RenderSystem is optional by default
+ * @date 20261018 - Tell the RenderSystem of each IEntity moved without SetRenderSystem
  */
 
 #ifndef TRANSFORM_SYSTEM_HPP_INCLUDED
@@ -43,6 +46,13 @@ namespace GQE
        */
       virtual void AddProperties(IEntity* theEntity);
 
+      /**
+       * SetRenderSystem will set theRenderSystem to tell about each IEntity
+       * moved instead of the RenderSystem each IEntity was added to.
+       * @param[in] theRenderSystem to tell or NULL to use RenderSystem::Find
+       */
+      void SetRenderSystem(RenderSystem* theRenderSystem);
+
             /**
        * EntityHandleEvents is responsible handling SFML events per entity.
        * @param[in] theEntity to handle
@@ -94,6 +104,8 @@ namespace GQE
        */
       virtual void HandleScreenWrap(IEntity* theEntity, sf::Vector2f* thePosition);
     private:
+      /// The RenderSystem to tell about each IEntity moved
+      RenderSystem* mRenderSystem;
   }; // class TransformSystem
 } // namespace GQE
 
@@ -127,6 +139,9 @@ namespace GQE
  * vPosition += vVelocity * theElapsedTime
  * fRotationalVelocity += fRotationalAcceleration * theElapsedTime
  * fRotation += fRotationalVelocity * theElapsedTime
+ * Each IEntity whose vPosition or fRotation changes is given to
+ * RenderSystem::UpdateEntity of the RenderSystem it was added to (or the one
+ * given to SetRenderSystem) so its cached vertices and bounds are rebuilt.
  *
  * Copyright (c) 2010-2012 Jacob Dix
  * Permission is hereby granted, free of charge, to any person obtaining a copy
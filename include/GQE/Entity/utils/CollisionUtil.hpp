@@ -0,0 +1,216 @@
+/**
+ * Provides the separating axis theorem functions used by the ICollisionSystem
+ * class to test the cached world space geometry of two convex shapes. Each
+ * test is provided as a scalar version and SSE2/AVX2 versions which return the
+ * exact same minimum translation vector.
+ *
+ * @file include/GQE/Entity/utils/CollisionUtil.hpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Try the last separating axis first and return the new one
+ * @date 20261018 - Add circle and AABB collider tests
+ * @date 20261018 - Add ColliderRayCast for ray casts against any collider
+ * @date 20261018 - Add ColliderSweep for continuous collision tests
+ * @date 20261018 - Test each convex piece of concave colliders
+ * @date 20261018 - Point the polygon minimum translation toward the other shape
+ */
+#ifndef ENTITY_COLLISION_UTIL_HPP_INCLUDED
+#define ENTITY_COLLISION_UTIL_HPP_INCLUDED
+
+#include <GQE/Entity/Entity_types.hpp>
+
+// Determine which instruction sets this file is being compiled with
+#if defined(__AVX2__)
+#define GQE_COLLISION_AVX2
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GQE_COLLISION_SSE2
+#endif
+
+namespace GQE
+{
+  /// Number of points each CollisionCache is padded to for the SIMD tests
+  const Uint32 COLLISION_SIMD_WIDTH = 8;
+
+  /**
+   * SATIntersection will test the two cached shapes provided using the best
+   * instruction set available (AVX2, then SSE2, then scalar).
+   * @param[in] theMovingCache of the moving shape
+   * @param[in] theOtherCache of the other shape
+   * @param[out] theMinimumTranslation found if they intersect
+   * @return true if both shapes intersect, false otherwise
+   */
+  bool GQE_API SATIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
+
+  /**
+   * SATIntersection will test the two cached shapes provided like above but
+   * will first try theSeparatingAxis provided (if not zero) since the axis
+   * that separated two shapes on the last update usually still does.
+   * @param[in] theMovingCache of the moving shape
+   * @param[in] theOtherCache of the other shape
+   * @param[out] theMinimumTranslation found if they intersect
+   * @param[in,out] theSeparatingAxis to try first, set to the axis found if
+   *   they don't intersect or to zero if they do
+   * @return true if both shapes intersect, false otherwise
+   */
+  bool GQE_API SATIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis);
+
+  /**
+   * SATIntersectionScalar will test the two cached shapes provided without
+   * using any SIMD instructions.
+   * @param[in] theMovingCache of the moving shape
+   * @param[in] theOtherCache of the other shape
+   * @param[out] theMinimumTranslation found if they intersect
+   * @return true if both shapes intersect, false otherwise
+   */
+  bool GQE_API SATIntersectionScalar(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
+
+  /**
+   * SATIntersectionSSE2 will test the two cached shapes provided using SSE2
+   * instructions or the scalar version if SSE2 is not available.
+   * @param[in] theMovingCache of the moving shape
+   * @param[in] theOtherCache of the other shape
+   * @param[out] theMinimumTranslation found if they intersect
+   * @return true if both shapes intersect, false otherwise
+   */
+  bool GQE_API SATIntersectionSSE2(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
+
+  /**
+   * SATIntersectionAVX2 will test the two cached shapes provided using AVX2
+   * instructions or the SSE2 version if AVX2 is not available.
+   * @param[in] theMovingCache of the moving shape
+   * @param[in] theOtherCache of the other shape
+   * @param[out] theMinimumTranslation found if they intersect
+   * @return true if both shapes intersect, false otherwise
+   */
+  bool GQE_API SATIntersectionAVX2(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
+
+  /**
+   * ColliderIntersection will test the two cached colliders provided using
+   * the test best suited to their Type: SATIntersection for two polygons,
+   * CircleIntersection for two circles, AABBIntersection for two AABBs and
+   * a separating axis test using the exact projection of each circle or AABB
+   * for any other combination. The minimum translation found by every test
+   * points from the Center of the moving collider toward the other.
+   * A collider with Pieces is tested one convex piece at a time and returns
+   * the deepest minimum translation found.
+   * @param[in] theMovingCache of the moving collider
+   * @param[in] theOtherCache of the other collider
+   * @param[out] theMinimumTranslation found if they intersect
+   * @param[in,out] theSeparatingAxis to try first, set to the axis found if
+   *   they don't intersect or to zero if they do
+   * @return true if both colliders intersect, false otherwise
+   */
+  bool GQE_API ColliderIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis);
+
+  /**
+   * CircleIntersection will test two cached circle colliders using the
+   * distance between their centers.
+   * @param[in] theMovingCache of the moving circle
+   * @param[in] theOtherCache of the other circle
+   * @param[out] theMinimumTranslation found if they intersect
+   * @return true if both circles intersect, false otherwise
+   */
+  bool GQE_API CircleIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
+
+  /**
+   * AABBIntersection will test two cached axis aligned bounding box
+   * colliders using the overlap of their Bounds.
+   * @param[in] theMovingCache of the moving box
+   * @param[in] theOtherCache of the other box
+   * @param[out] theMinimumTranslation found if they intersect
+   * @return true if both boxes intersect, false otherwise
+   */
+  bool GQE_API AABBIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation);
+
+  /**
+   * ColliderRayCast will find where the ray starting at theOrigin provided
+   * heading in theDirection provided first enters the cached collider. A
+   * ray that starts inside the collider hits it at a distance of 0 with a
+   * zero normal. A collider with Pieces returns the nearest hit of any piece.
+   * @param[in] theCache of the collider to test
+   * @param[in] theOrigin of the ray
+   * @param[in] theDirection of the ray as a unit vector
+   * @param[in] theMaxDistance the ray can travel
+   * @param[out] theDistance along the ray of the hit
+   * @param[out] theNormal of the collider surface that was hit
+   * @return true if the ray hits the collider, false otherwise
+   */
+  bool GQE_API ColliderRayCast(const CollisionCache& theCache,
+      const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+      const float theMaxDistance, float& theDistance, sf::Vector2f& theNormal);
+
+  /**
+   * ColliderSweep will find the first time the moving collider provided
+   * touches the other collider while moving by theSweep provided. The moving
+   * collider starts theSweep behind where theMovingCache places it and the
+   * other collider doesn't move. The slab of each edge normal is swept to
+   * find the first contact, a circle is swept against the other collider
+   * grown by its radius with rounded corners. Colliders with Pieces return
+   * the first contact of any two pieces.
+   * @param[in] theMovingCache of the moving collider at the end of the sweep
+   * @param[in] theSweep distance moved by the moving collider
+   * @param[in] theOtherCache of the other collider
+   * @param[out] theTime of the first contact from 0 to 1
+   * @param[out] theNormal from the moving collider toward the other at the
+   *   first contact or zero if they already touched at the start
+   * @return true if the colliders touch during the sweep, false otherwise
+   */
+  bool GQE_API ColliderSweep(const CollisionCache& theMovingCache,
+      const sf::Vector2f& theSweep, const CollisionCache& theOtherCache,
+      float& theTime, sf::Vector2f& theNormal);
+
+  /**
+   * GetSATInstructionSet will return the name of the instruction set used by
+   * the SATIntersection function.
+   * @return "AVX2", "SSE2" or "Scalar"
+   */
+  const char* GQE_API GetSATInstructionSet(void);
+
+  /**
+   * PadCollisionCache will copy the Points of theCache provided into the
+   * PointsX and PointsY arrays padded to a multiple of COLLISION_SIMD_WIDTH
+   * by repeating the last point.
+   * @param[in] theCache to pad
+   */
+  void GQE_API PadCollisionCache(CollisionCache& theCache);
+} // namespace GQE
+
+#endif // ENTITY_COLLISION_UTIL_HPP_INCLUDED
+
+/**
+ * @ingroup Entity
+ * Provides the separating axis theorem functions used by the ICollisionSystem
+ * class. The projection of a shape onto an axis is the minimum and maximum of
+ * the dot products of each point with that axis, which maps directly onto SIMD
+ * lanes when the points are stored as separate x and y arrays.
+ *
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
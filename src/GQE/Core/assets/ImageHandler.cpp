@@ -5,6 +5,7 @@
  * @file src/GQE/Core/assets/ImageHandler.cpp
  * @author Ryan Lindeman
  * @date 20120428 - Initial Release
+ * @date 20261018 - Add TextureAtlas used to pack small images into shared pages
  */
  
 #include <GQE/Core/assets/ImageHandler.hpp>
@@ -27,6 +28,29 @@ namespace GQE
     ILOG() << "ImageHandler::dtor()" << std::endl;
   }
 
+#if (SFML_VERSION_MAJOR < 2)
+  // TextureAtlas requires SFML 2
+#else
+  TextureAtlas& ImageHandler::GetAtlas(void)
+  {
+    return mAtlas;
+  }
+
+  bool ImageHandler::GetAtlasRegion(const sf::Texture* theTexture,
+      const sf::Texture*& thePage, sf::IntRect& theRect) const
+  {
+    std::map<const sf::Texture*, typeAssetID>::const_iterator anIter =
+      mTextureIDs.find(theTexture);
+    return anIter != mTextureIDs.end() && mAtlas.GetRegion(anIter->second, thePage, theRect);
+  }
+
+  void ImageHandler::ReleaseAsset(const typeAssetID theAssetID, sf::Texture* theAsset)
+  {
+    mTextureIDs.erase(theAsset);
+    TAssetHandler<sf::Texture>::ReleaseAsset(theAssetID, theAsset);
+  }
+#endif
+
 #if (SFML_VERSION_MAJOR < 2)
   bool ImageHandler::LoadFromFile(const typeAssetID theAssetID, sf::Image& theAsset)
 #else
@@ -50,6 +74,12 @@ namespace GQE
       theAsset.SetSmooth(false);
 #else
       anResult = theAsset.loadFromFile(anFilename);
+
+      // Remember which asset this is in case its image was packed
+      if(anResult)
+      {
+        mTextureIDs[&theAsset] = theAssetID;
+      }
 #endif
     }
     else
@@ -6,36 +6,116 @@
  * @file src/GQE/Core/classes/EventManager.cpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Intern each Event ID as a typeEventIndex and dispatch through a vector
+ * @date 20261018 - Add multiple handlers per event and queued events delivered in batches
+ * @date 20261018 - Check the context type of each queued batch
  */
 
 #include <GQE/Core/classes/EventManager.hpp>
 
 namespace GQE
 {
+  const typeEventIndex EventManager::NO_EVENT;
+
   EventManager::EventManager()
   {
+    // The empty Event ID is always NO_EVENT
+    mNames.push_back(typeEventID());
+    mEvents.push_back(std::vector<IEvent*>());
   }
 
   EventManager::~EventManager()
   {
     // Make sure to remove all registered properties on desstruction
-    std::map<const typeEventID, IEvent*>::iterator anEventIter;
-    for(anEventIter = mList.begin();
-        anEventIter != mList.end();
-        ++anEventIter)
+    std::vector<std::vector<IEvent*> >::iterator anListIter;
+    for(anListIter = mEvents.begin();
+        anListIter != mEvents.end();
+        ++anListIter)
     {
-      IEvent* anEvent = (anEventIter->second);
-      delete anEvent;
-      anEvent = NULL;
+      std::vector<IEvent*>::iterator anEventIter;
+      for(anEventIter = anListIter->begin();
+          anEventIter != anListIter->end();
+          ++anEventIter)
+      {
+        IEvent* anEvent = (*anEventIter);
+        delete anEvent;
+        anEvent = NULL;
+      }
     }
+    mEvents.clear();
+
+    // Remove every queue and any contexts still waiting to be delivered
+    for(Uint32 anPhase = 0; anPhase < EventPhaseCount; ++anPhase)
+    {
+      std::vector<IEventQueue*>::iterator anQueueIter;
+      for(anQueueIter = mQueues[anPhase].begin();
+          anQueueIter != mQueues[anPhase].end();
+          ++anQueueIter)
+      {
+        IEventQueue* anQueue = (*anQueueIter);
+        delete anQueue;
+        anQueue = NULL;
+      }
+      mQueues[anPhase].clear();
+      mPending[anPhase].clear();
+      mFlushing[anPhase].clear();
+    }
+    mNames.clear();
+    mIndexes.clear();
+  }
+
+  typeEventIndex EventManager::GetIndex(const typeEventID& theEventID)
+  {
+    typeEventIndex anResult = NO_EVENT;
+
+    if(!theEventID.empty())
+    {
+      std::map<const typeEventID, typeEventIndex>::const_iterator anIter =
+        mIndexes.find(theEventID);
+      if(anIter != mIndexes.end())
+      {
+        anResult = anIter->second;
+      }
+      else
+      {
+        // Intern theEventID as the next index
+        anResult = (typeEventIndex)mNames.size();
+        mIndexes.insert(std::pair<const typeEventID, typeEventIndex>(theEventID, anResult));
+        mNames.push_back(theEventID);
+        mEvents.push_back(std::vector<IEvent*>());
+      }
+    }
+
+    // Return the index of theEventID or NO_EVENT if it was empty
+    return anResult;
+  }
+
+  typeEventIndex EventManager::FindIndex(const typeEventID& theEventID) const
+  {
+    typeEventIndex anResult = NO_EVENT;
+
+    std::map<const typeEventID, typeEventIndex>::const_iterator anIter =
+      mIndexes.find(theEventID);
+    if(anIter != mIndexes.end())
+    {
+      anResult = anIter->second;
+    }
+
+    // Return the index of theEventID or NO_EVENT if it was never interned
+    return anResult;
+  }
+
+  const typeEventID& EventManager::GetName(const typeEventIndex theEventIndex) const
+  {
+    return theEventIndex < mNames.size() ? mNames[theEventIndex] : mNames[NO_EVENT];
   }
 
   bool EventManager::HasID(const typeEventID theEventID) const
   {
     bool anResult = false;
 
-    // See if theEventID was found in our list of properties
-    anResult = (mList.find(theEventID) != mList.end());
+    // See if theEventID was interned and has an IEvent
+    anResult = !mEvents[FindIndex(theEventID)].empty();
 
     // Return true if theEventID was found above, false otherwise
     return anResult;
@@ -43,43 +123,91 @@ namespace GQE
 
   void EventManager::DoEvents(void* theContext)
   {
-    std::map<const typeEventID, IEvent*>::const_iterator anIter =
-      mList.begin();
-    while(anIter != mList.end())
+    // Events might add other events, so check the size each time
+    for(size_t anIndex = 0; anIndex < mEvents.size(); ++anIndex)
     {
-      // Get the event to execute
-      IEvent* anEvent = anIter->second;
-
-      // Iterate to the next event
-      anIter++;
+      for(size_t anHandler = 0; anHandler < mEvents[anIndex].size(); ++anHandler)
+      {
+        // Get the event to execute
+        IEvent* anEvent = mEvents[anIndex][anHandler];
 
-      // Now call DoEvent for this event with theContext provided
-      anEvent->DoEvent(theContext);
+        // Now call DoEvent for this event with theContext provided
+        anEvent->DoEvent(theContext);
+      }
+    }
+  }
+  void EventManager::DoEvent(const typeEventID& theEventID, void* theContext)
+  {
+    DoEvent(FindIndex(theEventID), theContext);
+  }
+  void EventManager::DoEvent(const typeEventIndex theEventIndex, void* theContext)
+  {
+    if(theEventIndex < mEvents.size())
+    {
+      // IEvent classes subscribed by a handler start with the next event
+      size_t anCount = mEvents[theEventIndex].size();
+      for(size_t anHandler = 0; anHandler < anCount; ++anHandler)
+      {
+        // Get the event to execute
+        IEvent* anEvent = mEvents[theEventIndex][anHandler];
+        // Now call DoEvent for this event with theContext provided
+        anEvent->DoEvent(theContext);
+      }
     }
   }
-  void EventManager::DoEvent(typeEventID theEventID,void* theContext)
+
+  void EventManager::Flush(const EventPhase thePhase)
   {
-    std::map<const typeEventID, IEvent*>::const_iterator anIter =
-      mList.find(theEventID);
-    if (anIter != mList.end())
+    // Ignore Flush calls made by the handlers of this phase
+    if(thePhase >= EventPhaseCount || !mFlushing[thePhase].empty())
     {
-      // Get the event to execute
-      IEvent* anEvent = anIter->second;
-      // Now call DoEvent for this event with theContext provided
-      anEvent->DoEvent(theContext);
+      return;
     }
+
+    // Events queued from here on wait for the next Flush of thePhase
+    std::vector<typeEventIndex>& anFlushing = mFlushing[thePhase];
+    anFlushing.swap(mPending[thePhase]);
+    for(size_t anItem = 0; anItem < anFlushing.size(); ++anItem)
+    {
+      typeEventIndex anIndex = anFlushing[anItem];
+      IEventQueue* anQueue = mQueues[thePhase][anIndex];
+      Uint32 anCount = anQueue->Swap();
+      void* anContexts = anQueue->GetDelivered();
+      size_t anSize = anQueue->GetSize();
+      const std::type_info& anType = anQueue->GetContextType();
+
+      // Hand the whole batch to each IEvent subscribed to this event that
+      // expects contexts of this type
+      size_t anHandlers = mEvents[anIndex].size();
+      for(size_t anHandler = 0; anHandler < anHandlers; ++anHandler)
+      {
+        IEvent* anEvent = mEvents[anIndex][anHandler];
+        const std::type_info* anExpected = anEvent->GetContextType();
+        if(anExpected != NULL && *anExpected != anType)
+        {
+          ELOG() << "EventManager::Flush(" << mNames[anIndex] << ") handler expects "
+            << anExpected->name() << " but " << anType.name() << " was queued!" << std::endl;
+          continue;
+        }
+        anEvent->DoBatch(anContexts, anCount, anSize, anType);
+      }
+    }
+    anFlushing.clear();
   }
 
   IEvent* EventManager::Get(const typeEventID theEventID)
+  {
+    // Return the event pointer or NULL otherwise if no event was found
+    return Get(FindIndex(theEventID));
+  }
+
+  IEvent* EventManager::Get(const typeEventIndex theEventIndex)
   {
     IEvent* anResult = NULL;
 
-    // Create an iterator to find the IEvent class
-    std::map<const typeEventID, IEvent*>::const_iterator anIter;
-    anIter = mList.find(theEventID);
-    if(anIter != mList.end())
+    if(theEventIndex < mEvents.size() && !mEvents[theEventIndex].empty())
     {
-      anResult = anIter->second;
+      anResult = mEvents[theEventIndex].front();
     }
 
     // Return the event pointer or NULL otherwise if no event was found
@@ -90,9 +218,10 @@ namespace GQE
   {
     if(theEvent != NULL)
     {
-      if(mList.find(theEvent->GetID()) == mList.end())
+      typeEventIndex anIndex = GetIndex(theEvent->GetID());
+      if(anIndex != NO_EVENT && mEvents[anIndex].empty())
       {
-        mList.insert(std::pair<const typeEventID, IEvent*>(theEvent->GetID(), theEvent));
+        mEvents[anIndex].push_back(theEvent);
       }
       else
       {
@@ -104,6 +233,27 @@ namespace GQE
       ELOG() << "EventManager::Add() null IEvent pointer provided!" << std::endl;
     }
   }
+
+  void EventManager::Subscribe(IEvent* theEvent)
+  {
+    if(theEvent != NULL)
+    {
+      typeEventIndex anIndex = GetIndex(theEvent->GetID());
+      if(anIndex != NO_EVENT)
+      {
+        mEvents[anIndex].push_back(theEvent);
+      }
+      else
+      {
+        ELOG() << "EventManager::Subscribe() empty Event ID provided!" << std::endl;
+        delete theEvent;
+      }
+    }
+    else
+    {
+      ELOG() << "EventManager::Subscribe() null IEvent pointer provided!" << std::endl;
+    }
+  }
 } // namespace GQE
 
 /**
@@ -0,0 +1,105 @@
+/**
+ * Provides the NullRenderTarget class in the GQE namespace which counts each
+ * draw call instead of drawing anything.
+ *
+ * @file src/GQE/Core/classes/NullRenderTarget.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#include <GQE/Core/classes/NullRenderTarget.hpp>
+
+namespace GQE
+{
+  NullRenderTarget::NullRenderTarget() :
+    IRenderTarget(),
+    mState(NULL),
+    mDrawCalls(0),
+    mVertices(0),
+    mStateChanges(0),
+    mFirst(true)
+  {
+  }
+
+  NullRenderTarget::~NullRenderTarget()
+  {
+  }
+
+  void NullRenderTarget::Reset(void)
+  {
+    mState = NULL;
+    mDrawCalls = 0;
+    mVertices = 0;
+    mStateChanges = 0;
+    mFirst = true;
+  }
+
+  Uint32 NullRenderTarget::GetDrawCalls(void) const
+  {
+    return mDrawCalls;
+  }
+
+  Uint32 NullRenderTarget::GetVertexCount(void) const
+  {
+    return mVertices;
+  }
+
+  Uint32 NullRenderTarget::GetStateChanges(void) const
+  {
+    return mStateChanges;
+  }
+
+  void NullRenderTarget::SetView(const sf::View& theView)
+  {
+    mStateChanges++;
+  }
+
+  void NullRenderTarget::Draw(const sf::Vertex* theVertices, Uint32 theCount,
+      sf::PrimitiveType thePrimitive, const sf::Texture* theTexture)
+  {
+    CountDraw(theCount, theTexture);
+  }
+
+  void NullRenderTarget::Draw(const sf::Sprite& theSprite)
+  {
+    CountDraw(4, theSprite.getTexture());
+  }
+
+  void NullRenderTarget::Draw(const sf::Text& theText)
+  {
+    // The glyph texture of the font isn't known, so each text is its own state
+    CountDraw((Uint32)theText.getString().getSize() * 4, &theText);
+  }
+
+  void NullRenderTarget::CountDraw(Uint32 theCount, const void* theState)
+  {
+    if(mFirst || theState != mState)
+    {
+      mState = theState;
+      mStateChanges++;
+      mFirst = false;
+    }
+    mDrawCalls++;
+    mVertices += theCount;
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
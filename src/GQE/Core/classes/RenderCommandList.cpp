@@ -0,0 +1,170 @@
+/**
+ * Provides the RenderCommandList class in the GQE namespace which records the
+ * draw calls of a frame so they can be replayed later, typically by the
+ * RenderThread class.
+ *
+ * @file src/GQE/Core/classes/RenderCommandList.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Derive from the new IRenderTarget interface
+ */
+#include <GQE/Core/classes/RenderCommandList.hpp>
+
+namespace GQE
+{
+  RenderCommandList::RenderCommandList() :
+    IRenderTarget(),
+    mViewCount(0),
+    mSpriteCount(0),
+    mTextCount(0)
+  {
+  }
+
+  RenderCommandList::~RenderCommandList()
+  {
+  }
+
+  void RenderCommandList::Clear(void)
+  {
+    // Views, sprites and texts are overwritten in place by the next frame
+    mCommands.clear();
+    mVertices.clear();
+    mViewCount = 0;
+    mSpriteCount = 0;
+    mTextCount = 0;
+  }
+
+  Uint32 RenderCommandList::GetCommandCount(void) const
+  {
+    return (Uint32)mCommands.size();
+  }
+
+  void RenderCommandList::SetView(const sf::View& theView)
+  {
+    if(mViewCount < mViews.size())
+    {
+      mViews[mViewCount] = theView;
+    }
+    else
+    {
+      mViews.push_back(theView);
+    }
+
+    Command anCommand;
+    anCommand.Type = CommandView;
+    anCommand.Index = mViewCount++;
+    anCommand.Count = 0;
+    anCommand.Primitive = sf::Points;
+    anCommand.Texture = NULL;
+    mCommands.push_back(anCommand);
+  }
+
+  void RenderCommandList::Draw(const sf::Vertex* theVertices, Uint32 theCount,
+      sf::PrimitiveType thePrimitive, const sf::Texture* theTexture)
+  {
+    if(NULL == theVertices || 0 == theCount)
+    {
+      return;
+    }
+
+    Command anCommand;
+    anCommand.Type = CommandVertices;
+    anCommand.Index = (Uint32)mVertices.size();
+    anCommand.Count = theCount;
+    anCommand.Primitive = thePrimitive;
+    anCommand.Texture = theTexture;
+    mCommands.push_back(anCommand);
+    mVertices.insert(mVertices.end(), theVertices, theVertices + theCount);
+  }
+
+  void RenderCommandList::Draw(const sf::Sprite& theSprite)
+  {
+    if(mSpriteCount < mSprites.size())
+    {
+      mSprites[mSpriteCount] = theSprite;
+    }
+    else
+    {
+      mSprites.push_back(theSprite);
+    }
+
+    Command anCommand;
+    anCommand.Type = CommandSprite;
+    anCommand.Index = mSpriteCount++;
+    anCommand.Count = 0;
+    anCommand.Primitive = sf::Points;
+    anCommand.Texture = NULL;
+    mCommands.push_back(anCommand);
+  }
+
+  void RenderCommandList::Draw(const sf::Text& theText)
+  {
+    if(mTextCount < mTexts.size())
+    {
+      mTexts[mTextCount] = theText;
+    }
+    else
+    {
+      mTexts.push_back(theText);
+    }
+
+    Command anCommand;
+    anCommand.Type = CommandText;
+    anCommand.Index = mTextCount++;
+    anCommand.Count = 0;
+    anCommand.Primitive = sf::Points;
+    anCommand.Texture = NULL;
+    mCommands.push_back(anCommand);
+  }
+
+  void RenderCommandList::Replay(sf::RenderTarget& theTarget) const
+  {
+    std::vector<Command>::const_iterator anCommand;
+    for(anCommand = mCommands.begin(); anCommand != mCommands.end(); ++anCommand)
+    {
+      switch(anCommand->Type)
+      {
+        case CommandView:
+          theTarget.setView(mViews[anCommand->Index]);
+          break;
+        case CommandVertices:
+          {
+            sf::RenderStates anRenderStates;
+            anRenderStates.texture = anCommand->Texture;
+            theTarget.draw(&mVertices[anCommand->Index], anCommand->Count,
+                anCommand->Primitive, anRenderStates);
+          }
+          break;
+        case CommandSprite:
+          theTarget.draw(mSprites[anCommand->Index]);
+          break;
+        case CommandText:
+          theTarget.draw(mTexts[anCommand->Index]);
+          break;
+        default:
+          break;
+      } // switch(anCommand->Type)
+    } // for(anCommand = mCommands.begin(); anCommand != mCommands.end(); ++anCommand)
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,145 @@
+/**
+ * Provides the RenderThread class in the GQE namespace which owns the render
+ * window context and replays each frame recorded by the game loop in its own
+ * thread.
+ *
+ * @file src/GQE/Core/classes/RenderThread.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#include <GQE/Core/classes/RenderThread.hpp>
+#include <GQE/Core/loggers/Log_macros.hpp>
+
+namespace GQE
+{
+  RenderThread::RenderThread() :
+    IProcess(),
+    mWindow(NULL),
+    mMutex(),
+    mRecord(0),
+    mPending(false)
+  {
+  }
+
+  RenderThread::~RenderThread()
+  {
+    if(mRunning)
+    {
+      Stop();
+    }
+  }
+
+  void RenderThread::SetWindow(sf::RenderWindow& theWindow)
+  {
+    mWindow = &theWindow;
+  }
+
+  RenderCommandList& RenderThread::GetCommandList(void)
+  {
+    // Only the game loop thread changes mRecord so no lock is needed here
+    return mLists[mRecord];
+  }
+
+  void RenderThread::Submit(void)
+  {
+    if(!mRunning)
+    {
+      WLOG() << "RenderThread::Submit() render thread is not running" << std::endl;
+      mLists[mRecord].Clear();
+      return;
+    }
+
+    // Wait for the previous frame to be displayed before handing over this one
+    bool anSubmitted = false;
+    while(!anSubmitted)
+    {
+      {
+        sf::Lock anLock(mMutex);
+        if(!mPending)
+        {
+          mRecord = 1 - mRecord;
+          mPending = true;
+          anSubmitted = true;
+        }
+      }
+      if(!anSubmitted)
+      {
+        sf::sleep(sf::microseconds(100));
+      }
+    }
+
+    // The render thread is done with this list, record the next frame into it
+    mLists[mRecord].Clear();
+  }
+
+  bool RenderThread::IsReady(void)
+  {
+    return NULL != mWindow;
+  }
+
+  void RenderThread::Process(void)
+  {
+    // Take over the window context given up by the game loop thread
+    mWindow->setActive(true);
+
+    while(mRunning)
+    {
+      if(!ReplayFrame())
+      {
+        sf::sleep(sf::microseconds(100));
+      }
+    }
+
+    // Display the last frame submitted before Stop was called
+    ReplayFrame();
+
+    // Give the window context back to the game loop thread
+    mWindow->setActive(false);
+  }
+
+  bool RenderThread::ReplayFrame(void)
+  {
+    RenderCommandList* anList = NULL;
+    {
+      sf::Lock anLock(mMutex);
+      if(mPending)
+      {
+        anList = &mLists[1 - mRecord];
+      }
+    }
+    if(NULL == anList)
+    {
+      return false;
+    }
+
+    anList->Replay(*mWindow);
+    mWindow->display();
+
+    {
+      sf::Lock anLock(mMutex);
+      mPending = false;
+    }
+    return true;
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
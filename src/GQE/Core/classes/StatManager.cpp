@@ -21,6 +21,9 @@
  * @date 20120609 - Whitespace changes
  * @date 20120616 - Add std::nothrow to new commands for mFPS and mUPS
  * @date 20121107 - Padding StatManager class
+ * @date 20261018 - Added SetStat and GetStat for custom statistics
+ * @date 20261018 - Record statistics into the render thread command list
+ * @date 20261018 - Draw statistics to IApp::GetRenderTarget
  */
 
 #include <assert.h>
@@ -41,7 +44,9 @@ namespace GQE
     mDefaultFont(),
     mFPS(NULL),
     mUpdateClock(),
-    mUPS(NULL)
+    mUPS(NULL),
+    mStats(),
+    mStatsText(NULL)
   {
     ILOGM("StatManager::ctor()");
 #if SFML_VERSION_MAJOR < 2
@@ -80,6 +85,10 @@ namespace GQE
     mUPS = new(std::nothrow) sf::String("", mDefaultFont, 30.0F);
     mUPS->SetColor(sf::Color(0,255,0,128));
     mUPS->SetPosition(0,30);
+
+    mStatsText = new(std::nothrow) sf::String("", mDefaultFont, 20.0F);
+    mStatsText->SetColor(sf::Color(0,255,0,128));
+    mStatsText->SetPosition(0,60);
 #else
     mFrameClock.restart();
     mUpdateClock.restart();
@@ -92,6 +101,10 @@ namespace GQE
     mUPS = new(std::nothrow) sf::Text("", mDefaultFont, 30);
     mUPS->setColor(sf::Color(0,255,0,128));
     mUPS->setPosition(0,30);
+
+    mStatsText = new(std::nothrow) sf::Text("", mDefaultFont, 20);
+    mStatsText->setColor(sf::Color(0,255,0,128));
+    mStatsText->setPosition(0,60);
 #endif
   }
 
@@ -106,6 +119,10 @@ namespace GQE
     // Delete our UPS string
     delete mUPS;
     mUPS = NULL;
+
+    // Delete our custom statistics string
+    delete mStatsText;
+    mStatsText = NULL;
   }
 
   bool StatManager::IsShowing(void) const
@@ -128,6 +145,21 @@ namespace GQE
     return mFrames;
   }
 
+  void StatManager::SetStat(const std::string& theName, Uint32 theValue)
+  {
+    mStats[theName] = theValue;
+  }
+
+  Uint32 StatManager::GetStat(const std::string& theName) const
+  {
+    std::map<std::string, Uint32>::const_iterator anIter = mStats.find(theName);
+    if(anIter != mStats.end())
+    {
+      return anIter->second;
+    }
+    return 0;
+  }
+
   void StatManager::RegisterApp(IApp* theApp)
   {
     // Check that our pointer is good
@@ -200,6 +232,19 @@ namespace GQE
       mFPS->setString(frames.str());
 #endif
 
+      // Custom statistics string stream
+      std::ostringstream stats;
+      std::map<std::string, Uint32>::const_iterator anIter;
+      for(anIter = mStats.begin(); anIter != mStats.end(); ++anIter)
+      {
+        stats << anIter->first << ": " << anIter->second << std::endl;
+      }
+#if (SFML_VERSION_MAJOR < 2)
+      mStatsText->SetText(stats.str());
+#else
+      mStatsText->setString(stats.str());
+#endif
+
       // Reset our Frames clock and frame counter
       mFrames = 0;
 #if (SFML_VERSION_MAJOR < 2)
@@ -218,12 +263,20 @@ namespace GQE
 
       // Draw the Updates Per Second debug value on the screen
       mApp->mWindow.Draw(*mUPS);
+
+      // Draw the custom statistics on the screen
+      mApp->mWindow.Draw(*mStatsText);
 #else
+      IRenderTarget& anTarget = mApp->GetRenderTarget();
+
       // Draw the Frames Per Second debug value on the screen
-      mApp->mWindow.draw(*mFPS);
+      anTarget.Draw(*mFPS);
 
       // Draw the Updates Per Second debug value on the screen
-      mApp->mWindow.draw(*mUPS);
+      anTarget.Draw(*mUPS);
+
+      // Draw the custom statistics on the screen
+      anTarget.Draw(*mStatsText);
 #endif
     }
   }
@@ -0,0 +1,470 @@
+/**
+ * Provides the TextureAtlas class in the GQE namespace which packs many small
+ * images into a few shared page textures.
+ *
+ * @file src/GQE/Core/classes/TextureAtlas.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add GetGeneration and check the size and time of each cached image
+ */
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <GQE/Core/classes/TextureAtlas.hpp>
+#include <GQE/Core/loggers/Log_macros.hpp>
+
+namespace GQE
+{
+  /// Returns true if the size and modification time of theFilename were found
+  static bool GetFileInfo(const std::string& theFilename, Uint64& theSize,
+      Uint64& theModified)
+  {
+    struct stat anInfo;
+    if(stat(theFilename.c_str(), &anInfo) != 0)
+    {
+      return false;
+    }
+    theSize = (Uint64)anInfo.st_size;
+    theModified = (Uint64)anInfo.st_mtime;
+    return true;
+  }
+
+  TextureAtlas::TextureAtlas(Uint32 theMaxImageSize, Uint32 thePageSize) :
+    mMaxImageSize(theMaxImageSize),
+    mPageSize(thePageSize),
+    mGeneration(0)
+  {
+  }
+
+  TextureAtlas::~TextureAtlas()
+  {
+    Clear();
+  }
+
+  void TextureAtlas::SetSizes(Uint32 theMaxImageSize, Uint32 thePageSize)
+  {
+    mMaxImageSize = theMaxImageSize;
+    mPageSize = thePageSize;
+  }
+
+  void TextureAtlas::AddImage(const typeAssetID theAssetID, const std::string theFilename)
+  {
+    mFilenames[theAssetID] = theFilename.length() > 0 ? theFilename : theAssetID;
+  }
+
+  bool TextureAtlas::Build(const std::string theCacheFilename)
+  {
+    // Drop the pages of any previous Build
+    DropPages();
+
+    // Only pack the images again if the cache doesn't match them
+    std::vector<sf::Image> anPages;
+    bool anCached = theCacheFilename.length() > 0 && ReadCache(theCacheFilename, anPages);
+    if(!anCached)
+    {
+      mRegions.clear();
+      anPages.clear();
+      if(Pack(anPages) && theCacheFilename.length() > 0)
+      {
+        WriteCache(theCacheFilename, anPages);
+      }
+    }
+
+    bool anResult = true;
+    for(Uint32 anIndex = 0; anIndex < anPages.size() && anResult; anIndex++)
+    {
+      sf::Texture* anPage = new(std::nothrow) sf::Texture();
+      if(NULL != anPage && anPage->loadFromImage(anPages[anIndex]))
+      {
+        mPages.push_back(anPage);
+      }
+      else
+      {
+        ELOG() << "TextureAtlas::Build() unable to create page " << anIndex << std::endl;
+        delete anPage;
+        anResult = false;
+      }
+    }
+
+    // Without every page the regions can't be used at all
+    if(!anResult)
+    {
+      DropPages();
+    }
+    else
+    {
+      ILOG() << "TextureAtlas::Build() " << mRegions.size() << " images on "
+        << mPages.size() << " pages" << (anCached ? " from cache" : "") << std::endl;
+    }
+
+    // Return anResult of true if every page was created
+    return anResult;
+  }
+
+  void TextureAtlas::Clear(void)
+  {
+    DropPages();
+    mFilenames.clear();
+    mImageSizes.clear();
+  }
+
+  bool TextureAtlas::GetRegion(const typeAssetID theAssetID, const sf::Texture*& thePage,
+      sf::IntRect& theRect) const
+  {
+    std::map<const typeAssetID, Region>::const_iterator anIter = mRegions.find(theAssetID);
+    if(anIter == mRegions.end() || anIter->second.Page >= mPages.size())
+    {
+      return false;
+    }
+    thePage = mPages[anIter->second.Page];
+    theRect = anIter->second.Rect;
+    return true;
+  }
+
+  Uint32 TextureAtlas::GetPageCount(void) const
+  {
+    return (Uint32)mPages.size();
+  }
+
+  Uint32 TextureAtlas::GetGeneration(void) const
+  {
+    return mGeneration;
+  }
+
+  bool TextureAtlas::Pack(std::vector<sf::Image>& thePages)
+  {
+    bool anResult = true;
+
+    // Load every image first so they can be packed tallest first
+    mImageSizes.clear();
+    std::map<const typeAssetID, sf::Image> anImages;
+    std::vector<std::pair<Uint32, typeAssetID> > anOrder;
+    std::map<const typeAssetID, std::string>::const_iterator anFilename;
+    for(anFilename = mFilenames.begin(); anFilename != mFilenames.end(); ++anFilename)
+    {
+      sf::Image& anImage = anImages[anFilename->first];
+      if(!anImage.loadFromFile(anFilename->second))
+      {
+        ELOG() << "TextureAtlas::Pack() unable to load " << anFilename->second << std::endl;
+        anResult = false;
+        continue;
+      }
+
+      // Leave images that are too large in their own texture
+      sf::Vector2u anSize = anImage.getSize();
+      mImageSizes[anFilename->first] = anSize;
+      if(anSize.x == 0 || anSize.y == 0 ||
+          anSize.x > mMaxImageSize || anSize.y > mMaxImageSize ||
+          anSize.x >= mPageSize || anSize.y >= mPageSize)
+      {
+        continue;
+      }
+      anOrder.push_back(std::make_pair(anSize.y, anFilename->first));
+    }
+    std::sort(anOrder.rbegin(), anOrder.rend());
+
+    // Each image also takes a one pixel gap to its right and bottom so
+    // smoothing never picks up the image next to it
+    std::vector<std::vector<Segment> > anSkylines;
+    std::vector<std::pair<Uint32, typeAssetID> >::const_iterator anItem;
+    for(anItem = anOrder.begin(); anItem != anOrder.end(); ++anItem)
+    {
+      const sf::Image& anImage = anImages[anItem->second];
+      Uint32 anWidth = anImage.getSize().x;
+      Uint32 anHeight = anImage.getSize().y;
+      Uint32 anX = 0;
+      Uint32 anY = 0;
+      Uint32 anPage = 0;
+      while(anPage < anSkylines.size() &&
+          !Place(anSkylines[anPage], anWidth + 1, anHeight + 1, anX, anY))
+      {
+        anPage++;
+      }
+
+      // Start a new page if none of the others had room
+      if(anPage == anSkylines.size())
+      {
+        Segment anGround;
+        anGround.X = 0;
+        anGround.Y = 0;
+        anGround.Width = mPageSize;
+        anSkylines.push_back(std::vector<Segment>(1, anGround));
+        thePages.push_back(sf::Image());
+        thePages.back().create(mPageSize, mPageSize, sf::Color(0, 0, 0, 0));
+        Place(anSkylines.back(), anWidth + 1, anHeight + 1, anX, anY);
+      }
+
+      thePages[anPage].copy(anImage, anX, anY);
+      Region anRegion;
+      anRegion.Page = anPage;
+      anRegion.Rect = sf::IntRect(anX, anY, anWidth, anHeight);
+      mRegions[anItem->second] = anRegion;
+    }
+
+    // Return anResult of true if every image was loaded
+    return anResult;
+  }
+
+  bool TextureAtlas::Place(std::vector<Segment>& theSkyline, Uint32 theWidth,
+      Uint32 theHeight, Uint32& theX, Uint32& theY) const
+  {
+    // Find the segment the rectangle can rest on lowest, the narrowest
+    // segment wins a tie since it wastes the least space
+    size_t anBest = theSkyline.size();
+    Uint32 anBestY = 0;
+    for(size_t anIndex = 0; anIndex < theSkyline.size(); anIndex++)
+    {
+      if(theSkyline[anIndex].X + theWidth > mPageSize)
+      {
+        break;
+      }
+
+      // The rectangle rests on the highest segment below it
+      Uint32 anY = 0;
+      Uint32 anRemaining = theWidth;
+      for(size_t anUnder = anIndex; anRemaining > 0; anUnder++)
+      {
+        anY = std::max(anY, theSkyline[anUnder].Y);
+        anRemaining -= std::min(anRemaining, theSkyline[anUnder].Width);
+      }
+      if(anY + theHeight > mPageSize)
+      {
+        continue;
+      }
+      if(anBest == theSkyline.size() || anY < anBestY ||
+          (anY == anBestY && theSkyline[anIndex].Width < theSkyline[anBest].Width))
+      {
+        anBest = anIndex;
+        anBestY = anY;
+      }
+    }
+    if(anBest == theSkyline.size())
+    {
+      return false;
+    }
+    theX = theSkyline[anBest].X;
+    theY = anBestY;
+
+    // Raise the skyline over the rectangle
+    Segment anTop;
+    anTop.X = theX;
+    anTop.Y = theY + theHeight;
+    anTop.Width = theWidth;
+    theSkyline.insert(theSkyline.begin() + anBest, anTop);
+
+    // Shrink or remove the segments now below the rectangle
+    Uint32 anRight = theX + theWidth;
+    size_t anIndex = anBest + 1;
+    while(anIndex < theSkyline.size() && theSkyline[anIndex].X < anRight)
+    {
+      Segment& anSegment = theSkyline[anIndex];
+      if(anSegment.X + anSegment.Width <= anRight)
+      {
+        theSkyline.erase(theSkyline.begin() + anIndex);
+      }
+      else
+      {
+        anSegment.Width = anSegment.X + anSegment.Width - anRight;
+        anSegment.X = anRight;
+        break;
+      }
+    }
+
+    // Merge neighbouring segments at the same height
+    anIndex = 0;
+    while(anIndex + 1 < theSkyline.size())
+    {
+      if(theSkyline[anIndex].Y == theSkyline[anIndex + 1].Y)
+      {
+        theSkyline[anIndex].Width += theSkyline[anIndex + 1].Width;
+        theSkyline.erase(theSkyline.begin() + anIndex + 1);
+      }
+      else
+      {
+        anIndex++;
+      }
+    }
+    return true;
+  }
+
+  bool TextureAtlas::ReadCache(const std::string theCacheFilename,
+      std::vector<sf::Image>& thePages)
+  {
+    std::ifstream anFile(theCacheFilename.c_str());
+    if(!anFile.is_open())
+    {
+      return false;
+    }
+
+    // The cache is only usable if it was packed with the same sizes
+    std::string anTag;
+    Uint32 anVersion = 0;
+    Uint32 anPageSize = 0;
+    Uint32 anMaxImageSize = 0;
+    Uint32 anPageCount = 0;
+    Uint32 anImageCount = 0;
+    anFile >> anTag >> anVersion >> anPageSize >> anMaxImageSize >> anPageCount >> anImageCount;
+    if(anFile.fail() || anTag != "TextureAtlas" || anVersion != 2 ||
+        anPageSize != mPageSize || anMaxImageSize != mMaxImageSize ||
+        anImageCount != mFilenames.size())
+    {
+      ILOG() << "TextureAtlas::ReadCache(" << theCacheFilename << ") out of date" << std::endl;
+      return false;
+    }
+
+    // And it must list exactly the images added, a page of -1 marks an image
+    // that was too large to pack
+    for(Uint32 anCount = 0; anCount < anImageCount; anCount++)
+    {
+      int anPage = -1;
+      int anLeft = 0;
+      int anTop = 0;
+      int anWidth = 0;
+      int anHeight = 0;
+      Uint32 anImageWidth = 0;
+      Uint32 anImageHeight = 0;
+      Uint64 anFileSize = 0;
+      Uint64 anModified = 0;
+      typeAssetID anAssetID;
+      anFile >> anPage >> anLeft >> anTop >> anWidth >> anHeight
+        >> anImageWidth >> anImageHeight >> anFileSize >> anModified >> std::ws;
+      std::getline(anFile, anAssetID);
+
+      // Each image file must be unchanged since the cache was saved, and a
+      // packed image must fill its region
+      std::map<const typeAssetID, std::string>::const_iterator anFilename =
+        mFilenames.find(anAssetID);
+      Uint64 anCurrentSize = 0;
+      Uint64 anCurrentModified = 0;
+      if(anFile.fail() || anPage >= (int)anPageCount || anFilename == mFilenames.end() ||
+          !GetFileInfo(anFilename->second, anCurrentSize, anCurrentModified) ||
+          anCurrentSize != anFileSize || anCurrentModified != anModified ||
+          (anPage >= 0 && (anWidth != (int)anImageWidth || anHeight != (int)anImageHeight)))
+      {
+        ILOG() << "TextureAtlas::ReadCache(" << theCacheFilename << ") out of date" << std::endl;
+        mRegions.clear();
+        mImageSizes.clear();
+        return false;
+      }
+      if(anPage >= 0)
+      {
+        Region anRegion;
+        anRegion.Page = (Uint32)anPage;
+        anRegion.Rect = sf::IntRect(anLeft, anTop, anWidth, anHeight);
+        mRegions[anAssetID] = anRegion;
+      }
+      mImageSizes[anAssetID] = sf::Vector2u(anImageWidth, anImageHeight);
+    }
+
+    thePages.resize(anPageCount);
+    for(Uint32 anIndex = 0; anIndex < anPageCount; anIndex++)
+    {
+      if(!thePages[anIndex].loadFromFile(GetPageFilename(theCacheFilename, anIndex)))
+      {
+        mRegions.clear();
+        mImageSizes.clear();
+        thePages.clear();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void TextureAtlas::WriteCache(const std::string theCacheFilename,
+      const std::vector<sf::Image>& thePages) const
+  {
+    for(Uint32 anIndex = 0; anIndex < thePages.size(); anIndex++)
+    {
+      if(!thePages[anIndex].saveToFile(GetPageFilename(theCacheFilename, anIndex)))
+      {
+        ELOG() << "TextureAtlas::WriteCache(" << theCacheFilename
+          << ") unable to save page " << anIndex << std::endl;
+        return;
+      }
+    }
+
+    std::ofstream anFile(theCacheFilename.c_str());
+    if(!anFile.is_open())
+    {
+      ELOG() << "TextureAtlas::WriteCache(" << theCacheFilename
+        << ") unable to open file" << std::endl;
+      return;
+    }
+    anFile << "TextureAtlas 2 " << mPageSize << " " << mMaxImageSize << " "
+      << thePages.size() << " " << mFilenames.size() << std::endl;
+    std::map<const typeAssetID, std::string>::const_iterator anFilename;
+    for(anFilename = mFilenames.begin(); anFilename != mFilenames.end(); ++anFilename)
+    {
+      std::map<const typeAssetID, Region>::const_iterator anRegion =
+        mRegions.find(anFilename->first);
+      if(anRegion != mRegions.end())
+      {
+        const sf::IntRect& anRect = anRegion->second.Rect;
+        anFile << anRegion->second.Page << " " << anRect.left << " " << anRect.top
+          << " " << anRect.width << " " << anRect.height;
+      }
+      else
+      {
+        anFile << "-1 0 0 0 0";
+      }
+
+      // Save each image's size and file information to find changed images
+      sf::Vector2u anSize;
+      std::map<const typeAssetID, sf::Vector2u>::const_iterator anImageSize =
+        mImageSizes.find(anFilename->first);
+      if(anImageSize != mImageSizes.end())
+      {
+        anSize = anImageSize->second;
+      }
+      Uint64 anFileSize = 0;
+      Uint64 anModified = 0;
+      GetFileInfo(anFilename->second, anFileSize, anModified);
+      anFile << " " << anSize.x << " " << anSize.y << " " << anFileSize
+        << " " << anModified << " " << anFilename->first << std::endl;
+    }
+  }
+
+  void TextureAtlas::DropPages(void)
+  {
+    std::vector<sf::Texture*>::iterator anIter;
+    for(anIter = mPages.begin(); anIter != mPages.end(); ++anIter)
+    {
+      delete *anIter;
+    }
+    mPages.clear();
+    mRegions.clear();
+
+    // Anything still holding one of the pages must look it up again
+    mGeneration++;
+  }
+
+  std::string TextureAtlas::GetPageFilename(const std::string theCacheFilename,
+      Uint32 theIndex)
+  {
+    std::ostringstream anResult;
+    anResult << theCacheFilename << "." << theIndex << ".png";
+    return anResult.str();
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,67 @@
+/**
+ * Provides the WindowRenderTarget class in the GQE namespace which issues
+ * each draw call to an SFML render target right away.
+ *
+ * @file src/GQE/Core/classes/WindowRenderTarget.cpp
+ * @author Ryan Lindeman
+ * @date 20261018 - Initial Release
+ */
+#include <GQE/Core/classes/WindowRenderTarget.hpp>
+
+namespace GQE
+{
+  WindowRenderTarget::WindowRenderTarget(sf::RenderTarget& theTarget) :
+    IRenderTarget(),
+    mTarget(theTarget)
+  {
+  }
+
+  WindowRenderTarget::~WindowRenderTarget()
+  {
+  }
+
+  void WindowRenderTarget::SetView(const sf::View& theView)
+  {
+    mTarget.setView(theView);
+  }
+
+  void WindowRenderTarget::Draw(const sf::Vertex* theVertices, Uint32 theCount,
+      sf::PrimitiveType thePrimitive, const sf::Texture* theTexture)
+  {
+    sf::RenderStates anRenderStates;
+    anRenderStates.texture = theTexture;
+    anRenderStates.shader = NULL; //TODO Add back Shader Support.
+    mTarget.draw(theVertices, theCount, thePrimitive, anRenderStates);
+  }
+
+  void WindowRenderTarget::Draw(const sf::Sprite& theSprite)
+  {
+    mTarget.draw(theSprite);
+  }
+
+  void WindowRenderTarget::Draw(const sf::Text& theText)
+  {
+    mTarget.draw(theText);
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Ryan Lindeman
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -31,6 +31,9 @@
  * @date 20121107 - Fix warning: type qualifiers ignored on function return type
  * @date 20121107 - Padding IApp class
  * @date 20141107 - Added a global EventManager member.
+ * @date 20261018 - Replay each frame in a RenderThread when renderthread is set
+ * @date 20261018 - Draw each frame to the IRenderTarget from GetRenderTarget
+ * @date 20261018 - Deliver queued events after input, each UpdateFixed and UpdateVariable
  */
 
 #include <assert.h>
@@ -79,6 +82,13 @@ namespace GQE
 #endif
     mRunning(false),
     pad_()
+#if (SFML_VERSION_MAJOR < 2)
+    // RenderThread requires SFML 2
+#else
+    ,mRenderThread()
+    ,mWindowTarget(mWindow)
+    ,mRenderTarget(NULL)
+#endif
   {
     // Save our global App pointer
     gApp = this;
@@ -232,6 +242,25 @@ namespace GQE
     mRunning = false;
   }
 
+#if (SFML_VERSION_MAJOR < 2)
+  // RenderThread requires SFML 2
+#else
+  IRenderTarget& IApp::GetRenderTarget(void)
+  {
+    // Record into the render thread list only while it is replaying frames
+    if(mRenderThread.IsRunning())
+    {
+      return mRenderThread.GetCommandList();
+    }
+    return NULL != mRenderTarget ? *mRenderTarget : mWindowTarget;
+  }
+
+  void IApp::SetRenderTarget(IRenderTarget* theTarget)
+  {
+    mRenderTarget = theTarget;
+  }
+#endif
+
   GraphicRange IApp::CalculateRange(Uint32 theHeight) const
   {
     // Default to LowRange
@@ -269,6 +298,8 @@ namespace GQE
       anSettingsConfig.GetAsset().GetUint32("window","height",DEFAULT_VIDEO_HEIGHT));
     mProperties.Add<Uint32>("uWindowDepth", 
       anSettingsConfig.GetAsset().GetUint32("window","depth",DEFAULT_VIDEO_BPP));
+    mProperties.Add<bool>("bWindowRenderThread", 
+      anSettingsConfig.GetAsset().GetBool("window","renderthread",false));
   }
 
   void IApp::InitRenderer(void)
@@ -370,6 +401,20 @@ namespace GQE
       Quit(StatusAppInitFailed);
     }
 
+#if (SFML_VERSION_MAJOR < 2)
+    // RenderThread requires SFML 2
+#else
+    // Should each frame be replayed and displayed by the render thread?
+    if(!anConsoleOnly && NULL == mRenderTarget &&
+        mProperties.Get<bool>("bWindowRenderThread"))
+    {
+      // Give up the window context, the render thread takes it over
+      mWindow.setActive(false);
+      mRenderThread.SetWindow(mWindow);
+      mRenderThread.Start();
+    }
+#endif
+
     // Loop while IsRunning returns true
 #if (SFML_VERSION_MAJOR < 2)
     while(IsRunning() && !mStateManager.IsEmpty() &&
@@ -388,6 +433,9 @@ namespace GQE
       // Process any available input
       ProcessInput(anState);
 
+      // Deliver the events queued while processing input
+      mEventManager.Flush(EventPhaseInput);
+
       // Make note of the current update time
 #if (SFML_VERSION_MAJOR < 2)
       float anUpdateTime = anUpdateClock.GetElapsedTime();
@@ -401,6 +449,9 @@ namespace GQE
         // Let the current active state perform fixed updates next
         anState.UpdateFixed();
 
+        // Deliver the events queued during this fixed update
+        mEventManager.Flush(EventPhaseFixed);
+
         // Let the StatManager perfom its updates
         mStatManager.UpdateFixed();
 
@@ -425,6 +476,9 @@ namespace GQE
       anState.UpdateVariable(anFrameClock.restart().asSeconds());
 #endif
 
+      // Deliver the events queued during the variable update
+      mEventManager.Flush(EventPhaseVariable);
+
       // Let the current active state draw stuff
       anState.Draw();
 
@@ -435,13 +489,33 @@ namespace GQE
       // Display Render window to the screen
       mWindow.Display();
 #else
-      // Display Render window to the screen
-      mWindow.display();
+      if(mRenderThread.IsRunning())
+      {
+        // Hand this frame to the render thread which will display it while
+        // we move on to the next frame
+        mRenderThread.Submit();
+      }
+      else
+      {
+        // Display Render window to the screen
+        mWindow.display();
+      }
 #endif
 
       // Give the state manager a chance to delete any pending states
       mStateManager.Cleanup(); 
     } // while(IsRunning() && !mStates.empty() && (mWindow.isOpen() || anConsoleOnly))
+
+#if (SFML_VERSION_MAJOR < 2)
+    // RenderThread requires SFML 2
+#else
+    if(mRenderThread.IsRunning())
+    {
+      // Wait for the last frame to be displayed and take the window context back
+      mRenderThread.Stop();
+      mWindow.setActive(true);
+    }
+#endif
   }
 
   void IApp::ProcessInput(IState& theState)
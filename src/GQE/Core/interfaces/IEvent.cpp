@@ -4,6 +4,8 @@
  * @file src/GQE/Core/interfaces/IEvent.cpp
  * @author Ryan Lindeman
  * @date 20120630 - Initial Release
+ * @date 20261018 - Add DoBatch for delivering queued contexts
+ * @date 20261018 - Check the context type of each queued batch
  */
 #include <GQE/Core/interfaces/IEvent.hpp>
 
@@ -29,6 +31,28 @@ namespace GQE
     return mEventID;
   }
 
+  const std::type_info* IEvent::GetContextType(void) const
+  {
+    return NULL;
+  }
+
+  void IEvent::DoBatch(void* theContexts, Uint32 theCount, size_t theSize,
+    const std::type_info& theType)
+  {
+    // Contexts queued with a different type can't be handed over
+    const std::type_info* anType = GetContextType();
+    if(anType != NULL && *anType != theType)
+    {
+      return;
+    }
+
+    char* anContext = static_cast<char*>(theContexts);
+    for(Uint32 anIndex = 0; anIndex < theCount; ++anIndex)
+    {
+      DoEvent(anContext + anIndex * theSize);
+    }
+  }
+
   void IEvent::SetType(std::string theType)
   {
     mType = Type_t(theType);
@@ -17,6 +17,8 @@
  * @date 20120512 - Renamed App to IApp since it really is just an interface
  * @date 20120702 - Changed Cleanup to HandleCleanup
  * @date 20121107 - Padding SplashState class
+ * @date 20261018 - Record the splash sprite while the render thread is running
+ * @date 20261018 - Draw the splash sprite to IApp::GetRenderTarget
  */
 #include <GQE/Core/interfaces/IApp.hpp>
 #include <GQE/Core/states/SplashState.hpp>
@@ -74,7 +76,7 @@ namespace GQE
     mApp.mWindow.Draw(mSplashSprite);
 #else
     // Draw our Splash sprite
-    mApp.mWindow.draw(mSplashSprite);
+    mApp.GetRenderTarget().Draw(mSplashSprite);
 #endif
   }
 
@@ -0,0 +1,177 @@
+/**
+ * Provides the CollisionLayers class which maps collision layer names to the
+ * bits used by the uCollisionLayer and uCollisionMask properties.
+ *
+ * @file src/GQE/Entity/classes/CollisionLayers.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ */
+#include <GQE/Entity/classes/CollisionLayers.hpp>
+#include <GQE/Core/loggers/Log_macros.hpp>
+
+namespace GQE
+{
+  const std::string CollisionLayers::DEFAULT_LAYER = "default";
+  const Uint32 CollisionLayers::ALL_LAYERS = 0xFFFFFFFF;
+
+  CollisionLayers::CollisionLayers() :
+    mNextLayer(0x00000001)
+  {
+    // The default layer always uses the first bit
+    AddLayer(DEFAULT_LAYER);
+  }
+
+  CollisionLayers::~CollisionLayers()
+  {
+    mLayers.clear();
+    mMasks.clear();
+  }
+
+  Uint32 CollisionLayers::AddLayer(const std::string theLayerName)
+  {
+    // Return the existing bit if theLayerName was already added
+    std::map<const std::string, Uint32>::const_iterator anIter =
+      mLayers.find(theLayerName);
+    if(anIter != mLayers.end())
+    {
+      return anIter->second;
+    }
+
+    // Make sure there is still a bit left to assign
+    if(mNextLayer == 0)
+    {
+      ELOG() << "CollisionLayers::AddLayer(" << theLayerName
+        << ") all 32 collision layers are already in use" << std::endl;
+      return 0;
+    }
+
+    Uint32 anLayer = mNextLayer;
+    mLayers[theLayerName] = anLayer;
+    mNextLayer <<= 1;
+    return anLayer;
+  }
+
+  Uint32 CollisionLayers::GetLayer(const std::string theLayerName) const
+  {
+    std::map<const std::string, Uint32>::const_iterator anIter =
+      mLayers.find(theLayerName);
+    if(anIter != mLayers.end())
+    {
+      return anIter->second;
+    }
+    WLOG() << "CollisionLayers::GetLayer(" << theLayerName
+      << ") layer not found" << std::endl;
+    return 0;
+  }
+
+  void CollisionLayers::SetMask(const std::string theLayerName, const Uint32 theMask)
+  {
+    mMasks[theLayerName] = theMask;
+  }
+
+  Uint32 CollisionLayers::GetMask(const std::string theLayerName) const
+  {
+    std::map<const std::string, Uint32>::const_iterator anIter =
+      mMasks.find(theLayerName);
+    if(anIter != mMasks.end())
+    {
+      return anIter->second;
+    }
+    return ALL_LAYERS;
+  }
+
+  Uint32 CollisionLayers::ParseLayers(const std::string theLayerNames) const
+  {
+    Uint32 anResult = 0;
+    std::vector<std::string> anNames;
+    SplitNames(theLayerNames, anNames);
+
+    std::vector<std::string>::const_iterator anIter;
+    for(anIter = anNames.begin(); anIter != anNames.end(); ++anIter)
+    {
+      if(*anIter == "all")
+      {
+        anResult |= ALL_LAYERS;
+      }
+      else
+      {
+        anResult |= GetLayer(*anIter);
+      }
+    }
+    return anResult;
+  }
+
+  bool CollisionLayers::LoadFromConfig(const ConfigReader& theConfig,
+      const std::string theSection)
+  {
+    std::vector<std::string> anNames;
+    SplitNames(theConfig.GetString(theSection, "layers"), anNames);
+    if(anNames.empty())
+    {
+      return false;
+    }
+
+    // First add every layer so masks can refer to layers listed after them
+    std::vector<std::string>::const_iterator anIter;
+    for(anIter = anNames.begin(); anIter != anNames.end(); ++anIter)
+    {
+      AddLayer(*anIter);
+    }
+
+    // Now set the mask of each layer that provides one
+    for(anIter = anNames.begin(); anIter != anNames.end(); ++anIter)
+    {
+      std::string anMask = theConfig.GetString(theSection, *anIter);
+      if(!anMask.empty())
+      {
+        SetMask(*anIter, ParseLayers(anMask));
+      }
+    }
+    return true;
+  }
+
+  void CollisionLayers::SplitNames(const std::string theNames,
+      std::vector<std::string>& theResult)
+  {
+    size_t anStart = 0;
+    while(anStart <= theNames.size())
+    {
+      size_t anComma = theNames.find_first_of(',', anStart);
+      if(anComma == std::string::npos)
+      {
+        anComma = theNames.size();
+      }
+
+      // Trim any spaces around each name and skip empty names
+      std::string anName = theNames.substr(anStart, anComma - anStart);
+      size_t anFirst = anName.find_first_not_of(" \t");
+      size_t anLast = anName.find_last_not_of(" \t");
+      if(anFirst != std::string::npos)
+      {
+        theResult.push_back(anName.substr(anFirst, anLast - anFirst + 1));
+      }
+      anStart = anComma + 1;
+    }
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
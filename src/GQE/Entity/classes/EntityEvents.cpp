@@ -5,6 +5,7 @@
  * @file src/GQE/Entity/classes/EntityEvents.cpp
  * @author Jacob Dix
  * @date 20140410 - Initial Release
+ * @date 20261018 - Use EventContext instead of a PropertyManager context
 */
 #include <GQE/Entity/classes/EntityEvents.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
@@ -17,11 +18,11 @@ namespace GQE
   }
   void EntityEvents::RegisterEvents()
   {
-    mApp.mEventManager.Add<EntityEvents, PropertyManager>("DestroyEntity", *this, &EntityEvents::EventDestroyEntity);
+    mApp.mEventManager.Add<EntityEvents, EventContext>("DestroyEntity", *this, &EntityEvents::EventDestroyEntity);
   }
-  void EntityEvents::EventDestroyEntity(PropertyManager* theContext)
+  void EntityEvents::EventDestroyEntity(EventContext* theContext)
   {
-    IEntity* anEntity=theContext->Get<IEntity*>("Entity");
+    IEntity* anEntity=theContext!=NULL ? theContext->Entity : NULL;
     if(anEntity!=NULL)
       anEntity->Destroy();
   }
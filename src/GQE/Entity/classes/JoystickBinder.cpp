@@ -4,6 +4,8 @@
 * @file src/GQE/Entity/classes/JoystickBinder.cpp
 * @author Jacob Dix
 * @date 20140423 - Initial Release
+* @date 20261018 - Provide an EventContext instead of building a PropertyManager for each event
+* @date 20261018 - Resolve the typeEventIndex of each binding when it is registered
 */
 #include <GQE/Entity/classes/JoystickBinder.hpp>
 
@@ -24,18 +26,15 @@ namespace GQE
       if (anListIter != mButtonBindings.end())
       {
         std::map<Uint32,IEntity*>::iterator anEntityIter=mEntitys.find(theEvent.joystickButton.joystickId);
-        typeInputDataList anJoystick = anListIter->second;
+        typeInputDataList& anJoystick = anListIter->second;
         typeInputDataList::iterator anButtonIter = anJoystick.find(theEvent.joystickButton.button);
         if(anButtonIter!=anJoystick.end() && anEntityIter!=mEntitys.end())
         {
           if (((anButtonIter->second.Type == INPUT_PRESSED && theEvent.type == sf::Event::JoystickButtonPressed) ||
             (anButtonIter->second.Type == INPUT_RELEASED &&theEvent.type == sf::Event::JoystickButtonReleased))&&
-            anButtonIter->second.EventID!="")
+            anButtonIter->second.EventID!=EventManager::NO_EVENT)
           {
-            PropertyManager anContext;
-            anContext.Add<IEntity*>("Entity",mEntitys[theEvent.joystickButton.joystickId]);
-            anContext.Add<InputData>("InputData", anButtonIter->second);
-            anContext.Add<sf::Vector2f>("vInputPosition", sf::Vector2f(0, 0));
+            EventContext anContext(anEntityIter->second, &anButtonIter->second);
             mApp.mEventManager.DoEvent(anButtonIter->second.EventID, &anContext);
           }
         }
@@ -47,18 +46,15 @@ namespace GQE
       anListIter = mAxisBindings.find(theEvent.joystickMove.joystickId);
       if (anListIter != mAxisBindings.end())
       {
-        std::map<Uint32,IEntity*>::iterator anEntityIter=mEntitys.find(theEvent.joystickButton.joystickId);
-        std::map<Uint32, InputData> anJoystick = anListIter->second;
+        std::map<Uint32,IEntity*>::iterator anEntityIter=mEntitys.find(theEvent.joystickMove.joystickId);
+        typeInputDataList& anJoystick = anListIter->second;
         typeInputDataList::iterator anMovmentIter = anJoystick.find(theEvent.joystickMove.axis);
         if(anMovmentIter!=anJoystick.end() && anEntityIter!=mEntitys.end())
         {
           if ((anMovmentIter->second.Type == INPUT_MOTION && theEvent.type == sf::Event::JoystickMoved) &&
-            anMovmentIter->second.EventID!="")
+            anMovmentIter->second.EventID!=EventManager::NO_EVENT)
           {
-            PropertyManager anContext;
-
-            anContext.Add<IEntity*>("Entity",mEntitys[theEvent.joystickMove.joystickId]);
-            anContext.Add<InputData>("InputData", anMovmentIter->second);
+            EventContext anContext(anEntityIter->second, &anMovmentIter->second);
             float anAxisPosition = theEvent.joystickMove.position;
             sf::Vector2f anPosition(0, 0);
             if ((anMovmentIter->second.Axis & AXIS_HORZ) == AXIS_HORZ)
@@ -69,7 +65,7 @@ namespace GQE
             {
               anPosition.y = anAxisPosition;
             }
-            anContext.Add<sf::Vector2f>("vInputPosition", anPosition);
+            anContext.Position = anPosition;
             mApp.mEventManager.DoEvent(anMovmentIter->second.EventID, &anContext);
           }
         }
@@ -86,10 +82,7 @@ namespace GQE
       {
         if (anButtonIter->second.Type == INPUT_REALTIME && sf::Joystick::isButtonPressed(anListIter->first, anButtonIter->first))
         {
-          PropertyManager anContext;
-          anContext.Add<IEntity*>("Entity", mEntitys[anListIter->first]);
-          anContext.Add<InputData>("InputData", anButtonIter->second);
-          anContext.Add<sf::Vector2f>("vInputPosition", sf::Vector2f(0, 0));
+          EventContext anContext(mEntitys[anListIter->first], &anButtonIter->second);
           mApp.mEventManager.DoEvent(anButtonIter->second.EventID, &anContext);
         }
       }
@@ -101,9 +94,7 @@ namespace GQE
       {
         if (anMovmentIter->second.Type == INPUT_REALTIME)
         {
-          PropertyManager anContext;
-          anContext.Add<IEntity*>("Entity", mEntitys[anListIter->first]);
-          anContext.Add<InputData>("InputData", anMovmentIter->second);
+          EventContext anContext(mEntitys[anListIter->first], &anMovmentIter->second);
           float anAxisPosition = sf::Joystick::getAxisPosition(anListIter->first, (sf::Joystick::Axis)anMovmentIter->first);
           sf::Vector2f anPosition(0, 0);
           if ((anMovmentIter->second.Axis & AXIS_HORZ) == AXIS_HORZ)
@@ -114,7 +105,7 @@ namespace GQE
           {
             anPosition.y = anAxisPosition;
           }
-          anContext.Add<sf::Vector2f>("vInputPosition", anPosition);
+          anContext.Position = anPosition;
           mApp.mEventManager.DoEvent(anMovmentIter->second.EventID, &anContext);
         }
       }
@@ -123,7 +114,7 @@ namespace GQE
   void JoystickBinder::RegisterButton(GQE::Uint32 theJoystick,GQE::Uint32 theButton, typeEventID theEventID, Uint8 theType, Uint32 theAction)
   {
     InputData anCommand;
-    anCommand.EventID=theEventID;
+    anCommand.EventID=mApp.mEventManager.GetIndex(theEventID);
     anCommand.Type=theType;
     anCommand.Action = theAction;
     anCommand.Axis = AXIS_NONE;
@@ -132,7 +123,7 @@ namespace GQE
   void JoystickBinder::RegisterAxis(GQE::Uint32 theJoystick,GQE::Uint32 theAxis, typeEventID theEventID, Uint8 theType, Uint32 theAction, Uint32 theMoveAxis)
   {
     InputData anCommand;
-    anCommand.EventID = theEventID;
+    anCommand.EventID = mApp.mEventManager.GetIndex(theEventID);
     anCommand.Type = theType;
     anCommand.Action = theAction;
     anCommand.Axis = theMoveAxis;
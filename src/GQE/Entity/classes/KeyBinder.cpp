@@ -4,6 +4,8 @@
 * @file src/GQE/Entity/classes/KeyBinder.cpp
 * @author Jacob Dix
 * @date 20140419 - Initial Release
+* @date 20261018 - Provide an EventContext instead of building a PropertyManager for each event
+* @date 20261018 - Resolve the typeEventIndex of each binding when it is registered
 */
 #include <GQE/Entity/classes/KeyBinder.hpp>
 
@@ -25,10 +27,8 @@ namespace GQE
         if((mKeyBindings[theEvent.key.code].Type==INPUT_PRESSED && theEvent.type==sf::Event::KeyPressed)||
           (mKeyBindings[theEvent.key.code].Type==INPUT_RELEASED &&theEvent.type==sf::Event::KeyReleased))
         {
-          PropertyManager anContext;
-          anContext.Add<IEntity*>("Entity", mEntity);
-          anContext.Add<InputData>("InputData", anIter->second);
-          mApp.mEventManager.DoEvent(mKeyBindings[theEvent.key.code].EventID,&anContext);
+          EventContext anContext(mEntity, &anIter->second);
+          mApp.mEventManager.DoEvent(anIter->second.EventID,&anContext);
         }
       }
     }
@@ -42,9 +42,7 @@ namespace GQE
       {
         if(anIter->second.Type==INPUT_REALTIME && sf::Keyboard::isKeyPressed(sf::Keyboard::Key(anIter->first)))
         {
-          PropertyManager anContext;
-          anContext.Add<IEntity*>("Entity",mEntity);
-          anContext.Add<InputData>("InputData", anIter->second);
+          EventContext anContext(mEntity, &anIter->second);
           mApp.mEventManager.DoEvent(anIter->second.EventID,&anContext);
         }
       }
@@ -53,7 +51,7 @@ namespace GQE
   void KeyBinder::RegisterKey(GQE::Uint32 theKey, typeEventID theEventID, Uint8 theType, Uint32 theAction)
   {
     InputData anCommand;
-    anCommand.EventID=theEventID;
+    anCommand.EventID=mApp.mEventManager.GetIndex(theEventID);
     anCommand.Type=theType;
     anCommand.Action = theAction;
     anCommand.Device = DEV_KEYBOARD;
@@ -4,6 +4,8 @@
 * @file src/GQE/Entity/classes/MouseBinder.cpp
 * @author Jacob Dix
 * @date 20140419 - Initial Release
+* @date 20261018 - Provide an EventContext instead of building a PropertyManager for each event
+* @date 20261018 - Resolve the typeEventIndex of each binding when it is registered
 */
 #include <GQE/Entity/classes/MouseBinder.hpp>
 
@@ -27,21 +29,17 @@ namespace GQE
       {
         if (((mButtonBindings[theEvent.mouseButton.button].Type == INPUT_PRESSED && theEvent.type == sf::Event::MouseButtonPressed) ||
           (mButtonBindings[theEvent.mouseButton.button].Type == INPUT_RELEASED &&theEvent.type == sf::Event::MouseButtonReleased))
-          && mButtonBindings[theEvent.mouseButton.button].EventID!="")
+          && mButtonBindings[theEvent.mouseButton.button].EventID!=EventManager::NO_EVENT)
         {
-          PropertyManager anContext;
-          anContext.Add<IEntity*>("Entity",mEntity);
-          anContext.Add<InputData>("InputData", anIter->second);
-          anContext.Add<sf::Vector2f>("vInputPosition", sf::Vector2f(theEvent.mouseButton.x, theEvent.mouseButton.y));
-          mApp.mEventManager.DoEvent(mButtonBindings[theEvent.mouseButton.button].EventID, &anContext);
+          EventContext anContext(mEntity, &anIter->second);
+          anContext.Position = sf::Vector2f(theEvent.mouseButton.x, theEvent.mouseButton.y);
+          mApp.mEventManager.DoEvent(anIter->second.EventID, &anContext);
         }
       }
-      if (theEvent.type == sf::Event::MouseMoved && mMoveBinding.EventID!="" && mMoveBinding.Type==INPUT_MOTION)
+      if (theEvent.type == sf::Event::MouseMoved && mMoveBinding.EventID!=EventManager::NO_EVENT && mMoveBinding.Type==INPUT_MOTION)
       {
-        PropertyManager anContext;
-        anContext.Add<IEntity*>("Entity", mEntity);
-        anContext.Add<InputData>("InputData", mMoveBinding);
-        anContext.Add<sf::Vector2f>("vInputPosition", sf::Vector2f(theEvent.mouseMove.x, theEvent.mouseMove.y));
+        EventContext anContext(mEntity, &mMoveBinding);
+        anContext.Position = sf::Vector2f(theEvent.mouseMove.x, theEvent.mouseMove.y);
         mApp.mEventManager.DoEvent(mMoveBinding.EventID, &anContext);
       }
     }
@@ -55,18 +53,14 @@ namespace GQE
       {
         if(anIter->second.Type==INPUT_REALTIME && sf::Mouse::isButtonPressed(sf::Mouse::Button(anIter->first)))
         {
-          PropertyManager anContext;
-          anContext.Add<IEntity*>("Entity",mEntity);
-          anContext.Add<InputData>("InputData", anIter->second);
-          anContext.Add<sf::Vector2f>("vInputPosition", sf::Vector2f(sf::Mouse::getPosition()));
+          EventContext anContext(mEntity, &anIter->second);
+          anContext.Position = sf::Vector2f(sf::Mouse::getPosition());
           mApp.mEventManager.DoEvent(anIter->second.EventID,&anContext);
         }
       }
-      if (mMoveBinding.Type == INPUT_REALTIME)
+      if (mMoveBinding.Type == INPUT_REALTIME && mMoveBinding.EventID != EventManager::NO_EVENT)
       {
-        PropertyManager anContext;
-        anContext.Add<IEntity*>("Entity", mEntity);
-        anContext.Add<InputData>("InputData", mMoveBinding);
+        EventContext anContext(mEntity, &mMoveBinding);
         sf::Vector2i anMousePosition = sf::Mouse::getPosition(mApp.mWindow);
         sf::Vector2f anPosition(0,0);
         if ((mMoveBinding.Axis & AXIS_HORZ) == AXIS_HORZ)
@@ -78,7 +72,7 @@ namespace GQE
           anPosition.y = float(anMousePosition.y);
         }
 
-        anContext.Add<sf::Vector2f>("vInputPosition", anPosition);
+        anContext.Position = anPosition;
         mApp.mEventManager.DoEvent(mMoveBinding.EventID, &anContext);
       }
     }
@@ -86,7 +80,7 @@ namespace GQE
   void MouseBinder::RegisterButton(GQE::Uint32 theBinding, typeEventID theEventID, Uint8 theType, Uint32 theAction, Uint32 theAxis)
   {
     InputData anCommand;
-    anCommand.EventID=theEventID;
+    anCommand.EventID=mApp.mEventManager.GetIndex(theEventID);
     anCommand.Type=theType;
     anCommand.Action = theAction;
     anCommand.Device = DEV_MOUSE;
@@ -95,7 +89,7 @@ namespace GQE
   void MouseBinder::RegisterMovement(typeEventID theEventID, Uint8 theType, Uint32 theAction,Uint32 theAxis)
   {
     InputData anCommand;
-    anCommand.EventID = theEventID;
+    anCommand.EventID = mApp.mEventManager.GetIndex(theEventID);
     anCommand.Type = theType;
     anCommand.Action = theAction;
     anCommand.Axis=theAxis;
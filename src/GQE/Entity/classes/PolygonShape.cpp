@@ -1,19 +1,269 @@
+/**
+ * Provides the PolygonShape class which splits a concave outline into the
+ * convex pieces used by the ICollisionSystem class.
+ *
+ * @file src/GQE/Entity/classes/PolygonShape.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Cache the convex decomposition of concave outlines
+ */
+#include <algorithm>
 #include <GQE/Entity/classes/PolygonShape.hpp>
 #include <GQE/Core/loggers/Log_macros.hpp>
 
 namespace GQE
 {
-  PolygonShape::PolygonShape(std::vector<sf::
-  Vector2f> thePoints):
-		IShape()
+  /// Returns twice the signed area of the triangle theA, theB, theC which is
+  /// positive when the triangle turns the same way as a positive outline
+  static float Cross(const sf::Vector2f& theA, const sf::Vector2f& theB,
+      const sf::Vector2f& theC)
   {
-		mPoints=thePoints;
-		ConnectLines();
+    return (theB.x - theA.x)*(theC.y - theA.y) - (theB.y - theA.y)*(theC.x - theA.x);
+  }
+
+  PolygonShape::PolygonShape(const std::vector<sf::Vector2f>& thePoints)
+  {
+    SetPoints(thePoints);
   }
 
   PolygonShape::~PolygonShape()
   {
+    mPoints.clear();
+    mPieces.clear();
+  }
+
+  void PolygonShape::SetPoints(const std::vector<sf::Vector2f>& thePoints)
+  {
+    mPoints = thePoints;
+    Decompose();
+  }
+
+  const std::vector<sf::Vector2f>& PolygonShape::GetPoints(void) const
+  {
+    return mPoints;
+  }
+
+  Uint32 PolygonShape::GetPieceCount(void) const
+  {
+    return (Uint32)mPieces.size();
+  }
+
+  const std::vector<sf::Vector2f>& PolygonShape::GetPiece(const Uint32 theIndex) const
+  {
+    return mPieces.at(theIndex);
+  }
+
+  bool PolygonShape::IsConvex(void) const
+  {
+    return mPieces.size() == 1;
+  }
+
+  void PolygonShape::Decompose(void)
+  {
+    mPieces.clear();
+
+    // Drop repeated points and points that lie on a straight line since
+    // they would stop the ear clipping below from finding any ears
+    std::vector<sf::Vector2f> anPoints;
+    std::vector<sf::Vector2f>::const_iterator anIter;
+    for(anIter = mPoints.begin(); anIter != mPoints.end(); ++anIter)
+    {
+      if(anPoints.empty() || anPoints.back() != *anIter)
+      {
+        anPoints.push_back(*anIter);
+      }
+    }
+    if(anPoints.size() > 1 && anPoints.front() == anPoints.back())
+    {
+      anPoints.pop_back();
+    }
+    size_t anIndex = 0;
+    while(anPoints.size() >= 3 && anIndex < anPoints.size())
+    {
+      size_t anCount = anPoints.size();
+      if(Cross(anPoints[(anIndex + anCount - 1) % anCount], anPoints[anIndex],
+            anPoints[(anIndex + 1) % anCount]) == 0.0f)
+      {
+        anPoints.erase(anPoints.begin() + anIndex);
+        anIndex = anIndex > 0 ? anIndex - 1 : 0;
+      }
+      else
+      {
+        anIndex++;
+      }
+    }
+    if(anPoints.size() < 3)
+    {
+      if(!mPoints.empty())
+      {
+        WLOG() << "PolygonShape::Decompose() outline has no area" << std::endl;
+      }
+      return;
+    }
+
+    // Make the outline positive so every convex corner has a positive cross
+    float anArea = 0.0f;
+    for(anIndex = 0; anIndex < anPoints.size(); ++anIndex)
+    {
+      const sf::Vector2f& anA = anPoints[anIndex];
+      const sf::Vector2f& anB = anPoints[(anIndex + 1) % anPoints.size()];
+      anArea += anA.x*anB.y - anB.x*anA.y;
+    }
+    bool anReversed = anArea < 0.0f;
+    if(anReversed)
+    {
+      std::reverse(anPoints.begin(), anPoints.end());
+    }
 
+    std::vector<Uint32> anRemaining;
+    for(anIndex = 0; anIndex < anPoints.size(); ++anIndex)
+    {
+      anRemaining.push_back((Uint32)anIndex);
+    }
+
+    std::vector<std::vector<Uint32> > anPieces;
+    if(IsConvexPiece(anPoints, anRemaining))
+    {
+      // Nothing to split
+      anPieces.push_back(anRemaining);
+    }
+    else
+    {
+      // Clip one ear at a time until only a triangle is left
+      while(anRemaining.size() > 3)
+      {
+        size_t anCount = anRemaining.size();
+        bool anFound = false;
+        for(anIndex = 0; anIndex < anCount && !anFound; ++anIndex)
+        {
+          Uint32 anA = anRemaining[(anIndex + anCount - 1) % anCount];
+          Uint32 anB = anRemaining[anIndex];
+          Uint32 anC = anRemaining[(anIndex + 1) % anCount];
+          const sf::Vector2f& anPointA = anPoints[anA];
+          const sf::Vector2f& anPointB = anPoints[anB];
+          const sf::Vector2f& anPointC = anPoints[anC];
+          if(Cross(anPointA, anPointB, anPointC) <= 0.0f)
+          {
+            continue;
+          }
+
+          // An ear can't have any other point inside or on its edges
+          bool anEar = true;
+          for(size_t anOther = 0; anOther < anCount && anEar; ++anOther)
+          {
+            const sf::Vector2f& anPoint = anPoints[anRemaining[anOther]];
+            if(anPoint == anPointA || anPoint == anPointB || anPoint == anPointC)
+            {
+              continue;
+            }
+            anEar = Cross(anPointA, anPointB, anPoint) < 0.0f ||
+              Cross(anPointB, anPointC, anPoint) < 0.0f ||
+              Cross(anPointC, anPointA, anPoint) < 0.0f;
+          }
+          if(anEar)
+          {
+            std::vector<Uint32> anTriangle;
+            anTriangle.push_back(anA);
+            anTriangle.push_back(anB);
+            anTriangle.push_back(anC);
+            anPieces.push_back(anTriangle);
+            anRemaining.erase(anRemaining.begin() + anIndex);
+            anFound = true;
+          }
+        }
+        if(!anFound)
+        {
+          // Only a self intersecting outline has no ears left
+          WLOG() << "PolygonShape::Decompose() outline intersects itself" << std::endl;
+          break;
+        }
+      }
+      if(anRemaining.size() > 3 || Cross(anPoints[anRemaining[0]],
+            anPoints[anRemaining[1]], anPoints[anRemaining[2]]) > 0.0f)
+      {
+        anPieces.push_back(anRemaining);
+      }
+
+      // Merge pieces that share an edge as long as the result stays convex
+      bool anMerged = true;
+      while(anMerged)
+      {
+        anMerged = false;
+        for(size_t anFirst = 0; anFirst < anPieces.size() && !anMerged; ++anFirst)
+        {
+          for(size_t anSecond = anFirst + 1; anSecond < anPieces.size() && !anMerged; ++anSecond)
+          {
+            const std::vector<Uint32>& anPieceA = anPieces[anFirst];
+            const std::vector<Uint32>& anPieceB = anPieces[anSecond];
+            size_t anCountA = anPieceA.size();
+            size_t anCountB = anPieceB.size();
+            for(size_t anEdgeA = 0; anEdgeA < anCountA && !anMerged; ++anEdgeA)
+            {
+              Uint32 anU = anPieceA[anEdgeA];
+              Uint32 anV = anPieceA[(anEdgeA + 1) % anCountA];
+              for(size_t anEdgeB = 0; anEdgeB < anCountB; ++anEdgeB)
+              {
+                if(anPieceB[anEdgeB] != anV || anPieceB[(anEdgeB + 1) % anCountB] != anU)
+                {
+                  continue;
+                }
+
+                // Walk around A from V to U and then around B back to V
+                std::vector<Uint32> anPiece;
+                size_t anStep;
+                for(anStep = 0; anStep < anCountA; ++anStep)
+                {
+                  anPiece.push_back(anPieceA[(anEdgeA + 1 + anStep) % anCountA]);
+                }
+                for(anStep = 0; anStep + 2 < anCountB; ++anStep)
+                {
+                  anPiece.push_back(anPieceB[(anEdgeB + 2 + anStep) % anCountB]);
+                }
+                if(IsConvexPiece(anPoints, anPiece))
+                {
+                  anPieces[anFirst] = anPiece;
+                  anPieces.erase(anPieces.begin() + anSecond);
+                  anMerged = true;
+                }
+                break;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // Keep the pieces in the same winding order as the outline provided
+    std::vector<std::vector<Uint32> >::iterator anPiece;
+    for(anPiece = anPieces.begin(); anPiece != anPieces.end(); ++anPiece)
+    {
+      if(anReversed)
+      {
+        std::reverse(anPiece->begin(), anPiece->end());
+      }
+      std::vector<sf::Vector2f> anPiecePoints;
+      std::vector<Uint32>::const_iterator anPoint;
+      for(anPoint = anPiece->begin(); anPoint != anPiece->end(); ++anPoint)
+      {
+        anPiecePoints.push_back(anPoints[*anPoint]);
+      }
+      mPieces.push_back(anPiecePoints);
+    }
+  }
+
+  bool PolygonShape::IsConvexPiece(const std::vector<sf::Vector2f>& thePoints,
+      const std::vector<Uint32>& thePiece)
+  {
+    size_t anCount = thePiece.size();
+    for(size_t anIndex = 0; anIndex < anCount; ++anIndex)
+    {
+      if(Cross(thePoints[thePiece[(anIndex + anCount - 1) % anCount]],
+            thePoints[thePiece[anIndex]],
+            thePoints[thePiece[(anIndex + 1) % anCount]]) < 0.0f)
+      {
+        return false;
+      }
+    }
+    return true;
   }
 } // namespace GQE
 
@@ -1,31 +1,40 @@
+/**
+ * Provides the RectangleShape class which is a PolygonShape with four corners.
+ *
+ * @file src/GQE/Entity/classes/RectangleShape.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Derive from PolygonShape
+ */
 #include <GQE/Entity/classes/RectangleShape.hpp>
 #include <GQE/Core/loggers/Log_macros.hpp>
 
 namespace GQE
 {
-  RectangleShape::RectangleShape(GQE::Uint32 theWidth,GQE::Uint32 theHeight):
-		IShape()
+  RectangleShape::RectangleShape(const Uint32 theWidth, const Uint32 theHeight) :
+    PolygonShape()
   {
-		GenerateRectangle(theWidth,theHeight);
+    GenerateRectangle(theWidth, theHeight);
   }
 
   RectangleShape::~RectangleShape()
   {
-
   }
 
-	void RectangleShape::GenerateRectangle(GQE::Uint32 theWidth,GQE::Uint32 theHeight)
-	{
-		sf::Vector2f anPoint(0,0);
-		mPoints.push_back(anPoint);
-		anPoint=sf::Vector2f(theWidth,0);
-		mPoints.push_back(anPoint);
-		anPoint=sf::Vector2f(theWidth,theHeight);
-		mPoints.push_back(anPoint);
-		anPoint=sf::Vector2f(0,theHeight);
-		mPoints.push_back(anPoint);
-		ConnectLines();
-	}
+  void RectangleShape::GenerateRectangle(const Uint32 theWidth, const Uint32 theHeight)
+  {
+    std::vector<sf::Vector2f> anPoints;
+    if(theWidth == 0 || theHeight == 0)
+    {
+      // An empty rectangle has no outline at all
+      SetPoints(anPoints);
+      return;
+    }
+    anPoints.push_back(sf::Vector2f(0.0f, 0.0f));
+    anPoints.push_back(sf::Vector2f((float)theWidth, 0.0f));
+    anPoints.push_back(sf::Vector2f((float)theWidth, (float)theHeight));
+    anPoints.push_back(sf::Vector2f(0.0f, (float)theHeight));
+    SetPoints(anPoints);
+  }
 } // namespace GQE
 
 /**
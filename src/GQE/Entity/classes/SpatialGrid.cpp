@@ -0,0 +1,264 @@
+/**
+ * Provides the SpatialGrid class which finds the IEntity classes within a
+ * region without visiting every IEntity.
+ *
+ * @file src/GQE/Entity/classes/SpatialGrid.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Erase each cell once it is empty
+ */
+#include <cmath>
+#include <GQE/Entity/classes/SpatialGrid.hpp>
+#include <GQE/Entity/interfaces/IEntity.hpp>
+
+namespace GQE
+{
+  SpatialGrid::SpatialGrid(const float theCellSize) :
+    mCellSize(theCellSize > 0.0f ? theCellSize : 256.0f)
+  {
+  }
+
+  SpatialGrid::~SpatialGrid()
+  {
+    mProxies.clear();
+    mFreeProxies.clear();
+    mProxyIDs.clear();
+    mCells.clear();
+    mOversized.clear();
+  }
+
+  float SpatialGrid::GetCellSize(void) const
+  {
+    return mCellSize;
+  }
+
+  Uint32 SpatialGrid::GetProxyCount(void) const
+  {
+    return (Uint32)mProxyIDs.size();
+  }
+
+  bool SpatialGrid::HasProxy(const IEntity* theEntity) const
+  {
+    return mProxyIDs.find(theEntity->GetID()) != mProxyIDs.end();
+  }
+
+  void SpatialGrid::UpdateProxy(IEntity* theEntity, const sf::FloatRect& theBounds)
+  {
+    std::map<const typeEntityID, Uint32>::iterator anIter =
+      mProxyIDs.find(theEntity->GetID());
+
+    if(anIter != mProxyIDs.end())
+    {
+      Proxy& anProxy = mProxies[anIter->second];
+      bool anOversized = theBounds.width > mCellSize || theBounds.height > mCellSize;
+      Uint64 anCell = GetCellKey(GetCellIndex(theBounds.left + theBounds.width * 0.5f),
+        GetCellIndex(theBounds.top + theBounds.height * 0.5f));
+
+      // Still in the same cell? then just save the new bounds
+      anProxy.Bounds = theBounds;
+      if(anProxy.Oversized == anOversized && (anOversized || anProxy.Cell == anCell))
+      {
+        return;
+      }
+
+      // Otherwise move it to its new cell
+      Unlink(anIter->second);
+      Link(anIter->second);
+      return;
+    }
+
+    // Reuse a previously dropped proxy if possible
+    Uint32 anIndex;
+    if(!mFreeProxies.empty())
+    {
+      anIndex = mFreeProxies.back();
+      mFreeProxies.pop_back();
+    }
+    else
+    {
+      anIndex = (Uint32)mProxies.size();
+      mProxies.push_back(Proxy());
+    }
+    mProxies[anIndex].Entity = theEntity;
+    mProxies[anIndex].Bounds = theBounds;
+    mProxyIDs[theEntity->GetID()] = anIndex;
+    Link(anIndex);
+  }
+
+  void SpatialGrid::DropProxy(const IEntity* theEntity)
+  {
+    std::map<const typeEntityID, Uint32>::iterator anIter =
+      mProxyIDs.find(theEntity->GetID());
+
+    // Nothing to do if theEntity was never added
+    if(anIter == mProxyIDs.end())
+    {
+      return;
+    }
+
+    Unlink(anIter->second);
+    mProxies[anIter->second].Entity = NULL;
+    mFreeProxies.push_back(anIter->second);
+    mProxyIDs.erase(anIter);
+  }
+
+  void SpatialGrid::QueryAABB(const sf::FloatRect& theRect,
+      std::vector<IEntity*>& theResult) const
+  {
+    std::vector<Uint32>::const_iterator anIndex;
+
+    // Oversized proxies can't be found by their cell so check each one
+    for(anIndex = mOversized.begin(); anIndex != mOversized.end(); ++anIndex)
+    {
+      const Proxy& anProxy = mProxies[*anIndex];
+      if(anProxy.Bounds.intersects(theRect))
+      {
+        theResult.push_back(anProxy.Entity);
+      }
+    }
+
+    // A proxy can reach half a cell past the cell holding its center
+    float anHalf = mCellSize * 0.5f;
+    Int32 anLeft = GetCellIndex(theRect.left - anHalf);
+    Int32 anRight = GetCellIndex(theRect.left + theRect.width + anHalf);
+    Int32 anTop = GetCellIndex(theRect.top - anHalf);
+    Int32 anBottom = GetCellIndex(theRect.top + theRect.height + anHalf);
+    double anArea = ((double)anRight - anLeft + 1.0) * ((double)anBottom - anTop + 1.0);
+
+    if(anArea > (double)mCells.size())
+    {
+      // Fewer cells are in use than the region covers, so visit those instead
+      std::map<const Uint64, std::vector<Uint32> >::const_iterator anCell;
+      for(anCell = mCells.begin(); anCell != mCells.end(); ++anCell)
+      {
+        Int32 anX = (Int32)(Uint32)(anCell->first >> 32);
+        Int32 anY = (Int32)(Uint32)(anCell->first & 0xFFFFFFFF);
+        if(anX < anLeft || anX > anRight || anY < anTop || anY > anBottom)
+        {
+          continue;
+        }
+        for(anIndex = anCell->second.begin(); anIndex != anCell->second.end(); ++anIndex)
+        {
+          const Proxy& anProxy = mProxies[*anIndex];
+          if(anProxy.Bounds.intersects(theRect))
+          {
+            theResult.push_back(anProxy.Entity);
+          }
+        }
+      }
+      return;
+    }
+
+    for(Int32 anY = anTop; anY <= anBottom; ++anY)
+    {
+      for(Int32 anX = anLeft; anX <= anRight; ++anX)
+      {
+        std::map<const Uint64, std::vector<Uint32> >::const_iterator anCell =
+          mCells.find(GetCellKey(anX, anY));
+        if(anCell == mCells.end())
+        {
+          continue;
+        }
+        for(anIndex = anCell->second.begin(); anIndex != anCell->second.end(); ++anIndex)
+        {
+          const Proxy& anProxy = mProxies[*anIndex];
+          if(anProxy.Bounds.intersects(theRect))
+          {
+            theResult.push_back(anProxy.Entity);
+          }
+        }
+      }
+    }
+  }
+
+  Uint64 SpatialGrid::GetCellKey(const Int32 theX, const Int32 theY)
+  {
+    return ((Uint64)(Uint32)theX << 32) | (Uint64)(Uint32)theY;
+  }
+
+  Int32 SpatialGrid::GetCellIndex(const float theValue) const
+  {
+    // Keep far away values from overflowing the cell index
+    double anIndex = std::floor((double)theValue / mCellSize);
+    if(anIndex < -2147483647.0)
+    {
+      return -2147483647;
+    }
+    if(anIndex > 2147483646.0)
+    {
+      return 2147483646;
+    }
+    return (Int32)anIndex;
+  }
+
+  void SpatialGrid::Link(const Uint32 theIndex)
+  {
+    Proxy& anProxy = mProxies[theIndex];
+    const sf::FloatRect& anBounds = anProxy.Bounds;
+    anProxy.Oversized = anBounds.width > mCellSize || anBounds.height > mCellSize;
+    if(anProxy.Oversized)
+    {
+      anProxy.Cell = 0;
+      anProxy.Slot = (Uint32)mOversized.size();
+      mOversized.push_back(theIndex);
+    }
+    else
+    {
+      anProxy.Cell = GetCellKey(GetCellIndex(anBounds.left + anBounds.width * 0.5f),
+        GetCellIndex(anBounds.top + anBounds.height * 0.5f));
+
+      std::vector<Uint32>& anCell = mCells[anProxy.Cell];
+      anProxy.Slot = (Uint32)anCell.size();
+      anCell.push_back(theIndex);
+    }
+  }
+
+  void SpatialGrid::Unlink(const Uint32 theIndex)
+  {
+    const Proxy& anProxy = mProxies[theIndex];
+    if(anProxy.Oversized)
+    {
+      // Move the last proxy into this slot so the removal doesn't shift others
+      Uint32 anLast = mOversized.back();
+      mOversized[anProxy.Slot] = anLast;
+      mProxies[anLast].Slot = anProxy.Slot;
+      mOversized.pop_back();
+      return;
+    }
+
+    std::map<const Uint64, std::vector<Uint32> >::iterator anCell =
+      mCells.find(anProxy.Cell);
+    std::vector<Uint32>& anList = anCell->second;
+    Uint32 anLast = anList.back();
+    anList[anProxy.Slot] = anLast;
+    mProxies[anLast].Slot = anProxy.Slot;
+    anList.pop_back();
+
+    // Empty cells are erased so QueryAABB only counts the cells in use
+    if(anList.empty())
+    {
+      mCells.erase(anCell);
+    }
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
@@ -0,0 +1,415 @@
+/**
+ * Provides the SweepAndPrune class which is used as the broadphase by the
+ * ICollisionSystem class to find IEntity pairs whose bounding boxes overlap.
+ *
+ * @file src/GQE/Entity/classes/SweepAndPrune.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Add collision layer and mask filtering of pairs
+ * @date 20261018 - Add QueryAABB for finding proxies within a region
+ */
+#include <GQE/Entity/classes/SweepAndPrune.hpp>
+#include <GQE/Entity/interfaces/IEntity.hpp>
+
+namespace GQE
+{
+  SweepAndPrune::SweepAndPrune(const Uint32 theAxes) :
+    mAxes(theAxes & (AXIS_HORZ | AXIS_VERT))
+  {
+    mMaxExtent[0] = 0.0f;
+    mMaxExtent[1] = 0.0f;
+  }
+
+  SweepAndPrune::~SweepAndPrune()
+  {
+    // Clear all of our lists
+    mPairs.clear();
+    mAdded.clear();
+    mRemoved.clear();
+    mEndpoints[0].clear();
+    mEndpoints[1].clear();
+    mProxyIDs.clear();
+    mFreeProxies.clear();
+    mProxies.clear();
+  }
+
+  bool SweepAndPrune::HasProxy(const IEntity* theEntity) const
+  {
+    return mProxyIDs.find(theEntity->GetID()) != mProxyIDs.end();
+  }
+
+  void SweepAndPrune::UpdateProxy(IEntity* theEntity, const sf::FloatRect& theBounds,
+      const Uint32 theLayer, const Uint32 theMask)
+  {
+    std::map<const typeEntityID, Uint32>::iterator anIter =
+      mProxyIDs.find(theEntity->GetID());
+
+    if(anIter != mProxyIDs.end())
+    {
+      Proxy& anProxy = mProxies[anIter->second];
+
+      // Existing proxy? then just save the new bounds for the next Update
+      if(anProxy.Layer == theLayer && anProxy.Mask == theMask)
+      {
+        anProxy.Bounds = theBounds;
+        return;
+      }
+
+      // Otherwise drop and add it again so its pairs are filtered again
+      DropProxy(theEntity);
+    }
+
+    // Reuse a previously dropped proxy if possible
+    Uint32 anIndex;
+    if(!mFreeProxies.empty())
+    {
+      anIndex = mFreeProxies.back();
+      mFreeProxies.pop_back();
+    }
+    else
+    {
+      anIndex = (Uint32)mProxies.size();
+      mProxies.push_back(Proxy());
+    }
+    mProxies[anIndex].Entity = theEntity;
+    mProxies[anIndex].Bounds = theBounds;
+    mProxies[anIndex].Layer = theLayer;
+    mProxies[anIndex].Mask = theMask;
+    mProxyIDs[theEntity->GetID()] = anIndex;
+
+    // Append the new endpoints to the end of each list, the next Update will
+    // sort them into place and add any pairs they overlap along the way
+    for(Uint32 anAxis = 0; anAxis < 2; ++anAxis)
+    {
+      // Skip the axis we are not sorting along
+      if(0 == (mAxes & (anAxis == 0 ? AXIS_HORZ : AXIS_VERT)))
+      {
+        continue;
+      }
+
+      Endpoint anEndpoint;
+      anEndpoint.Value = 0.0f;
+      anEndpoint.ProxyIndex = anIndex;
+      anEndpoint.Minimum = true;
+      mEndpoints[anAxis].push_back(anEndpoint);
+      anEndpoint.Minimum = false;
+      mEndpoints[anAxis].push_back(anEndpoint);
+    }
+  }
+
+  void SweepAndPrune::DropProxy(const IEntity* theEntity)
+  {
+    std::map<const typeEntityID, Uint32>::iterator anIter =
+      mProxyIDs.find(theEntity->GetID());
+
+    // Nothing to do if theEntity was never added
+    if(anIter == mProxyIDs.end())
+    {
+      return;
+    }
+    Uint32 anIndex = anIter->second;
+
+    // Remove both endpoints from each list without disturbing the order
+    for(Uint32 anAxis = 0; anAxis < 2; ++anAxis)
+    {
+      std::vector<Endpoint>& anEndpoints = mEndpoints[anAxis];
+      size_t anKeep = 0;
+      for(size_t anFind = 0; anFind < anEndpoints.size(); ++anFind)
+      {
+        if(anEndpoints[anFind].ProxyIndex != anIndex)
+        {
+          anEndpoints[anKeep++] = anEndpoints[anFind];
+        }
+      }
+      anEndpoints.resize(anKeep);
+    }
+
+    // Remove every pair theEntity was part of
+    std::map<const Uint64, CollisionPair>::iterator anPair = mPairs.begin();
+    while(anPair != mPairs.end())
+    {
+      if(anPair->second.First == theEntity || anPair->second.Second == theEntity)
+      {
+        mRemoved.push_back(anPair->second);
+        mPairs.erase(anPair++);
+      }
+      else
+      {
+        ++anPair;
+      }
+    }
+
+    // Last of all make this proxy available again
+    mProxies[anIndex].Entity = NULL;
+    mFreeProxies.push_back(anIndex);
+    mProxyIDs.erase(anIter);
+  }
+
+  void SweepAndPrune::Update(void)
+  {
+    // Refresh every endpoint value first so the overlap tests done while
+    // sorting always use the current bounds along every axis
+    for(Uint32 anAxis = 0; anAxis < 2; ++anAxis)
+    {
+      std::vector<Endpoint>& anEndpoints = mEndpoints[anAxis];
+      mMaxExtent[anAxis] = 0.0f;
+      for(size_t anIndex = 0; anIndex < anEndpoints.size(); ++anIndex)
+      {
+        Endpoint& anEndpoint = anEndpoints[anIndex];
+        const sf::FloatRect& anBounds = mProxies[anEndpoint.ProxyIndex].Bounds;
+        float anExtent = anAxis == 0 ? anBounds.width : anBounds.height;
+        if(anAxis == 0)
+        {
+          anEndpoint.Value = anEndpoint.Minimum ? anBounds.left :
+            anBounds.left + anBounds.width;
+        }
+        else
+        {
+          anEndpoint.Value = anEndpoint.Minimum ? anBounds.top :
+            anBounds.top + anBounds.height;
+        }
+
+        // Remember the largest extent so QueryAABB knows how far back to look
+        if(anExtent > mMaxExtent[anAxis])
+        {
+          mMaxExtent[anAxis] = anExtent;
+        }
+      }
+    }
+
+    // Now resort each axis we are tracking
+    if(mAxes & AXIS_HORZ)
+    {
+      SortAxis(mEndpoints[0]);
+    }
+    if(mAxes & AXIS_VERT)
+    {
+      SortAxis(mEndpoints[1]);
+    }
+  }
+
+  void SweepAndPrune::QueryAABB(const sf::FloatRect& theRect, const Uint32 theMask,
+      std::vector<IEntity*>& theResult) const
+  {
+    // Without any sorted axis every proxy must be checked
+    if(0 == mAxes)
+    {
+      for(size_t anIndex = 0; anIndex < mProxies.size(); ++anIndex)
+      {
+        const Proxy& anProxy = mProxies[anIndex];
+        if(NULL != anProxy.Entity && 0 != (anProxy.Layer & theMask) &&
+            !(anProxy.Bounds.left > theRect.left + theRect.width ||
+              theRect.left > anProxy.Bounds.left + anProxy.Bounds.width ||
+              anProxy.Bounds.top > theRect.top + theRect.height ||
+              theRect.top > anProxy.Bounds.top + anProxy.Bounds.height))
+        {
+          theResult.push_back(anProxy.Entity);
+        }
+      }
+      return;
+    }
+
+    // Any proxy overlapping theRect must have its minimum endpoint no more
+    // than the largest extent before the start of theRect along this axis
+    Uint32 anAxis = (mAxes & AXIS_HORZ) ? 0 : 1;
+    float anStart = (anAxis == 0 ? theRect.left : theRect.top) - mMaxExtent[anAxis];
+    float anEnd = anAxis == 0 ? theRect.left + theRect.width : theRect.top + theRect.height;
+    const std::vector<Endpoint>& anEndpoints = mEndpoints[anAxis];
+
+    // Binary search for the first endpoint at or after anStart
+    size_t anLow = 0;
+    size_t anHigh = anEndpoints.size();
+    while(anLow < anHigh)
+    {
+      size_t anMiddle = (anLow + anHigh) / 2;
+      if(anEndpoints[anMiddle].Value < anStart)
+      {
+        anLow = anMiddle + 1;
+      }
+      else
+      {
+        anHigh = anMiddle;
+      }
+    }
+
+    for(size_t anIndex = anLow; anIndex < anEndpoints.size() &&
+        anEndpoints[anIndex].Value <= anEnd; ++anIndex)
+    {
+      const Endpoint& anEndpoint = anEndpoints[anIndex];
+      if(!anEndpoint.Minimum)
+      {
+        continue;
+      }
+      const Proxy& anProxy = mProxies[anEndpoint.ProxyIndex];
+      if(0 != (anProxy.Layer & theMask) &&
+          !(anProxy.Bounds.left > theRect.left + theRect.width ||
+            theRect.left > anProxy.Bounds.left + anProxy.Bounds.width ||
+            anProxy.Bounds.top > theRect.top + theRect.height ||
+            theRect.top > anProxy.Bounds.top + anProxy.Bounds.height))
+      {
+        theResult.push_back(anProxy.Entity);
+      }
+    }
+  }
+
+  const std::map<const Uint64, CollisionPair>& SweepAndPrune::GetPairs(void) const
+  {
+    return mPairs;
+  }
+
+  const std::vector<CollisionPair>& SweepAndPrune::GetAddedPairs(void) const
+  {
+    return mAdded;
+  }
+
+  const std::vector<CollisionPair>& SweepAndPrune::GetRemovedPairs(void) const
+  {
+    return mRemoved;
+  }
+
+  void SweepAndPrune::ClearChanges(void)
+  {
+    mAdded.clear();
+    mRemoved.clear();
+  }
+
+  Uint64 SweepAndPrune::GetPairKey(const typeEntityID theFirstID,
+      const typeEntityID theSecondID)
+  {
+    if(theFirstID < theSecondID)
+    {
+      return ((Uint64)theFirstID << 32) | (Uint64)theSecondID;
+    }
+    return ((Uint64)theSecondID << 32) | (Uint64)theFirstID;
+  }
+
+  void SweepAndPrune::SortAxis(std::vector<Endpoint>& theEndpoints)
+  {
+    for(size_t anIndex = 1; anIndex < theEndpoints.size(); ++anIndex)
+    {
+      Endpoint anKey = theEndpoints[anIndex];
+      size_t anSlot = anIndex;
+
+      // Move anKey down while it belongs before the previous endpoint, ties
+      // place minimum endpoints first so touching bounds count as overlapping
+      while(anSlot > 0)
+      {
+        Endpoint& anPrevious = theEndpoints[anSlot-1];
+        if(anKey.Value > anPrevious.Value ||
+            (anKey.Value == anPrevious.Value &&
+             (!anKey.Minimum || anPrevious.Minimum)))
+        {
+          break;
+        }
+
+        if(anKey.Minimum && !anPrevious.Minimum)
+        {
+          // A minimum passing a maximum means they now overlap on this axis
+          if(Overlaps(anKey.ProxyIndex, anPrevious.ProxyIndex))
+          {
+            AddPair(anKey.ProxyIndex, anPrevious.ProxyIndex);
+          }
+        }
+        else if(!anKey.Minimum && anPrevious.Minimum)
+        {
+          // A maximum passing a minimum means they no longer overlap
+          RemovePair(anKey.ProxyIndex, anPrevious.ProxyIndex);
+        }
+
+        theEndpoints[anSlot] = anPrevious;
+        --anSlot;
+      }
+      theEndpoints[anSlot] = anKey;
+    }
+  }
+
+  bool SweepAndPrune::Overlaps(const Uint32 theFirst, const Uint32 theSecond) const
+  {
+    if(theFirst == theSecond)
+    {
+      return false;
+    }
+
+    // Check the layers and masks before the bounds
+    const Proxy& anFirstProxy = mProxies[theFirst];
+    const Proxy& anSecondProxy = mProxies[theSecond];
+    if(0 == (anFirstProxy.Layer & anSecondProxy.Mask) ||
+        0 == (anSecondProxy.Layer & anFirstProxy.Mask))
+    {
+      return false;
+    }
+
+    const sf::FloatRect& anFirst = anFirstProxy.Bounds;
+    const sf::FloatRect& anSecond = anSecondProxy.Bounds;
+    if((mAxes & AXIS_HORZ) &&
+        (anFirst.left > anSecond.left + anSecond.width ||
+         anSecond.left > anFirst.left + anFirst.width))
+    {
+      return false;
+    }
+    if((mAxes & AXIS_VERT) &&
+        (anFirst.top > anSecond.top + anSecond.height ||
+         anSecond.top > anFirst.top + anFirst.height))
+    {
+      return false;
+    }
+    return true;
+  }
+
+  void SweepAndPrune::AddPair(const Uint32 theFirst, const Uint32 theSecond)
+  {
+    IEntity* anFirst = mProxies[theFirst].Entity;
+    IEntity* anSecond = mProxies[theSecond].Entity;
+
+    // Always store the IEntity with the lowest ID first
+    if(anSecond->GetID() < anFirst->GetID())
+    {
+      IEntity* anSwap = anFirst;
+      anFirst = anSecond;
+      anSecond = anSwap;
+    }
+
+    Uint64 anKey = GetPairKey(anFirst->GetID(), anSecond->GetID());
+    if(mPairs.find(anKey) == mPairs.end())
+    {
+      CollisionPair anPair;
+      anPair.First = anFirst;
+      anPair.Second = anSecond;
+      mPairs.insert(std::pair<const Uint64, CollisionPair>(anKey, anPair));
+      mAdded.push_back(anPair);
+    }
+  }
+
+  void SweepAndPrune::RemovePair(const Uint32 theFirst, const Uint32 theSecond)
+  {
+    Uint64 anKey = GetPairKey(mProxies[theFirst].Entity->GetID(),
+        mProxies[theSecond].Entity->GetID());
+    std::map<const Uint64, CollisionPair>::iterator anIter = mPairs.find(anKey);
+    if(anIter != mPairs.end())
+    {
+      mRemoved.push_back(anIter->second);
+      mPairs.erase(anIter);
+    }
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
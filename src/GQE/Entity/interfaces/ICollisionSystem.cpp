@@ -4,20 +4,54 @@
  * @file src/GQE/Entity/systems/ICollisionSystem.cpp
  * @author Jacob Dix
  * @date 20120611 Initial release
+ * @date 20261018 - Use SweepAndPrune broadphase to find pairs to test
+ * @date 20261018 - Cache world space collision geometry for each IEntity
+ * @date 20261018 - Use SIMD separating axis tests from CollisionUtil
+ * @date 20261018 - Add collision layers and masks checked in the broadphase
+ * @date 20261018 - Split the narrowphase tests across worker threads
+ * @date 20261018 - Keep a contact cache and report begin/stay/end contacts
+ * @date 20261018 - Add circle and AABB colliders selected by uColliderType
+ * @date 20261018 - Add point, region and ray cast queries over the broadphase
+ * @date 20261018 - Add swept tests for IEntity classes flagged as bContinuous
+ * @date 20261018 - Add CollisionPolygon for concave shapes split into convex pieces
+ * @date 20261018 - Add GetStats for the work done by the last update
+ * @date 20261018 - Skip undelivered contacts of IEntity classes dropped by a handler
+ * @date 20261018 - Don't add a narrowphase worker whose thread can't be created
+ * @date 20261018 - Only use sCollisionLayer names that were added to mLayers
+ * @date 20261018 - Keep each narrowphase worker thread running between updates
+ * @date 20261018 - Leave the unknown sCollisionLayer warning to CollisionLayers
+ * @date 20261018 - Set the Center of polygon caches
  */
+#include <algorithm>
+#include <limits>
+#include <math.h>
 #include <SFML/Graphics.hpp>
 #include <GQE/Entity/interfaces/ICollisionSystem.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
+#include <GQE/Entity/classes/PolygonShape.hpp>
 #include <GQE/Core/utils/MathUtil.hpp>
+#include <GQE/Entity/utils/CollisionUtil.hpp>
+#include <GQE/Core/loggers/Log_macros.hpp>
 namespace GQE
 {
-  ICollisionSystem::ICollisionSystem(IApp& theApp) :
-    ISystem("CollisionSystem",theApp)
+  ICollisionSystem::ICollisionSystem(IApp& theApp, const Uint32 theSweepAxes) :
+    ISystem("CollisionSystem",theApp),
+    mBroadphase(theSweepAxes),
+    mUpdate(0)
   {
+    // Start with a single worker that runs on the main thread
+    SetThreadCount(1);
   }
 
   ICollisionSystem::~ICollisionSystem()
   {
+    std::vector<NarrowphaseWorker*>::iterator anIter;
+    for(anIter = mWorkers.begin(); anIter != mWorkers.end(); ++anIter)
+    {
+      (*anIter)->Stop();
+      delete *anIter;
+    }
+    mWorkers.clear();
   }
 
   void ICollisionSystem::AddProperties(IEntity* theEntity)
@@ -27,13 +61,34 @@ namespace GQE
 		theEntity->mProperties.Add<sf::Vector2f>("vCollisionOffset",sf::Vector2f(0,0));
 		theEntity->mProperties.Add<float>("fCollisionRotation",0.0f);
     theEntity->mProperties.Add<bool>("bSolid",true);
+    theEntity->mProperties.Add<Uint32>("uCollisionLayer",mLayers.GetLayer(CollisionLayers::DEFAULT_LAYER));
+    theEntity->mProperties.Add<Uint32>("uCollisionMask",CollisionLayers::ALL_LAYERS);
+    theEntity->mProperties.Add<std::string>("sCollisionLayer","");
+    theEntity->mProperties.Add<Uint32>("uColliderType",COLLIDER_POLYGON);
+    theEntity->mProperties.Add<float>("fCollisionRadius",0.0f);
+    theEntity->mProperties.Add<bool>("bContinuous",false);
+    theEntity->mProperties.Add<PolygonShape*>("CollisionPolygon",NULL);
   }
 
   void ICollisionSystem::HandleInit(IEntity* theEntity)
   {
     if(theEntity->mProperties.Get<bool>("bMovable"))
     {
-      mMovables.push_back(theEntity);
+      mMovables[theEntity->GetID()] = theEntity;
+    }
+
+    // Use the layer and mask of the named layer if one was provided, a
+    // misspelled name keeps the uCollisionLayer and uCollisionMask provided
+    std::string anLayerName = theEntity->mProperties.GetString("sCollisionLayer");
+    if(!anLayerName.empty())
+    {
+      // GetLayer already warns about names that were never added
+      Uint32 anLayer = mLayers.GetLayer(anLayerName);
+      if(anLayer != 0)
+      {
+        theEntity->mProperties.Set<Uint32>("uCollisionLayer", anLayer);
+        theEntity->mProperties.Set<Uint32>("uCollisionMask", mLayers.GetMask(anLayerName));
+      }
     }
   }
 
@@ -43,69 +98,88 @@ namespace GQE
 
   void ICollisionSystem::UpdateFixed()
   {
-    // Search through each z-order map to find theEntityID provided
+    mStats = CollisionStats();
+
+    // Search through each z-order map to update each IEntity and its proxy
     std::map<const Uint32, std::deque<IEntity*> >::iterator anIter;
-    std::vector<IEntity*>::iterator anMovablesIter;
-    anMovablesIter=mMovables.begin();
-    while(anMovablesIter!=mMovables.end())
-    {
-      IEntity* anMovableEntity=(*anMovablesIter);
-			sf::ConvexShape anMovingShape=anMovableEntity->mProperties.Get<sf::ConvexShape>("CollisionShape");
-      if (anMovingShape.getPointCount()>0)
-      {
-        anMovingShape.setPosition(anMovableEntity->mProperties.Get<sf::Vector2f>("vCollisionOffset") + anMovableEntity->mProperties.Get<sf::Vector2f>("vPosition") + anMovableEntity->mProperties.Get<sf::Vector2f>("vVelocity"));
-        anMovingShape.setRotation(anMovableEntity->mProperties.GetFloat("fRotation") + anMovableEntity->mProperties.GetFloat("fCollisionRotation"));
-        anMovingShape.setScale(anMovableEntity->mProperties.Get<sf::Vector2f>("vScale"));
-        sf::Vector2f anOrigin = anMovableEntity->mProperties.Get<sf::Vector2f>("vOrigin");
-        anOrigin.x *= anMovingShape.getGlobalBounds().width;
-        anOrigin.y *= anMovingShape.getGlobalBounds().height;
-        anMovingShape.setOrigin(anOrigin);
-        anIter = mEntities.begin();
-        while (anIter != mEntities.end())
+    anIter = mEntities.begin();
+    while(anIter != mEntities.end())
+    {
+      std::deque<IEntity*>::iterator anQueue = anIter->second.begin();
+      while(anQueue != anIter->second.end())
+      {
+        // Get the IEntity address first
+        GQE::IEntity* anEntity = *anQueue;
+
+        // Increment the IEntity iterator second
+        anQueue++;
+
+        EntityUpdateFixed(anEntity);
+
+        // Move the cached geometry to where the IEntity will be after this
+        // update and give its bounding box to our broadphase
+        CollisionCache& anCache = mCaches[anEntity->GetID()];
+        if(UpdateCollisionCache(anEntity, anCache))
         {
-          std::deque<IEntity*>::iterator anQueue = anIter->second.begin();
-          while (anQueue != anIter->second.end())
+          // Continuous colliders use the bounds of their whole sweep
+          sf::FloatRect anBounds = anCache.Bounds;
+          if(anCache.Sweep.x > 0.0f)
+          {
+            anBounds.left -= anCache.Sweep.x;
+          }
+          if(anCache.Sweep.y > 0.0f)
           {
-            // Get the IEntity address first
-            GQE::IEntity* anEntity = *anQueue;
-
-            // Increment the IEntity iterator second
-            anQueue++;
-
-            EntityUpdateFixed(anEntity);
-
-            sf::ConvexShape anOtherShape = anEntity->mProperties.Get<sf::ConvexShape>("CollisionShape");
-            if (anOtherShape.getPointCount()>0)
-            {
-              anOtherShape.setPosition(anEntity->mProperties.Get<sf::Vector2f>("vCollisionOffset") + anEntity->mProperties.Get<sf::Vector2f>("vPosition") + anEntity->mProperties.Get<sf::Vector2f>("vVelocity"));
-              anOtherShape.setRotation(anEntity->mProperties.GetFloat("fRotation") + anEntity->mProperties.GetFloat("fCollisionRotation"));
-              anOtherShape.setScale(anEntity->mProperties.Get<sf::Vector2f>("vScale"));
-              sf::Vector2f anOrigin = anEntity->mProperties.Get<sf::Vector2f>("vOrigin");
-              anOrigin.x *= anOtherShape.getGlobalBounds().width;
-              anOrigin.y *= anOtherShape.getGlobalBounds().height;
-              anOtherShape.setOrigin(anOrigin);
-              CollisionData anData;
-              //Make sure we aren't handling two of the same entity.
-              if (anEntity != anMovableEntity && anEntity->mProperties.GetBool("bSolid") && anMovableEntity->mProperties.GetBool("bSolid"))
-              {
-                if (Intersection(anMovingShape, anOtherShape, anData.MinimumTranslation))
-                {
-                  anData.MovingEntity = anMovableEntity;
-                  anData.OtherEntity = anEntity;
-                  EntityCollision(anData);
-                  anMovingShape.setPosition(anMovableEntity->mProperties.Get<sf::Vector2f>("vPosition"));
-                  anMovingShape.setRotation(anMovableEntity->mProperties.Get<float>("fRotation"));
-                  anMovingShape.setScale(anMovableEntity->mProperties.Get<sf::Vector2f>("vScale"));
-                }
-              }
-            }
-          } // while(anQueue != anIter->second.end())
-
-          // Increment map iterator
-          anIter++;
-
-        } //while(anIter != mEntities.end())
-        anMovablesIter++;
+            anBounds.top -= anCache.Sweep.y;
+          }
+          anBounds.width += anCache.Sweep.x < 0.0f ? -anCache.Sweep.x : anCache.Sweep.x;
+          anBounds.height += anCache.Sweep.y < 0.0f ? -anCache.Sweep.y : anCache.Sweep.y;
+          mBroadphase.UpdateProxy(anEntity, anBounds,
+              anEntity->mProperties.GetUint32("uCollisionLayer"),
+              anEntity->mProperties.GetUint32("uCollisionMask"));
+          mStats.Proxies++;
+        }
+        else
+        {
+          mBroadphase.DropProxy(anEntity);
+        }
+      } // while(anQueue != anIter->second.end())
+
+      // Increment map iterator
+      anIter++;
+    } //while(anIter != mEntities.end())
+
+    // Resort the broadphase and let the derived class know of any changes
+    mBroadphase.Update();
+    DispatchPairChanges();
+
+    // Only the pairs whose bounding boxes overlap need the narrowphase test
+    mUpdate++;
+    AddTests();
+    RunTests();
+    ExpireContacts();
+    mStats.Pairs = (Uint32)mBroadphase.GetPairs().size();
+    mStats.Tests = (Uint32)mTests.size();
+    mStats.Contacts = (Uint32)mContacts.size();
+
+    // Sort the contacts so the order never depends on the number of workers
+    std::sort(mContacts.begin(), mContacts.end(), CompareContacts);
+
+    // Deliver every contact on the main thread in sorted order
+    std::vector<CollisionData>::iterator anContact;
+    for(anContact = mContacts.begin(); anContact != mContacts.end(); ++anContact)
+    {
+      // A handler dropped one of the IEntity classes of this contact
+      if(anContact->MovingEntity == NULL || anContact->OtherEntity == NULL)
+      {
+        continue;
+      }
+      if(anContact->State == CONTACT_END)
+      {
+        EntityCollisionEnd(*anContact);
+      }
+      else
+      {
+        EntityCollision(*anContact);
       }
     }
   }
@@ -162,33 +236,763 @@ namespace GQE
 
   void ICollisionSystem::HandleCleanup(IEntity* theEntity)
   {
-    if (theEntity->mProperties.Get<bool>("bMovable"))
+    mMovables.erase(theEntity->GetID());
+    mCaches.erase(theEntity->GetID());
+
+    // End every contact theEntity is part of while it is still valid
+    std::map<const Uint64, ContactCache>::iterator anIter = mContactCache.begin();
+    while(anIter != mContactCache.end())
     {
-      GQE::Uint32 anRemovedIndex = 0;
-      bool anFound = false;
-      GQE::Uint32 anIndex;
-      for (anIndex = 0; anIndex != mMovables.size();++anIndex)
+      if(anIter->second.MovingEntity == theEntity || anIter->second.OtherEntity == theEntity)
       {
-        GQE::IEntity* anEntity = mMovables.at(anIndex);
-        if (anEntity->GetID() == theEntity->GetID())
+        if(anIter->second.Touching)
         {
-          anFound = true;
-          anRemovedIndex = anIndex;
+          CollisionData anData;
+          anData.MovingEntity = anIter->second.MovingEntity;
+          anData.OtherEntity = anIter->second.OtherEntity;
+          anData.MinimumTranslation = anIter->second.MinimumTranslation;
+          anData.State = CONTACT_END;
+          EntityCollisionEnd(anData);
         }
+        mContactCache.erase(anIter++);
+      }
+      else
+      {
+        anIter++;
       }
-      if(anFound)
-        mMovables.erase(mMovables.begin() + anRemovedIndex);
     }
+
+    // Contacts not delivered yet can't use theEntity once it is deleted
+    std::vector<CollisionData>::iterator anContact;
+    for(anContact = mContacts.begin(); anContact != mContacts.end(); ++anContact)
+    {
+      if(anContact->MovingEntity == theEntity || anContact->OtherEntity == theEntity)
+      {
+        anContact->MovingEntity = NULL;
+        anContact->OtherEntity = NULL;
+      }
+    }
+
+    // Remove theEntity from our broadphase while its pairs are still valid
+    mBroadphase.DropProxy(theEntity);
+    DispatchPairChanges();
   }
+
+  void ICollisionSystem::EntityCollisionEnd(CollisionData anCollisionData)
+  {
+    // Do nothing
+  }
+
+  void ICollisionSystem::HandlePairAdded(const CollisionPair& thePair)
+  {
+    // Do nothing
+  }
+
+  void ICollisionSystem::HandlePairRemoved(const CollisionPair& thePair)
+  {
+    // Do nothing
+  }
+
+  void ICollisionSystem::InvalidateCollisionShape(const IEntity* theEntity)
+  {
+    std::map<const typeEntityID, CollisionCache>::iterator anIter =
+      mCaches.find(theEntity->GetID());
+    if(anIter != mCaches.end())
+    {
+      anIter->second.Dirty = true;
+    }
+  }
+
+  bool ICollisionSystem::UpdateCollisionCache(IEntity* theEntity, CollisionCache& theCache)
+  {
+    sf::Vector2f anVelocity = theEntity->mProperties.Get<sf::Vector2f>("vVelocity");
+    sf::Vector2f anPosition = theEntity->mProperties.Get<sf::Vector2f>("vCollisionOffset") + theEntity->mProperties.Get<sf::Vector2f>("vPosition") + anVelocity;
+    float anRotation = theEntity->mProperties.GetFloat("fRotation") + theEntity->mProperties.GetFloat("fCollisionRotation");
+    sf::Vector2f anScale = theEntity->mProperties.Get<sf::Vector2f>("vScale");
+    sf::Vector2f anOrigin = theEntity->mProperties.Get<sf::Vector2f>("vOrigin");
+
+    // Continuous colliders are swept from where they start this update
+    theCache.Sweep = theEntity->mProperties.GetBool("bContinuous") ? anVelocity : sf::Vector2f(0.0f, 0.0f);
+
+    // Nothing to do if the transform is the same as the last update
+    if(!theCache.Dirty && anPosition == theCache.Position &&
+        anRotation == theCache.Rotation && anScale == theCache.Scale &&
+        anOrigin == theCache.Origin)
+    {
+      return COLLIDER_CIRCLE == theCache.Type ? theCache.Radius > 0.0f : !theCache.Points.empty();
+    }
+    theCache.Position = anPosition;
+    theCache.Rotation = anRotation;
+    theCache.Scale = anScale;
+    theCache.Origin = anOrigin;
+    theCache.Dirty = false;
+    theCache.Type = theEntity->mProperties.GetUint32("uColliderType");
+    theCache.Radius = 0.0f;
+    theCache.Points.clear();
+    theCache.PointsX.clear();
+    theCache.PointsY.clear();
+    theCache.Normals.clear();
+    theCache.Pieces.clear();
+
+    sf::ConvexShape anShape = theEntity->mProperties.Get<sf::ConvexShape>("CollisionShape");
+
+    // A shared PolygonShape replaces the CollisionShape of polygon colliders
+    PolygonShape* anPolygon = NULL;
+    if(COLLIDER_POLYGON == theCache.Type)
+    {
+      anPolygon = theEntity->mProperties.Get<PolygonShape*>("CollisionPolygon");
+      if(NULL != anPolygon && anPolygon->GetPieceCount() == 0)
+      {
+        return false;
+      }
+    }
+    if(NULL != anPolygon)
+    {
+      const std::vector<sf::Vector2f>& anOutline = anPolygon->GetPoints();
+      anShape.setPointCount(anOutline.size());
+      for(size_t anIndex = 0; anIndex < anOutline.size(); ++anIndex)
+      {
+        anShape.setPoint(anIndex, anOutline[anIndex]);
+      }
+    }
+    Uint32 anPointCount = anShape.getPointCount();
+    if(anPointCount == 0 && COLLIDER_CIRCLE != theCache.Type)
+    {
+      return false;
+    }
+    anShape.setPosition(anPosition);
+    anShape.setRotation(anRotation);
+    anShape.setScale(anScale);
+    anOrigin.x *= anShape.getGlobalBounds().width;
+    anOrigin.y *= anShape.getGlobalBounds().height;
+    anShape.setOrigin(anOrigin);
+
+    // Circles only need a center and a radius
+    if(COLLIDER_CIRCLE == theCache.Type)
+    {
+      float anRadius = theEntity->mProperties.GetFloat("fCollisionRadius");
+      theCache.Center = anPosition;
+      if(anPointCount > 0)
+      {
+        // Use the center of the CollisionShape and fit the radius to it
+        // if one wasn't provided
+        sf::FloatRect anLocal = anShape.getLocalBounds();
+        theCache.Center = anShape.getTransform().transformPoint(
+            anLocal.left + anLocal.width / 2.0f, anLocal.top + anLocal.height / 2.0f);
+        if(anRadius <= 0.0f)
+        {
+          anRadius = (anLocal.width > anLocal.height ? anLocal.width : anLocal.height) / 2.0f;
+        }
+      }
+      float anScaleX = anScale.x < 0.0f ? -anScale.x : anScale.x;
+      float anScaleY = anScale.y < 0.0f ? -anScale.y : anScale.y;
+      theCache.Radius = anRadius * (anScaleX > anScaleY ? anScaleX : anScaleY);
+      theCache.Bounds = sf::FloatRect(theCache.Center.x - theCache.Radius,
+          theCache.Center.y - theCache.Radius, theCache.Radius * 2.0f, theCache.Radius * 2.0f);
+      return theCache.Radius > 0.0f;
+    }
+
+    // Boxes ignore any rotation and keep the corners of the box as points
+    if(COLLIDER_AABB == theCache.Type)
+    {
+      anShape.setRotation(0.0f);
+      theCache.Bounds = anShape.getTransform().transformRect(anShape.getLocalBounds());
+      const sf::FloatRect& anBounds = theCache.Bounds;
+      theCache.Center = sf::Vector2f(anBounds.left + anBounds.width / 2.0f,
+          anBounds.top + anBounds.height / 2.0f);
+      theCache.Points.push_back(sf::Vector2f(anBounds.left, anBounds.top));
+      theCache.Points.push_back(sf::Vector2f(anBounds.left + anBounds.width, anBounds.top));
+      theCache.Points.push_back(sf::Vector2f(anBounds.left + anBounds.width, anBounds.top + anBounds.height));
+      theCache.Points.push_back(sf::Vector2f(anBounds.left, anBounds.top + anBounds.height));
+      theCache.Normals.push_back(sf::Vector2f(0.0f, -1.0f));
+      theCache.Normals.push_back(sf::Vector2f(1.0f, 0.0f));
+      theCache.Normals.push_back(sf::Vector2f(0.0f, 1.0f));
+      theCache.Normals.push_back(sf::Vector2f(-1.0f, 0.0f));
+      PadCollisionCache(theCache);
+      return true;
+    }
+
+    // Concave shapes are tested one convex piece at a time
+    if(NULL != anPolygon && !anPolygon->IsConvex())
+    {
+      BuildPolygonCache(anShape.getTransform(), anPolygon->GetPoints(), theCache);
+      theCache.Normals.clear();
+      theCache.Pieces.resize(anPolygon->GetPieceCount());
+      for(Uint32 anPiece = 0; anPiece < anPolygon->GetPieceCount(); ++anPiece)
+      {
+        BuildPolygonCache(anShape.getTransform(), anPolygon->GetPiece(anPiece),
+            theCache.Pieces[anPiece]);
+      }
+      return true;
+    }
+
+    // Transform each point into world space once for every pair test
+    std::vector<sf::Vector2f> anPoints;
+    if(NULL != anPolygon)
+    {
+      anPoints = anPolygon->GetPiece(0);
+    }
+    else
+    {
+      for(Uint32 anIndex = 0; anIndex < anPointCount; ++anIndex)
+      {
+        anPoints.push_back(anShape.getPoint(anIndex));
+      }
+    }
+    BuildPolygonCache(anShape.getTransform(), anPoints, theCache);
+    return true;
+  }
+
+  void ICollisionSystem::BuildPolygonCache(const sf::Transform& theTransform,
+      const std::vector<sf::Vector2f>& thePoints, CollisionCache& theCache)
+  {
+    theCache.Type = COLLIDER_POLYGON;
+    theCache.Points.clear();
+    theCache.Normals.clear();
+    Uint32 anPointCount = (Uint32)thePoints.size();
+    Uint32 anIndex;
+    for(anIndex = 0; anIndex < anPointCount; ++anIndex)
+    {
+      theCache.Points.push_back(theTransform.transformPoint(thePoints[anIndex]));
+    }
+
+    // Compute the unit normal of each edge, skipping any zero length edges
+    for(anIndex = 0; anIndex < anPointCount; ++anIndex)
+    {
+      const sf::Vector2f& anPointA = theCache.Points[anIndex];
+      const sf::Vector2f& anPointB = theCache.Points[(anIndex + 1) % anPointCount];
+      sf::Vector2f anEdge(anPointB.y - anPointA.y, -(anPointB.x - anPointA.x));
+      if(anEdge.x != 0.0f || anEdge.y != 0.0f)
+      {
+        theCache.Normals.push_back(NormalizeVector(anEdge));
+      }
+    }
+
+    // Last of all compute the world space bounding box
+    sf::Vector2f anMin = theCache.Points[0];
+    sf::Vector2f anMax = theCache.Points[0];
+    for(anIndex = 1; anIndex < anPointCount; ++anIndex)
+    {
+      const sf::Vector2f& anPoint = theCache.Points[anIndex];
+      anMin.x = anPoint.x < anMin.x ? anPoint.x : anMin.x;
+      anMin.y = anPoint.y < anMin.y ? anPoint.y : anMin.y;
+      anMax.x = anPoint.x > anMax.x ? anPoint.x : anMax.x;
+      anMax.y = anPoint.y > anMax.y ? anPoint.y : anMax.y;
+    }
+    theCache.Bounds = sf::FloatRect(anMin.x, anMin.y, anMax.x - anMin.x, anMax.y - anMin.y);
+    theCache.Center = sf::Vector2f(anMin.x + (anMax.x - anMin.x) / 2.0f,
+        anMin.y + (anMax.y - anMin.y) / 2.0f);
+
+    // Split the points into padded x and y arrays for the SIMD tests
+    PadCollisionCache(theCache);
+  }
+
+  Uint32 ICollisionSystem::QueryPoint(const sf::Vector2f& thePoint,
+      std::vector<CollisionHit>& theHits, const Uint32 theMask) const
+  {
+    return QueryAABB(sf::FloatRect(thePoint.x, thePoint.y, 0.0f, 0.0f), theHits, theMask);
+  }
+
+  Uint32 ICollisionSystem::QueryAABB(const sf::FloatRect& theRect,
+      std::vector<CollisionHit>& theHits, const Uint32 theMask) const
+  {
+    CollisionCache anQuery;
+    anQuery.Type = COLLIDER_AABB;
+    anQuery.Bounds = theRect;
+    anQuery.Center = sf::Vector2f(theRect.left + theRect.width / 2.0f,
+        theRect.top + theRect.height / 2.0f);
+    anQuery.Points.push_back(sf::Vector2f(theRect.left, theRect.top));
+    anQuery.Points.push_back(sf::Vector2f(theRect.left + theRect.width, theRect.top));
+    anQuery.Points.push_back(sf::Vector2f(theRect.left + theRect.width, theRect.top + theRect.height));
+    anQuery.Points.push_back(sf::Vector2f(theRect.left, theRect.top + theRect.height));
+    PadCollisionCache(anQuery);
+    return QueryCollider(anQuery, anQuery.Center, theHits, theMask);
+  }
+
+  Uint32 ICollisionSystem::QueryCircle(const sf::Vector2f& theCenter, const float theRadius,
+      std::vector<CollisionHit>& theHits, const Uint32 theMask) const
+  {
+    // A circle without a radius is the same as a point
+    if(theRadius <= 0.0f)
+    {
+      return QueryPoint(theCenter, theHits, theMask);
+    }
+    CollisionCache anQuery;
+    anQuery.Type = COLLIDER_CIRCLE;
+    anQuery.Center = theCenter;
+    anQuery.Radius = theRadius;
+    anQuery.Bounds = sf::FloatRect(theCenter.x - theRadius, theCenter.y - theRadius,
+        theRadius * 2.0f, theRadius * 2.0f);
+    return QueryCollider(anQuery, theCenter, theHits, theMask);
+  }
+
+  bool ICollisionSystem::RayCast(const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+      const float theMaxDistance, CollisionHit& theHit, const Uint32 theMask) const
+  {
+    if(theDirection.x == 0.0f && theDirection.y == 0.0f)
+    {
+      return false;
+    }
+    std::vector<CollisionHit> anHits;
+    RayCastCandidates(theOrigin, NormalizeVector(theDirection), theMaxDistance, anHits, theMask);
+    if(anHits.empty())
+    {
+      return false;
+    }
+    theHit = *std::min_element(anHits.begin(), anHits.end(), CompareHitDistances);
+    return true;
+  }
+
+  Uint32 ICollisionSystem::RayCastAll(const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+      const float theMaxDistance, std::vector<CollisionHit>& theHits, const Uint32 theMask) const
+  {
+    if(theDirection.x == 0.0f && theDirection.y == 0.0f)
+    {
+      return 0;
+    }
+    size_t anFirst = theHits.size();
+    RayCastCandidates(theOrigin, NormalizeVector(theDirection), theMaxDistance, theHits, theMask);
+    std::sort(theHits.begin() + anFirst, theHits.end(), CompareHitDistances);
+    return (Uint32)(theHits.size() - anFirst);
+  }
+
+  bool ICollisionSystem::CompareHitIDs(const CollisionHit& theFirst, const CollisionHit& theSecond)
+  {
+    return theFirst.EntityID < theSecond.EntityID;
+  }
+
+  bool ICollisionSystem::CompareHitDistances(const CollisionHit& theFirst, const CollisionHit& theSecond)
+  {
+    if(theFirst.Distance != theSecond.Distance)
+    {
+      return theFirst.Distance < theSecond.Distance;
+    }
+    return theFirst.EntityID < theSecond.EntityID;
+  }
+
+  Uint32 ICollisionSystem::QueryCollider(const CollisionCache& theQuery, const sf::Vector2f& thePoint,
+      std::vector<CollisionHit>& theHits, const Uint32 theMask) const
+  {
+    // Use the broadphase to find every IEntity whose bounding box overlaps
+    std::vector<IEntity*> anCandidates;
+    mBroadphase.QueryAABB(theQuery.Bounds, theMask, anCandidates);
+
+    size_t anFirst = theHits.size();
+    std::vector<IEntity*>::const_iterator anIter;
+    for(anIter = anCandidates.begin(); anIter != anCandidates.end(); ++anIter)
+    {
+      std::map<const typeEntityID, CollisionCache>::const_iterator anCache =
+        mCaches.find((*anIter)->GetID());
+      if(anCache == mCaches.end())
+      {
+        continue;
+      }
+
+      CollisionHit anHit;
+      sf::Vector2f anSeparatingAxis;
+      if(ColliderIntersection(theQuery, anCache->second, anHit.Normal, anSeparatingAxis))
+      {
+        anHit.EntityID = (*anIter)->GetID();
+        anHit.Entity = *anIter;
+        anHit.Point = thePoint;
+        anHit.Distance = sqrt(anHit.Normal.x*anHit.Normal.x + anHit.Normal.y*anHit.Normal.y);
+        if(anHit.Distance > 0.0f)
+        {
+          anHit.Normal /= anHit.Distance;
+        }
+        theHits.push_back(anHit);
+      }
+    }
+
+    // Return the hits in the same order every time
+    std::sort(theHits.begin() + anFirst, theHits.end(), CompareHitIDs);
+    return (Uint32)(theHits.size() - anFirst);
+  }
+
+  void ICollisionSystem::RayCastCandidates(const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+      const float theMaxDistance, std::vector<CollisionHit>& theHits, const Uint32 theMask) const
+  {
+    // Use the broadphase to find every IEntity near the ray
+    sf::Vector2f anEnd = theOrigin + theDirection * theMaxDistance;
+    sf::FloatRect anRect(theOrigin.x < anEnd.x ? theOrigin.x : anEnd.x,
+        theOrigin.y < anEnd.y ? theOrigin.y : anEnd.y,
+        theOrigin.x < anEnd.x ? anEnd.x - theOrigin.x : theOrigin.x - anEnd.x,
+        theOrigin.y < anEnd.y ? anEnd.y - theOrigin.y : theOrigin.y - anEnd.y);
+    std::vector<IEntity*> anCandidates;
+    mBroadphase.QueryAABB(anRect, theMask, anCandidates);
+
+    std::vector<IEntity*>::const_iterator anIter;
+    for(anIter = anCandidates.begin(); anIter != anCandidates.end(); ++anIter)
+    {
+      std::map<const typeEntityID, CollisionCache>::const_iterator anCache =
+        mCaches.find((*anIter)->GetID());
+      if(anCache == mCaches.end())
+      {
+        continue;
+      }
+
+      CollisionHit anHit;
+      if(ColliderRayCast(anCache->second, theOrigin, theDirection, theMaxDistance,
+            anHit.Distance, anHit.Normal))
+      {
+        anHit.EntityID = (*anIter)->GetID();
+        anHit.Entity = *anIter;
+        anHit.Point = theOrigin + theDirection * anHit.Distance;
+        theHits.push_back(anHit);
+      }
+    }
+  }
+
+  void ICollisionSystem::SetThreadCount(const Uint32 theThreadCount)
+  {
+    size_t anCount = theThreadCount < 1 ? 1 : theThreadCount;
+
+    // Remove any extra workers, waiting for their threads to finish
+    while(mWorkers.size() > anCount)
+    {
+      mWorkers.back()->Stop();
+      delete mWorkers.back();
+      mWorkers.pop_back();
+    }
+
+    // Add any missing workers, the first one always uses the main thread
+    while(mWorkers.size() < anCount)
+    {
+      NarrowphaseWorker* anWorker = new(std::nothrow) NarrowphaseWorker;
+      if(NULL == anWorker)
+      {
+        ELOG() << "ICollisionSystem::SetThreadCount(" << theThreadCount
+          << ") unable to create worker" << std::endl;
+        break;
+      }
+      anWorker->Tests = &mTests;
+      anWorker->Begin = 0;
+      anWorker->End = 0;
+      anWorker->Thread = NULL;
+      anWorker->Running = true;
+      anWorker->Started = false;
+      anWorker->Pending = false;
+      if(!mWorkers.empty())
+      {
+        anWorker->Thread = new(std::nothrow) sf::Thread(&NarrowphaseWorker::Process, anWorker);
+        if(NULL == anWorker->Thread)
+        {
+          ELOG() << "ICollisionSystem::SetThreadCount(" << theThreadCount
+            << ") unable to create thread" << std::endl;
+          delete anWorker;
+          break;
+        }
+
+        // Launch gives no result so wait a while for the thread to report in
+        anWorker->Thread->launch();
+        sf::Clock anClock;
+        bool anStarted = false;
+        while(!anStarted && anClock.getElapsedTime() < sf::seconds(1.0f))
+        {
+          {
+            sf::Lock anLock(anWorker->Mutex);
+            anStarted = anWorker->Started;
+          }
+          if(!anStarted)
+          {
+            sf::sleep(sf::microseconds(100));
+          }
+        }
+        if(!anStarted)
+        {
+          ELOG() << "ICollisionSystem::SetThreadCount(" << theThreadCount
+            << ") unable to start thread" << std::endl;
+          anWorker->Stop();
+          delete anWorker;
+          break;
+        }
+      }
+      mWorkers.push_back(anWorker);
+    }
+  }
+
+  Uint32 ICollisionSystem::GetThreadCount(void) const
+  {
+    return (Uint32)mWorkers.size();
+  }
+
+  const CollisionStats& ICollisionSystem::GetStats(void) const
+  {
+    return mStats;
+  }
+
+  void ICollisionSystem::NarrowphaseWorker::Process(void)
+  {
+    {
+      sf::Lock anLock(Mutex);
+      Started = true;
+    }
+
+    bool anRunning = true;
+    while(anRunning)
+    {
+      bool anPending;
+      {
+        sf::Lock anLock(Mutex);
+        anRunning = Running;
+        anPending = Pending;
+      }
+      if(anPending)
+      {
+        Run();
+        sf::Lock anLock(Mutex);
+        Pending = false;
+      }
+      else if(anRunning)
+      {
+        sf::sleep(sf::microseconds(100));
+      }
+    }
+  }
+
+  void ICollisionSystem::NarrowphaseWorker::Stop(void)
+  {
+    {
+      sf::Lock anLock(Mutex);
+      Running = false;
+    }
+
+    // Deleting the thread will wait for it to finish first
+    delete Thread;
+    Thread = NULL;
+  }
+
+  void ICollisionSystem::NarrowphaseWorker::Run(void)
+  {
+    Contacts.clear();
+    for(size_t anIndex = Begin; anIndex < End; ++anIndex)
+    {
+      const NarrowphaseTest& anTest = (*Tests)[anIndex];
+      ContactCache& anContact = *anTest.Contact;
+      CollisionData anData;
+      anData.MovingEntity = anTest.MovingEntity;
+      anData.OtherEntity = anTest.OtherEntity;
+      bool anIntersects = ColliderIntersection(*anTest.MovingCache, *anTest.OtherCache,
+            anData.MinimumTranslation, anContact.SeparatingAxis);
+
+      // A continuous collider that doesn't intersect where it ends might
+      // have passed through the other collider during this update
+      const sf::Vector2f& anSweep = anTest.MovingCache->Sweep;
+      if(!anIntersects && (anSweep.x != 0.0f || anSweep.y != 0.0f))
+      {
+        sf::Vector2f anNormal;
+        if(ColliderSweep(*anTest.MovingCache, anSweep, *anTest.OtherCache,
+              anData.TimeOfImpact, anNormal))
+        {
+          // Translate back along the contact normal to where they touched,
+          // or back along the sweep if they already touched at the start
+          if(anNormal.x != 0.0f || anNormal.y != 0.0f)
+          {
+            anData.MinimumTranslation = anNormal *
+              ((anSweep.x*anNormal.x + anSweep.y*anNormal.y) * (1.0f - anData.TimeOfImpact));
+          }
+          else
+          {
+            anData.MinimumTranslation = anSweep;
+          }
+          anContact.SeparatingAxis = sf::Vector2f(0.0f, 0.0f);
+          anIntersects = true;
+        }
+      }
+
+      if(anIntersects)
+      {
+        anData.State = anContact.Touching ? CONTACT_STAY : CONTACT_BEGIN;
+        anContact.MinimumTranslation = anData.MinimumTranslation;
+        anContact.Touching = true;
+        Contacts.push_back(anData);
+      }
+      else if(anContact.Touching)
+      {
+        anData.MinimumTranslation = anContact.MinimumTranslation;
+        anData.State = CONTACT_END;
+        anContact.Touching = false;
+        Contacts.push_back(anData);
+      }
+    }
+  }
+
+  bool ICollisionSystem::CompareContacts(const CollisionData& theFirst, const CollisionData& theSecond)
+  {
+    if(theFirst.MovingEntity->GetID() != theSecond.MovingEntity->GetID())
+    {
+      return theFirst.MovingEntity->GetID() < theSecond.MovingEntity->GetID();
+    }
+    return theFirst.OtherEntity->GetID() < theSecond.OtherEntity->GetID();
+  }
+
+  Uint64 ICollisionSystem::GetContactKey(const typeEntityID theMovingID, const typeEntityID theOtherID)
+  {
+    return ((Uint64)theMovingID << 32) | (Uint64)theOtherID;
+  }
+
+  void ICollisionSystem::AddTests(void)
+  {
+    mTests.clear();
+    const std::map<const Uint64, CollisionPair>& anPairs = mBroadphase.GetPairs();
+    std::map<const Uint64, CollisionPair>::const_iterator anPair;
+    for(anPair = anPairs.begin(); anPair != anPairs.end(); ++anPair)
+    {
+      IEntity* anFirst = anPair->second.First;
+      IEntity* anSecond = anPair->second.Second;
+      if(anFirst->mProperties.GetBool("bSolid") && anSecond->mProperties.GetBool("bSolid"))
+      {
+        // Test each movable IEntity of this pair against the other
+        if(mMovables.find(anFirst->GetID()) != mMovables.end())
+        {
+          AddTest(anFirst, anSecond);
+        }
+        if(mMovables.find(anSecond->GetID()) != mMovables.end())
+        {
+          AddTest(anSecond, anFirst);
+        }
+      }
+    }
+  }
+
+  void ICollisionSystem::AddTest(IEntity* theMovingEntity, IEntity* theOtherEntity)
+  {
+    // Find or create the contact on the main thread so each worker only
+    // writes to the contacts of its own tests
+    Uint64 anKey = GetContactKey(theMovingEntity->GetID(), theOtherEntity->GetID());
+    std::map<const Uint64, ContactCache>::iterator anIter = mContactCache.find(anKey);
+    if(anIter == mContactCache.end())
+    {
+      ContactCache anContact;
+      anContact.MovingEntity = theMovingEntity;
+      anContact.OtherEntity = theOtherEntity;
+      anContact.Touching = false;
+      anIter = mContactCache.insert(std::pair<const Uint64, ContactCache>(anKey, anContact)).first;
+    }
+    anIter->second.Update = mUpdate;
+
+    NarrowphaseTest anTest;
+    anTest.MovingEntity = theMovingEntity;
+    anTest.OtherEntity = theOtherEntity;
+    anTest.MovingCache = &mCaches[theMovingEntity->GetID()];
+    anTest.OtherCache = &mCaches[theOtherEntity->GetID()];
+    anTest.Contact = &anIter->second;
+    mTests.push_back(anTest);
+  }
+
+  void ICollisionSystem::RunTests(void)
+  {
+    // Only use as many workers as there are tests to keep them busy
+    size_t anWorkerCount = mTests.size() / MIN_TESTS_PER_THREAD;
+    if(anWorkerCount > mWorkers.size())
+    {
+      anWorkerCount = mWorkers.size();
+    }
+    if(anWorkerCount < 1)
+    {
+      anWorkerCount = 1;
+    }
+
+    // Give each worker an equal range of the tests
+    size_t anBegin = 0;
+    size_t anIndex;
+    for(anIndex = 0; anIndex < anWorkerCount; ++anIndex)
+    {
+      NarrowphaseWorker* anWorker = mWorkers[anIndex];
+      anWorker->Begin = anBegin;
+      anWorker->End = (mTests.size() * (anIndex + 1)) / anWorkerCount;
+      anBegin = anWorker->End;
+      if(NULL != anWorker->Thread)
+      {
+        sf::Lock anLock(anWorker->Mutex);
+        anWorker->Pending = true;
+      }
+    }
+
+    // The main thread performs the tests given to the first worker and to
+    // any worker without a thread
+    for(anIndex = 0; anIndex < anWorkerCount; ++anIndex)
+    {
+      if(NULL == mWorkers[anIndex]->Thread)
+      {
+        mWorkers[anIndex]->Run();
+      }
+    }
+
+    // Wait for the other workers and merge their contacts
+    mContacts.clear();
+    for(anIndex = 0; anIndex < anWorkerCount; ++anIndex)
+    {
+      NarrowphaseWorker* anWorker = mWorkers[anIndex];
+      bool anPending = NULL != anWorker->Thread;
+      while(anPending)
+      {
+        {
+          sf::Lock anLock(anWorker->Mutex);
+          anPending = anWorker->Pending;
+        }
+        if(anPending)
+        {
+          sf::sleep(sf::microseconds(100));
+        }
+      }
+      mContacts.insert(mContacts.end(), anWorker->Contacts.begin(), anWorker->Contacts.end());
+    }
+  }
+
+  void ICollisionSystem::ExpireContacts(void)
+  {
+    std::map<const Uint64, ContactCache>::iterator anIter = mContactCache.begin();
+    while(anIter != mContactCache.end())
+    {
+      if(anIter->second.Update != mUpdate)
+      {
+        // The broadphase no longer reports this pair so end any contact
+        if(anIter->second.Touching)
+        {
+          CollisionData anData;
+          anData.MovingEntity = anIter->second.MovingEntity;
+          anData.OtherEntity = anIter->second.OtherEntity;
+          anData.MinimumTranslation = anIter->second.MinimumTranslation;
+          anData.State = CONTACT_END;
+          mContacts.push_back(anData);
+        }
+        mContactCache.erase(anIter++);
+      }
+      else
+      {
+        anIter++;
+      }
+    }
+  }
+
+  void ICollisionSystem::DispatchPairChanges(void)
+  {
+    std::vector<CollisionPair>::const_iterator anIter;
+    for(anIter = mBroadphase.GetRemovedPairs().begin();
+        anIter != mBroadphase.GetRemovedPairs().end();
+        ++anIter)
+    {
+      HandlePairRemoved(*anIter);
+    }
+    for(anIter = mBroadphase.GetAddedPairs().begin();
+        anIter != mBroadphase.GetAddedPairs().end();
+        ++anIter)
+    {
+      HandlePairAdded(*anIter);
+    }
+    mBroadphase.ClearChanges();
+  }
+
   void ICollisionSystem::ProjectOntoAxis(const sf::Shape& theShape, const sf::Vector2f& theAxis, float& theMin, float& theMax)
-	{
-    sf::Vector2f anPoint=theShape.getTransform().transformPoint(theShape.getPoint(0));
+	{
+    sf::Vector2f anPoint=theShape.getTransform().transformPoint(theShape.getPoint(0));
   	GQE::Uint32 anPointCount=theShape.getPointCount();
 		theMin = (anPoint.x*theAxis.x+anPoint.y*theAxis.y);
 		theMax = theMin;
 		for (int j = 1; j<anPointCount; j++)
-		{
-			anPoint=theShape.getTransform().transformPoint(theShape.getPoint(j));
+		{
+			anPoint=theShape.getTransform().transformPoint(theShape.getPoint(j));
 			float Projection = (anPoint.x*theAxis.x+anPoint.y*theAxis.y);
 
 			if (Projection<theMin)
@@ -207,28 +1011,28 @@ namespace GQE
 		Uint32 anIndex;
 		sf::Vector2f anSmallestAxis;
 		double anOverlap=std::numeric_limits<double>::max();
-		Uint32 anMovingPointCount=theMovingShape.getPointCount();
-		Uint32 anOtherPointCount=theOtherShape.getPointCount();
-		sf::Vector2f anPointA, anPointB;
+		Uint32 anMovingPointCount=theMovingShape.getPointCount();
+		Uint32 anOtherPointCount=theOtherShape.getPointCount();
+		sf::Vector2f anPointA, anPointB;
 		//Axes for this object.
 		for(anIndex=0;anIndex<anMovingPointCount-1;++anIndex)
-		{
-      anPointA=theMovingShape.getPoint(anIndex);
+		{
+      anPointA=theMovingShape.getPoint(anIndex);
       anPointB=theMovingShape.getPoint(anIndex+1);
       anAxes.push_back(NormalizeVector(sf::Vector2f(anPointB.y - anPointA.y, -(anPointB.x - anPointA.x))));
 		}
-    anPointA=theMovingShape.getPoint(anMovingPointCount-1);
-    anPointB=theMovingShape.getPoint(0);
+    anPointA=theMovingShape.getPoint(anMovingPointCount-1);
+    anPointB=theMovingShape.getPoint(0);
 		anAxes.push_back(NormalizeVector(sf::Vector2f(anPointB.y - anPointA.y, -(anPointB.x - anPointA.x))));
 		//Axes for other object.
 		for(anIndex=0;anIndex<theOtherShape.getPointCount()-1;++anIndex)
-		{
-      anPointA=theOtherShape.getPoint(anIndex);
+		{
+      anPointA=theOtherShape.getPoint(anIndex);
       anPointB=theOtherShape.getPoint(anIndex+1);
       anAxes.push_back(NormalizeVector(sf::Vector2f(anPointB.y - anPointA.y, -(anPointB.x - anPointA.x))));
 		}
-    anPointA=theOtherShape.getPoint(anOtherPointCount-1);
-    anPointB=theOtherShape.getPoint(0);
+    anPointA=theOtherShape.getPoint(anOtherPointCount-1);
+    anPointB=theOtherShape.getPoint(0);
 		anAxes.push_back(NormalizeVector(sf::Vector2f(anPointB.y - anPointA.y, -(anPointB.x - anPointA.x))));
 		for(anIndex=0;anIndex<anAxes.size();++anIndex)
 		{
@@ -258,6 +1062,28 @@ namespace GQE
 		return true;
 	}
 
+  void ICollisionSystem::ProjectOntoAxis(const CollisionCache& theCache, const sf::Vector2f& theAxis, float& theMin, float& theMax)
+  {
+    const sf::Vector2f* anPoints = &theCache.Points[0];
+    size_t anPointCount = theCache.Points.size();
+    theMin = anPoints[0].x*theAxis.x + anPoints[0].y*theAxis.y;
+    theMax = theMin;
+    for(size_t anIndex = 1; anIndex < anPointCount; ++anIndex)
+    {
+      float anProjection = anPoints[anIndex].x*theAxis.x + anPoints[anIndex].y*theAxis.y;
+      if(anProjection < theMin)
+        theMin = anProjection;
+      if(anProjection > theMax)
+        theMax = anProjection;
+    }
+  }
+
+  bool ICollisionSystem::Intersection(const CollisionCache& theMovingCache, const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+    sf::Vector2f anSeparatingAxis;
+    return ColliderIntersection(theMovingCache, theOtherCache, theMinimumTranslation, anSeparatingAxis);
+  }
+
 } // namespace GQE
 
 /**
@@ -9,6 +9,7 @@
  * @date 20120620 - Drop ourselves from registered ISystem classes
  * @date 20120622 - Fix issues with dropping ISystem classes
  * @date 20121108 - Fix warning: type qualifiers ignored on function return type
+ * @date 20261018 - Add GetSystem to find a registered ISystem by its ID
  */
 #include <GQE/Entity/interfaces/IEntity.hpp>
 #include <GQE/Entity/interfaces/ISystem.hpp>
@@ -73,6 +74,18 @@ namespace GQE
     return anResult;
   }
 
+  ISystem* IEntity::GetSystem(const typeSystemID theSystemID) const
+  {
+    ISystem* anResult = NULL;
+    std::map<const typeSystemID, ISystem*>::const_iterator anIter =
+      mSystems.find(theSystemID);
+    if(anIter != mSystems.end())
+    {
+      anResult = anIter->second;
+    }
+    return anResult;
+  }
+
   void IEntity::DropSystem(const typeSystemID theSystemID)
   {
     // Iterator for looping through each registered ISystem
@@ -6,16 +6,30 @@
  * @date 20120623 - Initial Release
  * @date 20120904 - Fix SFML v1.6 issues with Vector2u
  * @date 20120910 - Fix SFML v1.6 issue with frame edge check
+ * @date 20261018 - Tell the RenderSystem about each rTextureRect change
+ * @date 20261018 - Share AnimationClip frames and evaluate every IEntity from one clock
+ * @date 20261018 - Give each frame change to RenderSystem::UpdateFrame
+ * @date 20261018 - Count fixed updates in a Uint64 and show frames between them in UpdateVariable
+ * @date 20261018 - Tell the RenderSystem of each IEntity about its new frame without SetRenderSystem
+ * @date 20261018 - Stop copying the clip and speed given to Play into the properties
  */
 
+#include <math.h>
 #include <SFML/System.hpp>
 #include <GQE/Entity/systems/AnimationSystem.hpp>
+#include <GQE/Entity/systems/RenderSystem.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
 
 namespace GQE
 {
+  /// Frame index used before an IEntity has shown any frame
+  static const Uint32 NO_FRAME = 0xFFFFFFFF;
+
   AnimationSystem::AnimationSystem(GQE::IApp& theApp) :
-    ISystem("AnimationSystem",theApp)
+    ISystem("AnimationSystem",theApp),
+    mRenderSystem(NULL),
+    mTicks(0),
+    mPartial(0.0f)
   {
   }
 
@@ -25,66 +39,176 @@ namespace GQE
 
   void AnimationSystem::AddProperties(IEntity* theEntity)
   {
-		theEntity->mProperties.Add<std::string>("sCurrentAnimation","DefaultAnimation");
-		theEntity->mProperties.Add<typeRectList>("DefaultAnimation",typeRectList());
-		theEntity->mProperties.Add<sf::Clock>("AnimationClock",sf::Clock());
-		theEntity->mProperties.Add<Uint32>("uFramesPerSecond",6);
-		theEntity->mProperties.Add<Uint32>("uCurrentFrame",0);
-	}
+    theEntity->mProperties.Add<Uint32>("uAnimationClip",0);
+    theEntity->mProperties.Add<float>("fAnimationSpeed",1.0f);
+  }
+
+  void AnimationSystem::SetRenderSystem(RenderSystem* theRenderSystem)
+  {
+    mRenderSystem = theRenderSystem;
+  }
+
+  typeClipID AnimationSystem::AddClip(const std::string theClipName,
+      const typeRectList& theFrames, float theFramesPerSecond, bool theLoop)
+  {
+    // Replace the frames of a clip that already uses theClipName
+    typeClipID anResult = GetClip(theClipName);
+    if(anResult == 0)
+    {
+      mClips.push_back(AnimationClip());
+      anResult = (typeClipID)mClips.size();
+    }
+    AnimationClip& anClip = mClips[anResult-1];
+    anClip.Name = theClipName;
+    anClip.Frames = theFrames;
+    anClip.FramesPerSecond = theFramesPerSecond;
+    anClip.Loop = theLoop;
+    return anResult;
+  }
+
+  typeClipID AnimationSystem::GetClip(const std::string theClipName) const
+  {
+    for(size_t anIndex = 0; anIndex < mClips.size(); anIndex++)
+    {
+      if(mClips[anIndex].Name == theClipName)
+      {
+        return (typeClipID)(anIndex + 1);
+      }
+    }
+    return 0;
+  }
+
+  void AnimationSystem::Play(IEntity* theEntity, const typeClipID theClipID, float theSpeed)
+  {
+    std::map<const typeEntityID, Uint32>::const_iterator anIndex =
+      mStateIndex.find(theEntity->GetID());
+    if(anIndex == mStateIndex.end())
+    {
+      WLOG() << "AnimationSystem::Play(" << theEntity->GetID()
+        << ") IEntity was not added" << std::endl;
+      return;
+    }
+    AnimationState& anState = mStates[anIndex->second];
+    anState.Clip = theClipID;
+    anState.Start = GetTime();
+    anState.Speed = theSpeed;
+    anState.Frame = NO_FRAME;
+  }
+
+  Uint32 AnimationSystem::GetFrame(const IEntity* theEntity) const
+  {
+    std::map<const typeEntityID, Uint32>::const_iterator anIndex =
+      mStateIndex.find(theEntity->GetID());
+    if(anIndex == mStateIndex.end() || mStates[anIndex->second].Frame == NO_FRAME)
+    {
+      return 0;
+    }
+    return mStates[anIndex->second].Frame;
+  }
+
+  double AnimationSystem::GetTime(void) const
+  {
+    return (double)mTicks / mApp.GetUpdateRate() + mPartial;
+  }
 
   void AnimationSystem::HandleInit(IEntity* theEntity)
   {
+    // Start the clip provided by the uAnimationClip property right away,
+    // these properties are never read again
+    AnimationState anState;
+    anState.Entity = theEntity;
+    anState.Clip = theEntity->mProperties.Get<Uint32>("uAnimationClip");
+    anState.Start = GetTime();
+    anState.Speed = theEntity->mProperties.Get<float>("fAnimationSpeed");
+    anState.Frame = NO_FRAME;
+    mStateIndex[theEntity->GetID()] = (Uint32)mStates.size();
+    mStates.push_back(anState);
   }
 
   void AnimationSystem::HandleEvents(sf::Event theEvent)
   {
   }
 
-  void AnimationSystem::EntityUpdateFixed(IEntity* theEntity)
+  void AnimationSystem::UpdateFixed(void)
   {
-    // Get the AnimationSystem properties
-		sf::Clock anClock=theEntity->mProperties.Get<sf::Clock>("AnimationClock");
-		Uint32 anFPS=theEntity->mProperties.GetUint32("uFramesPerSecond");
-		Uint32 anCurrentFrame=theEntity->mProperties.GetUint32("uCurrentFrame");
-		std::string anCurrentAnimation=theEntity->mProperties.GetString("sCurrentAnimation");
-		if(anClock.getElapsedTime().asMilliseconds()>1000/anFPS)
-		{
-			anClock.restart();
-			anCurrentFrame++;
-			typeRectList anAnimation= theEntity->mProperties.Get<typeRectList>(anCurrentAnimation);
-			if(anAnimation.size()>0)
-			{
-				if(anCurrentFrame>=anAnimation.size())
-				{
-					anCurrentFrame=0;
-				}
-				theEntity->mProperties.Set<sf::Clock>("AnimationClock",anClock);
-				theEntity->mProperties.SetUint32("uCurrentFrame",anCurrentFrame);
-			}
-		}
-	}
+    // The variable updates since the last fixed update are now part of it
+    mTicks++;
+    mPartial = 0.0f;
+    UpdateFrames();
+  }
+
   void AnimationSystem::UpdateVariable(float theElapsedTime)
   {
+    // Never run ahead of the next fixed update so the time never goes back
+    float anTickTime = 1.0f / mApp.GetUpdateRate();
+    mPartial += theElapsedTime;
+    if(mPartial >= anTickTime)
+    {
+      mPartial = anTickTime * 0.999f;
+    }
+    UpdateFrames();
   }
 
-  void AnimationSystem::EntityDraw(IEntity* theEntity)
+  void AnimationSystem::UpdateFrames(void)
   {
-		std::string anAnimationID=theEntity->mProperties.GetString("sCurrentAnimation");
-		if(anAnimationID!="")
-		{
-			typeRectList anAnimation=theEntity->mProperties.Get<typeRectList>(anAnimationID);
-			Uint32 anCurrentFrame=theEntity->mProperties.GetUint32("uCurrentFrame");
-			if(!anAnimation.empty() && anCurrentFrame<anAnimation.size())
-			{
-				sf::IntRect anTextureRect=anAnimation[anCurrentFrame];
-				theEntity->mProperties.Set<sf::IntRect>("rTextureRect",anTextureRect);
-			}
-		}
+    double anTime = GetTime();
+    std::vector<AnimationState>::iterator anState;
+    for(anState = mStates.begin(); anState != mStates.end(); ++anState)
+    {
+      if(anState->Clip == 0 || anState->Clip > mClips.size())
+      {
+        continue;
+      }
+      const AnimationClip& anClip = mClips[anState->Clip-1];
+      Uint32 anCount = (Uint32)anClip.Frames.size();
+      if(anCount == 0)
+      {
+        continue;
+      }
+
+      // Work out the frame from the time since the clip was started
+      double anFrames = (anTime - anState->Start) * anState->Speed * anClip.FramesPerSecond;
+      Uint32 anFrame = 0;
+      if(anFrames > 0.0 && anClip.Loop)
+      {
+        anFrame = (Uint32)fmod(anFrames, (double)anCount);
+      }
+      else if(anFrames > 0.0)
+      {
+        anFrame = anFrames >= anCount ? anCount - 1 : (Uint32)anFrames;
+      }
 
+      // Only touch the IEntity when it needs to show another frame
+      if(anFrame != anState->Frame)
+      {
+        anState->Frame = anFrame;
+        anState->Entity->mProperties.Set<sf::IntRect>("rTextureRect",anClip.Frames[anFrame]);
+        RenderSystem* anRenderSystem = mRenderSystem != NULL ?
+          mRenderSystem : RenderSystem::Find(anState->Entity);
+        if(anRenderSystem != NULL)
+        {
+          anRenderSystem->UpdateFrame(anState->Entity,anClip.Frames[anFrame]);
+        }
+      }
+    }
   }
 
   void AnimationSystem::HandleCleanup(GQE::IEntity* theEntity)
   {
+    // Move the last state into the place of the one being removed
+    std::map<const typeEntityID, Uint32>::iterator anIndex =
+      mStateIndex.find(theEntity->GetID());
+    if(anIndex != mStateIndex.end())
+    {
+      Uint32 anRemoved = anIndex->second;
+      mStateIndex.erase(anIndex);
+      if(anRemoved + 1 < mStates.size())
+      {
+        mStates[anRemoved] = mStates.back();
+        mStateIndex[mStates[anRemoved].Entity->GetID()] = anRemoved;
+      }
+      mStates.pop_back();
+    }
   }
 }
 
@@ -9,17 +9,55 @@
  * @date 20120623 - Improved documentation and adjusted some properties
  * @date 20130202 - Fix SFML v1.6 compiler issues
  * @date 20130822 - Changed property set up for render system. Sprites are now just vertexarrays with 6 points.
+ * @date 20261018 - Batch consecutive sprites sharing a texture and view
+ * @date 20261018 - Sort visible sprites by view, layer and texture with a radix sort
+ * @date 20261018 - Cull each view using a SpatialGrid of IEntity bounds
+ * @date 20261018 - Cache the vertices of each IEntity until its properties change
+ * @date 20261018 - Record each frame while the IApp render thread is running
+ * @date 20261018 - Draw each frame to IApp::GetRenderTarget
+ * @date 20261018 - Draw packed images from their ImageHandler TextureAtlas page
+ * @date 20261018 - Bake static IEntity classes into chunks drawn with one call each
+ * @date 20261018 - Only move the texture coordinates of IEntity classes given to UpdateFrame
+ * @date 20261018 - Take an EventContext in EventViewEntity and center the sView of the IEntity
+ * @date 20261018 - Find changed IEntity classes before each Draw unless SetDetectChanges is false
+ * @date 20261018 - Rebuild every IEntity after the TextureAtlas is built again
+ * @date 20261018 - Add Find and only compare IEntity classes against their cache if asked to
  */
+#include <algorithm>
+#include <cmath>
 #include <SFML/Graphics.hpp>
 #include <GQE/Entity/systems/RenderSystem.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
 
 namespace GQE
 {
+  /// Returns theVertex provided with theTransform applied to its position
+  static sf::Vertex TransformVertex(const sf::Vertex& theVertex,
+      const sf::Transform& theTransform)
+  {
+    sf::Vertex anResult=theVertex;
+    anResult.position=theTransform.transformPoint(theVertex.position);
+    return anResult;
+  }
+
+  /// Returns true if theFirst cache was added to the RenderSystem before theSecond
+  static bool CompareDepth(const RenderCache* theFirst, const RenderCache* theSecond)
+  {
+    return theFirst->Depth < theSecond->Depth;
+  }
+
   RenderSystem::RenderSystem(IApp& theApp):
-    ISystem("RenderSystem",theApp)
+    ISystem("RenderSystem",theApp),
+    mBatchTexture(NULL),
+    mImageHandler(NULL),
+    mAtlasGeneration(0),
+    mNextDepth(0),
+    mChunkSize(512.0f),
+    mViewIndex(0),
+    mTextureIndex(0),
+    mDetectChanges(false)
   {
-    theApp.mEventManager.Add<RenderSystem, PropertyManager>("ViewEntity", *this, &RenderSystem::EventViewEntity);
+    theApp.mEventManager.Add<RenderSystem, EventContext>("ViewEntity", *this, &RenderSystem::EventViewEntity);
   }
 
   RenderSystem::~RenderSystem()
@@ -35,10 +73,18 @@ namespace GQE
     theEntity->mProperties.Add<sf::Vector2f>("vOrigin",sf::Vector2f(0,0));
     theEntity->mProperties.Add<std::string>("sView","");
     theEntity->mProperties.Add<bool>("bVisible", true);
+    theEntity->mProperties.Add<bool>("bStatic", false);
   }
 
   void RenderSystem::HandleInit(IEntity* theEntity)
   {
+    // Add theEntity to the SpatialGrid of its view on the next Draw
+    RenderCache& anCache = mCaches[theEntity->GetID()];
+    anCache.Entity = theEntity;
+    anCache.View = theEntity->mProperties.GetString("sView");
+    anCache.Depth = mNextDepth++;
+    anCache.Dirty = true;
+    mDirty.push_back(theEntity->GetID());
   }
 
   void RenderSystem::EntityHandleEvents(IEntity* theEntity,sf::Event theEvent)
@@ -54,70 +100,786 @@ namespace GQE
   {
   }
 
+  void RenderSystem::Draw(void)
+  {
+    // Start each frame with an empty queue, the views might have changed
+    mQueue.clear();
+    mViewIDs.clear();
+    mViewRects.clear();
+    mTextures.clear();
+    mViewIndex = 0;
+    mTextureIndex = 0;
+    mViewCounts.clear();
+    mStats = RenderStats();
+
+    // Bring the cached vertices and SpatialGrid of each view up to date first
+    RefreshEntities();
+
+    // Only queue the IEntity classes each grid finds within its view
+    std::map<std::string, SpatialGrid>::const_iterator anGrid;
+    for(anGrid = mGrids.begin(); anGrid != mGrids.end(); ++anGrid)
+    {
+      sf::View anView=GetView(anGrid->first);
+      sf::Vector2f anViewSize=anView.getSize();
+      sf::Vector2f anViewPosition=anView.getCenter();
+      sf::FloatRect anViewRect(anViewPosition-sf::Vector2f(anViewSize.x/2,anViewSize.y/2),anViewSize);
+
+      mVisible.clear();
+      anGrid->second.QueryAABB(anViewRect, mVisible);
+      mStats.Candidates += (Uint32)mVisible.size();
+      std::vector<IEntity*>::const_iterator anEntity;
+      for(anEntity = mVisible.begin(); anEntity != mVisible.end(); ++anEntity)
+      {
+        EntityDraw(*anEntity);
+      }
+    }
+
+    // Whole chunks of static IEntity classes are culled and queued at once
+    std::map<RenderChunkKey, RenderChunk>::const_iterator anChunk;
+    for(anChunk = mChunks.begin(); anChunk != mChunks.end(); ++anChunk)
+    {
+      ChunkDraw(anChunk->first, anChunk->second);
+    }
+    mStats.Items = (Uint32)mQueue.size();
+    SortQueue();
+
+    // Walk the sorted queue and only change state when the key says so
+    IRenderTarget& anTarget = mApp.GetRenderTarget();
+    Uint32 anView = 0;
+    Uint32 anTexture = 0;
+    bool anFirst = true;
+    mBatch.clear();
+    std::vector<RenderItem>::const_iterator anItem;
+    for(anItem = mQueue.begin(); anItem != mQueue.end(); ++anItem)
+    {
+      if(anFirst || anItem->View != anView)
+      {
+        FlushBatch();
+        anTarget.SetView(GetView(mViewIDs[anItem->View]));
+        anView = anItem->View;
+        mStats.StateChanges++;
+      }
+      if(anFirst || anItem->Texture != anTexture)
+      {
+        FlushBatch();
+        mBatchTexture = mTextures[anItem->Texture];
+        anTexture = anItem->Texture;
+        mStats.StateChanges++;
+      }
+      anFirst = false;
+
+      if(anItem->Primitive == sf::Triangles)
+      {
+        mBatch.insert(mBatch.end(), anItem->Vertices, anItem->Vertices + anItem->Count);
+      }
+      else
+      {
+        // Points and lines can't be batched with triangles, draw them now
+        FlushBatch();
+        anTarget.Draw(anItem->Vertices,anItem->Count,
+            (sf::PrimitiveType)anItem->Primitive,mBatchTexture);
+        mStats.DrawCalls++;
+      }
+    }
+
+    // Submit the last run
+    FlushBatch();
+
+    // Provide this frame's statistics to the StatManager
+    mApp.mStatManager.SetStat("Render items", mStats.Items);
+    mApp.mStatManager.SetStat("Render draw calls", mStats.DrawCalls);
+    mApp.mStatManager.SetStat("Render state changes", mStats.StateChanges);
+    mApp.mStatManager.SetStat("Render chunks", mStats.Chunks);
+    for(size_t anIndex = 0; anIndex < mViewIDs.size(); anIndex++)
+    {
+      mApp.mStatManager.SetStat(mViewIDs[anIndex].empty() ? "Render visible" :
+        "Render visible " + mViewIDs[anIndex], mViewCounts[anIndex]);
+    }
+  }
+
   void RenderSystem::EntityDraw(IEntity* theEntity)
   {
+    if(theEntity == NULL)
+    {
+      return;
+    }
+
+    // Only the cached values are used here, see RefreshEntities
+    std::map<const typeEntityID, RenderCache>::const_iterator anIter=
+      mCaches.find(theEntity->GetID());
+    if(anIter == mCaches.end())
+    {
+      return;
+    }
+    const RenderCache& anCache=anIter->second;
+
+    // See if this IEntity is visible, if so add it to the queue now
+    if(anCache.Visible && anCache.Texture!=NULL && !anCache.World.empty())
+    {
+      SelectView(anCache.View);
+
+      // This code ensures that offscreen entities will not be rendered
+      if(!mViewRects[mViewIndex].intersects(anCache.Bounds))
+      {
+        return;
+      }
+
+      SelectTexture(anCache.Texture);
+      QueueItem(&anCache.World[0],(Uint32)anCache.World.size(),anCache.Primitive,
+          theEntity->GetOrder(),anCache.Depth);
+      mViewCounts[mViewIndex]++;
+    } // if(anCache.Visible)
+  }
+
+  void RenderSystem::ChunkDraw(const RenderChunkKey& theKey, const RenderChunk& theChunk)
+  {
+    if(theKey.Texture==NULL || theChunk.Vertices.empty())
+    {
+      return;
+    }
+
+    // The whole chunk is skipped if none of it is within its view
+    SelectView(theKey.View);
+    if(!mViewRects[mViewIndex].intersects(theChunk.Bounds))
+    {
+      return;
+    }
+
+    SelectTexture(theKey.Texture);
+    QueueItem(&theChunk.Vertices[0],(Uint32)theChunk.Vertices.size(),sf::Triangles,
+        theKey.Layer,theChunk.Depth);
+    mViewCounts[mViewIndex]+=theChunk.Visible;
+    mStats.Chunks++;
+  }
+
+  void RenderSystem::SetChunkSize(float theChunkSize)
+  {
+    if(theChunkSize <= 0.0f || theChunkSize == mChunkSize)
+    {
+      return;
+    }
+    mChunkSize = theChunkSize;
+
+    // Every static IEntity needs to find its new chunk
+    std::map<const typeEntityID, RenderCache>::iterator anCache;
+    for(anCache = mCaches.begin(); anCache != mCaches.end(); ++anCache)
+    {
+      if(anCache->second.Static)
+      {
+        UpdateEntity(anCache->second.Entity);
+      }
+    }
+  }
+
+  float RenderSystem::GetChunkSize(void) const
+  {
+    return mChunkSize;
+  }
+
+  const RenderStats& RenderSystem::GetStats(void) const
+  {
+    return mStats;
+  }
+
+  Uint32 RenderSystem::GetVisibleCount(const std::string theViewID) const
+  {
+    for(size_t anIndex = 0; anIndex < mViewIDs.size(); anIndex++)
+    {
+      if(mViewIDs[anIndex] == theViewID)
+      {
+        return mViewCounts[anIndex];
+      }
+    }
+    return 0;
+  }
+
+  void RenderSystem::SetDetectChanges(bool theDetectChanges)
+  {
+    mDetectChanges = theDetectChanges;
+  }
+
+  bool RenderSystem::GetDetectChanges(void) const
+  {
+    return mDetectChanges;
+  }
+
+  void RenderSystem::UpdateEntity(IEntity* theEntity)
+  {
+    std::map<const typeEntityID, RenderCache>::iterator anCache=
+      mCaches.find(theEntity->GetID());
+
+    // Only note each IEntity once per frame
+    if(anCache != mCaches.end() && !anCache->second.Dirty)
+    {
+      anCache->second.Dirty = true;
+      mDirty.push_back(theEntity->GetID());
+    }
+  }
+
+  RenderSystem* RenderSystem::Find(const IEntity* theEntity)
+  {
+    return dynamic_cast<RenderSystem*>(theEntity->GetSystem("RenderSystem"));
+  }
+
+  void RenderSystem::UpdateFrame(IEntity* theEntity, const sf::IntRect& theTextureRect)
+  {
+    mFrames.push_back(std::make_pair(theEntity->GetID(), theTextureRect));
+  }
+
+  void RenderSystem::RefreshEntities(void)
+  {
+    // The ImageHandler is only needed to find packed images
+    if(NULL == mImageHandler && (!mDirty.empty() || !mFrames.empty() ||
+          (mDetectChanges && !mCaches.empty())))
+    {
+      mImageHandler = dynamic_cast<ImageHandler*>(&mApp.mAssetManager.GetHandler<sf::Texture>());
+    }
+
+    // The pages of an earlier TextureAtlas build are gone, so rebuild the
+    // local vertices of every IEntity to find its Texture and region again
+    if(NULL != mImageHandler && mImageHandler->GetAtlas().GetGeneration() != mAtlasGeneration)
+    {
+      mAtlasGeneration = mImageHandler->GetAtlas().GetGeneration();
+      std::map<const typeEntityID, RenderCache>::iterator anCache;
+      for(anCache = mCaches.begin(); anCache != mCaches.end(); ++anCache)
+      {
+        anCache->second.Local.clear();
+        UpdateEntity(anCache->second.Entity);
+      }
+    }
+
+    // Frame changes are handled first since some of them may still need the
+    // full rebuild done below
+    RefreshFrames();
+
+    // Find the IEntity classes changed without a call to UpdateEntity
+    if(mDetectChanges)
+    {
+      DetectChanges();
+    }
+
+    std::vector<typeEntityID>::const_iterator anID;
+    for(anID = mDirty.begin(); anID != mDirty.end(); ++anID)
+    {
+      // Skip any IEntity dropped since it was noted
+      std::map<const typeEntityID, RenderCache>::iterator anCache=mCaches.find(*anID);
+      if(anCache == mCaches.end() || !anCache->second.Dirty)
+      {
+        continue;
+      }
+      RenderCache& anRenderCache = anCache->second;
+      anRenderCache.Dirty = false;
+      RefreshEntity(anRenderCache);
+
+      // A static IEntity is baked into the chunk holding its center instead
+      // of being kept in the SpatialGrid of its view
+      IEntity* anEntity = anRenderCache.Entity;
+      std::string anViewID = anEntity->mProperties.GetString("sView");
+      bool anStatic = anEntity->mProperties.Get<bool>("bStatic") &&
+        anRenderCache.Primitive == sf::Triangles;
+      RenderChunkKey anKey;
+      if(anStatic)
+      {
+        const sf::FloatRect& anBounds = anRenderCache.Bounds;
+        anKey.View = anViewID;
+        anKey.Layer = anEntity->GetOrder();
+        anKey.Texture = anRenderCache.Texture;
+        anKey.X = (Int32)std::floor((anBounds.left + anBounds.width/2) / mChunkSize);
+        anKey.Y = (Int32)std::floor((anBounds.top + anBounds.height/2) / mChunkSize);
+      }
+
+      // Leave the chunk or grid theEntity was in if it belongs elsewhere now
+      if(anRenderCache.Static && !(anStatic && anKey == anRenderCache.Chunk))
+      {
+        LeaveChunk(anRenderCache);
+      }
+      else if(!anRenderCache.Static && (anStatic || anViewID != anRenderCache.View))
+      {
+        std::map<std::string, SpatialGrid>::iterator anGrid=mGrids.find(anRenderCache.View);
+        if(anGrid != mGrids.end())
+        {
+          anGrid->second.DropProxy(anEntity);
+        }
+      }
+      anRenderCache.View = anViewID;
+
+      if(anStatic)
+      {
+        JoinChunk(anRenderCache, anKey);
+      }
+      else
+      {
+        mGrids[anViewID].UpdateProxy(anEntity, anRenderCache.Bounds);
+      }
+    }
+    mDirty.clear();
+
+    // Only the chunks whose members changed are baked again
+    BakeChunks();
+  }
+
+  void RenderSystem::DetectChanges(void)
+  {
+    std::map<const typeEntityID, RenderCache>::iterator anCache;
+    for(anCache = mCaches.begin(); anCache != mCaches.end(); ++anCache)
+    {
+      // Static IEntity classes must be given to UpdateEntity so they keep
+      // costing nothing per frame
+      const RenderCache& anRenderCache = anCache->second;
+      if(anRenderCache.Dirty || anRenderCache.Static)
+      {
+        continue;
+      }
+
+      // Only a change between a sprite and a custom VertexArray is found,
+      // changing the vertices of a VertexArray still needs UpdateEntity
+      PropertyManager& anProperties = anRenderCache.Entity->mProperties;
+      if(anProperties.Get<sf::Vector2f>("vPosition") != anRenderCache.Position ||
+          anProperties.Get<float>("fRotation") != anRenderCache.Rotation ||
+          anProperties.Get<sf::Vector2f>("vScale") != anRenderCache.Scale ||
+          anProperties.Get<sf::Vector2f>("vOrigin") != anRenderCache.Origin ||
+          anProperties.Get<sf::Texture*>("Texture") != anRenderCache.Source ||
+          anProperties.Get<sf::IntRect>("rTextureRect") != anRenderCache.TextureRect ||
+          anProperties.Get<sf::Color>("cColor") != anRenderCache.Color ||
+          anProperties.Get<bool>("bVisible") != anRenderCache.Visible ||
+          (anProperties.Get<sf::VertexArray>("VertexArray").getVertexCount() != 0) !=
+            anRenderCache.Custom ||
+          anProperties.GetString("sView") != anRenderCache.View ||
+          (anProperties.Get<bool>("bStatic") && anRenderCache.Primitive == sf::Triangles))
+      {
+        UpdateEntity(anRenderCache.Entity);
+      }
+    }
+  }
+
+  void RenderSystem::JoinChunk(RenderCache& theCache, const RenderChunkKey& theKey)
+  {
+    RenderChunk& anChunk = mChunks[theKey];
+    if(!theCache.Static)
+    {
+      anChunk.Members.push_back(theCache.Entity->GetID());
+      theCache.Static = true;
+      theCache.Chunk = theKey;
+    }
+    anChunk.Dirty = true;
+  }
+
+  void RenderSystem::LeaveChunk(RenderCache& theCache)
+  {
+    std::map<RenderChunkKey, RenderChunk>::iterator anChunk=mChunks.find(theCache.Chunk);
+    if(anChunk != mChunks.end())
+    {
+      std::vector<typeEntityID>& anMembers = anChunk->second.Members;
+      anMembers.erase(std::remove(anMembers.begin(), anMembers.end(),
+            theCache.Entity->GetID()), anMembers.end());
+      if(anMembers.empty())
+      {
+        mChunks.erase(anChunk);
+      }
+      else
+      {
+        anChunk->second.Dirty = true;
+      }
+    }
+    theCache.Static = false;
+  }
+
+  void RenderSystem::BakeChunks(void)
+  {
+    std::map<RenderChunkKey, RenderChunk>::iterator anChunk;
+    for(anChunk = mChunks.begin(); anChunk != mChunks.end(); ++anChunk)
+    {
+      RenderChunk& anRenderChunk = anChunk->second;
+      if(!anRenderChunk.Dirty)
+      {
+        continue;
+      }
+      anRenderChunk.Dirty = false;
+
+      // Bake the members in the order they were added so they overlap the
+      // same way they would if each was drawn on its own
+      mBakeOrder.clear();
+      std::vector<typeEntityID>::const_iterator anID;
+      for(anID = anRenderChunk.Members.begin(); anID != anRenderChunk.Members.end(); ++anID)
+      {
+        std::map<const typeEntityID, RenderCache>::const_iterator anCache=mCaches.find(*anID);
+        if(anCache != mCaches.end())
+        {
+          mBakeOrder.push_back(&anCache->second);
+        }
+      }
+      std::sort(mBakeOrder.begin(), mBakeOrder.end(), CompareDepth);
+
+      anRenderChunk.Vertices.clear();
+      anRenderChunk.Visible = 0;
+      std::vector<const RenderCache*>::const_iterator anMember;
+      for(anMember = mBakeOrder.begin(); anMember != mBakeOrder.end(); ++anMember)
+      {
+        const sf::FloatRect& anBounds = (*anMember)->Bounds;
+        if(anMember == mBakeOrder.begin())
+        {
+          anRenderChunk.Depth = (*anMember)->Depth;
+          anRenderChunk.Bounds = anBounds;
+        }
+        else
+        {
+          float anLeft = std::min(anRenderChunk.Bounds.left, anBounds.left);
+          float anTop = std::min(anRenderChunk.Bounds.top, anBounds.top);
+          float anRight = std::max(anRenderChunk.Bounds.left + anRenderChunk.Bounds.width,
+              anBounds.left + anBounds.width);
+          float anBottom = std::max(anRenderChunk.Bounds.top + anRenderChunk.Bounds.height,
+              anBounds.top + anBounds.height);
+          anRenderChunk.Bounds = sf::FloatRect(anLeft, anTop, anRight - anLeft, anBottom - anTop);
+        }
+        if((*anMember)->Visible)
+        {
+          anRenderChunk.Vertices.insert(anRenderChunk.Vertices.end(),
+              (*anMember)->World.begin(), (*anMember)->World.end());
+          anRenderChunk.Visible++;
+        }
+      }
+    }
+  }
+
+  void RenderSystem::RefreshFrames(void)
+  {
+    std::vector<std::pair<typeEntityID, sf::IntRect> >::const_iterator anFrame;
+    for(anFrame = mFrames.begin(); anFrame != mFrames.end(); ++anFrame)
+    {
+      // Skip any IEntity dropped since and any that will be rebuilt anyway
+      std::map<const typeEntityID, RenderCache>::iterator anCache=mCaches.find(anFrame->first);
+      if(anCache == mCaches.end() || anCache->second.Dirty)
+      {
+        continue;
+      }
+      RenderCache& anRenderCache = anCache->second;
+      const sf::IntRect& anRect = anFrame->second;
+      if(anRect == anRenderCache.TextureRect)
+      {
+        continue;
+      }
 
-		if(theEntity!=NULL)
-		{
-			std::string anCurrentViewID=theEntity->mProperties.GetString("sView");
-			const sf::View& anCurrentView=GetView(anCurrentViewID);
-      mApp.mWindow.setView(anCurrentView);
-			sf::Vector2f anViewSize=anCurrentView.getSize();
-			sf::Vector2f anViewPosition=anCurrentView.getCenter();
-			sf::FloatRect anViewRect(anViewPosition-sf::Vector2f(anViewSize.x/2,anViewSize.y/2),anViewSize);
-			sf::Texture* anTexture=theEntity->mProperties.Get<sf::Texture*>("Texture");
-			// See if this IEntity is visible, if so draw it now
-			if(theEntity->mProperties.Get<bool>("bVisible") && anTexture!=NULL)
-			{
-				// Get the other RenderSystem properties now
-				sf::Transformable anTransformable;
-				sf::RenderStates anRenderStates;
-				sf::VertexArray anVertexArray=theEntity->mProperties.Get<sf::VertexArray>("VertexArray");
-
-				sf::Color anColor=theEntity->mProperties.Get<sf::Color>("cColor");
-				sf::FloatRect anRect=sf::FloatRect(theEntity->mProperties.Get<sf::IntRect>("rTextureRect"));
-				sf::Vector2f anOrigin=theEntity->mProperties.Get<sf::Vector2f>("vOrigin");
-				anTransformable.setPosition(theEntity->mProperties.Get<sf::Vector2f>("vPosition"));
-				anTransformable.setRotation(theEntity->mProperties.Get<float>("fRotation"));
-				anTransformable.setScale(theEntity->mProperties.Get<sf::Vector2f>("vScale"));
-
-				if(anRect.width==0)
-				{
-					anRect.width=(float)anTexture->getSize().x;
-				}
-				if(anRect.height==0)
-				{
-          anRect.height=(float)anTexture->getSize().y;
-				}
-				//if vertex array is empty. default to a sprite( four verties).
-				if(anVertexArray.getVertexCount()==0)
-				{
-					anVertexArray.setPrimitiveType(sf::TrianglesStrip);
-					anVertexArray.append(sf::Vertex(sf::Vector2f(0,0),anColor,sf::Vector2f(anRect.left,anRect.top)));
-					anVertexArray.append(sf::Vertex(sf::Vector2f(0,anRect.height),anColor,sf::Vector2f(anRect.left,anRect.top+anRect.height)));
-					anVertexArray.append(sf::Vertex(sf::Vector2f(anRect.width,0),anColor,sf::Vector2f(anRect.left+anRect.width,anRect.top)));
-					anVertexArray.append(sf::Vertex(sf::Vector2f(anRect.width,anRect.height),anColor,sf::Vector2f(anRect.left+anRect.width,anRect.top+anRect.height)));
-
-				}
-				sf::FloatRect anBounds=anVertexArray.getBounds();
-				anBounds.left+=anTransformable.getPosition().x;
-				anBounds.top+=anTransformable.getPosition().y;
-				anTransformable.setOrigin(sf::Vector2f(anOrigin.x*anRect.width,anOrigin.y*anRect.height));
-				//This code ensures that offscreen entities will not be renderd.
-				if(anViewRect.intersects(anBounds))
-				{
-					anRenderStates.texture=anTexture;
-					anRenderStates.transform=anTransformable.getTransform();
-					anRenderStates.shader=NULL;//TODO Add back Shader Support.
-					mApp.mWindow.draw(anVertexArray,anRenderStates);
-				}
-			} // if(theEntity->mProperties.Get<bool>("bVisible"))
-		}
+      // Only a frame of the same size using the same texture can be shown by
+      // moving the texture coordinates, anything else is rebuilt in full
+      bool anMove = !anRenderCache.Custom && !anRenderCache.Local.empty() &&
+        anRect.width == anRenderCache.TextureRect.width &&
+        anRect.height == anRenderCache.TextureRect.height &&
+        anRect.width != 0 && anRect.height != 0;
+      if(anMove && anRenderCache.Texture != anRenderCache.Source)
+      {
+        const sf::Texture* anPage = NULL;
+        sf::IntRect anRegion;
+        anMove = NULL != mImageHandler &&
+          mImageHandler->GetAtlasRegion(anRenderCache.Source,anPage,anRegion) &&
+          anPage == anRenderCache.Texture && anRect.left >= 0 && anRect.top >= 0 &&
+          anRect.left+anRect.width <= anRegion.width &&
+          anRect.top+anRect.height <= anRegion.height;
+      }
+      if(!anMove)
+      {
+        UpdateEntity(anRenderCache.Entity);
+        continue;
+      }
+
+      sf::Vector2f anOffset((float)(anRect.left-anRenderCache.TextureRect.left),
+          (float)(anRect.top-anRenderCache.TextureRect.top));
+      for(size_t anIndex=0; anIndex<anRenderCache.Local.size(); anIndex++)
+      {
+        anRenderCache.Local[anIndex].texCoords+=anOffset;
+        anRenderCache.World[anIndex].texCoords+=anOffset;
+      }
+      anRenderCache.TextureRect=anRect;
+
+      // The chunk holding a static IEntity has its own copy of the vertices
+      if(anRenderCache.Static)
+      {
+        JoinChunk(anRenderCache, anRenderCache.Chunk);
+      }
+    }
+    mFrames.clear();
+  }
+
+  void RenderSystem::RefreshEntity(RenderCache& theCache)
+  {
+    IEntity* anEntity=theCache.Entity;
+    const sf::Texture* anSource=anEntity->mProperties.Get<sf::Texture*>("Texture");
+    sf::IntRect anTextureRect=anEntity->mProperties.Get<sf::IntRect>("rTextureRect");
+    sf::Color anColor=anEntity->mProperties.Get<sf::Color>("cColor");
+    sf::VertexArray anVertexArray=anEntity->mProperties.Get<sf::VertexArray>("VertexArray");
+    theCache.Visible=anEntity->mProperties.Get<bool>("bVisible");
+
+    // Only rebuild the local vertices if something they depend on changed,
+    // a custom VertexArray can't be compared cheaply so it is always rebuilt
+    if(anVertexArray.getVertexCount()!=0 || theCache.Custom ||
+        theCache.Local.empty() || anSource!=theCache.Source ||
+        anTextureRect!=theCache.TextureRect || anColor!=theCache.Color)
+    {
+      sf::FloatRect anRect=sf::FloatRect(anTextureRect);
+      if(anRect.width==0 && anSource!=NULL)
+      {
+        anRect.width=(float)anSource->getSize().x;
+      }
+      if(anRect.height==0 && anSource!=NULL)
+      {
+        anRect.height=(float)anSource->getSize().y;
+      }
+
+      // Draw from the TextureAtlas page holding the image if it was packed,
+      // unless rTextureRect reaches outside of the image (e.g. to repeat it)
+      const sf::Texture* anTexture=anSource;
+      const sf::Texture* anPage=NULL;
+      sf::IntRect anRegion;
+      if(NULL != mImageHandler && anVertexArray.getVertexCount()==0 &&
+          mImageHandler->GetAtlasRegion(anSource,anPage,anRegion) &&
+          anRect.left>=0 && anRect.top>=0 &&
+          anRect.left+anRect.width<=anRegion.width &&
+          anRect.top+anRect.height<=anRegion.height)
+      {
+        anTexture=anPage;
+      }
+      else
+      {
+        anRegion=sf::IntRect(0,0,0,0);
+      }
+      theCache.Source=anSource;
+      theCache.Texture=anTexture;
+      theCache.TextureRect=anTextureRect;
+      theCache.Color=anColor;
+      theCache.Size=sf::Vector2f(anRect.width,anRect.height);
+      theCache.Custom=anVertexArray.getVertexCount()!=0;
+      theCache.Local.clear();
+
+      //if vertex array is empty. default to a sprite (two triangles).
+      if(!theCache.Custom)
+      {
+        float anLeft=anRect.left+anRegion.left;
+        float anTop=anRect.top+anRegion.top;
+        sf::Vertex anTopLeft(sf::Vector2f(0,0),anColor,
+            sf::Vector2f(anLeft,anTop));
+        sf::Vertex anTopRight(sf::Vector2f(anRect.width,0),anColor,
+            sf::Vector2f(anLeft+anRect.width,anTop));
+        sf::Vertex anBottomLeft(sf::Vector2f(0,anRect.height),anColor,
+            sf::Vector2f(anLeft,anTop+anRect.height));
+        sf::Vertex anBottomRight(sf::Vector2f(anRect.width,anRect.height),anColor,
+            sf::Vector2f(anLeft+anRect.width,anTop+anRect.height));
+        theCache.Local.push_back(anTopLeft);
+        theCache.Local.push_back(anBottomLeft);
+        theCache.Local.push_back(anTopRight);
+        theCache.Local.push_back(anTopRight);
+        theCache.Local.push_back(anBottomLeft);
+        theCache.Local.push_back(anBottomRight);
+        theCache.Primitive=sf::Triangles;
+        theCache.LocalBounds=sf::FloatRect(0,0,anRect.width,anRect.height);
+      }
+      else
+      {
+        theCache.Primitive=AppendVertices(anVertexArray, theCache.Local);
+        theCache.LocalBounds=anVertexArray.getBounds();
+      }
+    }
+
+    // The world vertices change every time the IEntity moves
+    theCache.Position=anEntity->mProperties.Get<sf::Vector2f>("vPosition");
+    theCache.Rotation=anEntity->mProperties.Get<float>("fRotation");
+    theCache.Scale=anEntity->mProperties.Get<sf::Vector2f>("vScale");
+    theCache.Origin=anEntity->mProperties.Get<sf::Vector2f>("vOrigin");
+    sf::Transformable anTransformable;
+    anTransformable.setPosition(theCache.Position);
+    anTransformable.setRotation(theCache.Rotation);
+    anTransformable.setScale(theCache.Scale);
+    anTransformable.setOrigin(sf::Vector2f(theCache.Origin.x*theCache.Size.x,
+          theCache.Origin.y*theCache.Size.y));
+    const sf::Transform& anTransform=anTransformable.getTransform();
+    theCache.World.resize(theCache.Local.size());
+    for(size_t anIndex=0; anIndex<theCache.Local.size(); anIndex++)
+    {
+      theCache.World[anIndex]=TransformVertex(theCache.Local[anIndex],anTransform);
+    }
+    theCache.Bounds=anTransform.transformRect(theCache.LocalBounds);
+  }
+
+  sf::PrimitiveType RenderSystem::AppendVertices(const sf::VertexArray& theVertices,
+      std::vector<sf::Vertex>& theResult)
+  {
+    unsigned int anCount=theVertices.getVertexCount();
+    unsigned int anIndex;
+    switch(theVertices.getPrimitiveType())
+    {
+      case sf::Triangles:
+        for(anIndex=0; anIndex+2<anCount; anIndex+=3)
+        {
+          theResult.push_back(theVertices[anIndex]);
+          theResult.push_back(theVertices[anIndex+1]);
+          theResult.push_back(theVertices[anIndex+2]);
+        }
+        break;
+      case sf::TrianglesStrip:
+        for(anIndex=2; anIndex<anCount; anIndex++)
+        {
+          theResult.push_back(theVertices[anIndex-2]);
+          theResult.push_back(theVertices[anIndex-1]);
+          theResult.push_back(theVertices[anIndex]);
+        }
+        break;
+      case sf::TrianglesFan:
+        for(anIndex=2; anIndex<anCount; anIndex++)
+        {
+          theResult.push_back(theVertices[0]);
+          theResult.push_back(theVertices[anIndex-1]);
+          theResult.push_back(theVertices[anIndex]);
+        }
+        break;
+      case sf::Quads:
+        for(anIndex=0; anIndex+3<anCount; anIndex+=4)
+        {
+          theResult.push_back(theVertices[anIndex]);
+          theResult.push_back(theVertices[anIndex+1]);
+          theResult.push_back(theVertices[anIndex+2]);
+          theResult.push_back(theVertices[anIndex]);
+          theResult.push_back(theVertices[anIndex+2]);
+          theResult.push_back(theVertices[anIndex+3]);
+        }
+        break;
+      default:
+        // Points and lines are kept as they are and drawn on their own
+        for(anIndex=0; anIndex<anCount; anIndex++)
+        {
+          theResult.push_back(theVertices[anIndex]);
+        }
+        return theVertices.getPrimitiveType();
+    }
+    return sf::Triangles;
+  }
+
+  void RenderSystem::SortQueue(void)
+  {
+    size_t anCount=mQueue.size();
+    mSortBuffer.resize(anCount);
+    for(Uint32 anByte=0; anByte<8; anByte++)
+    {
+      Uint32 anShift=anByte*8;
+      size_t anOffsets[256]={0};
+      size_t anIndex;
+      for(anIndex=0; anIndex<anCount; anIndex++)
+      {
+        anOffsets[(mQueue[anIndex].Key >> anShift) & 0xFF]++;
+      }
+
+      // Skip this byte if every item has the same value
+      if(anCount == 0 || anOffsets[(mQueue[0].Key >> anShift) & 0xFF] == anCount)
+      {
+        continue;
+      }
+
+      // Turn the counts into the first index of each value
+      size_t anTotal=0;
+      for(anIndex=0; anIndex<256; anIndex++)
+      {
+        size_t anValueCount=anOffsets[anIndex];
+        anOffsets[anIndex]=anTotal;
+        anTotal+=anValueCount;
+      }
+      for(anIndex=0; anIndex<anCount; anIndex++)
+      {
+        mSortBuffer[anOffsets[(mQueue[anIndex].Key >> anShift) & 0xFF]++]=mQueue[anIndex];
+      }
+      mQueue.swap(mSortBuffer);
+    }
+  }
+
+  void RenderSystem::SelectView(const std::string& theViewID)
+  {
+    // Most items use the same view as the one before them
+    if(mViewIDs.empty() || mViewIDs[mViewIndex] != theViewID)
+    {
+      mViewIndex=0;
+      while(mViewIndex < mViewIDs.size() && mViewIDs[mViewIndex] != theViewID)
+      {
+        mViewIndex++;
+      }
+      if(mViewIndex == mViewIDs.size())
+      {
+        sf::View anView=GetView(theViewID);
+        sf::Vector2f anViewSize=anView.getSize();
+        sf::Vector2f anViewPosition=anView.getCenter();
+        mViewIDs.push_back(theViewID);
+        mViewCounts.push_back(0);
+        mViewRects.push_back(sf::FloatRect(anViewPosition-sf::Vector2f(anViewSize.x/2,anViewSize.y/2),anViewSize));
+      }
+    }
+  }
+
+  void RenderSystem::SelectTexture(const sf::Texture* theTexture)
+  {
+    // Most items use the same Texture as the one before them
+    if(mTextures.empty() || mTextures[mTextureIndex] != theTexture)
+    {
+      mTextureIndex=0;
+      while(mTextureIndex < mTextures.size() && mTextures[mTextureIndex] != theTexture)
+      {
+        mTextureIndex++;
+      }
+      if(mTextureIndex == mTextures.size())
+      {
+        mTextures.push_back(theTexture);
+      }
+    }
+  }
+
+  void RenderSystem::QueueItem(const sf::Vertex* theVertices, Uint32 theCount,
+      Uint32 thePrimitive, Uint32 theLayer, Uint32 theDepth)
+  {
+    RenderItem anItem;
+    anItem.Vertices=theVertices;
+    anItem.Count=theCount;
+    anItem.Primitive=thePrimitive;
+    anItem.View=mViewIndex;
+    anItem.Texture=mTextureIndex;
+
+    // Fields that don't fit in the key only affect the order, not the state
+    Uint64 anView=mViewIndex < 0xFF ? mViewIndex : 0xFF;
+    Uint64 anLayer=theLayer < 0xFFFF ? theLayer : 0xFFFF;
+    Uint64 anTextureKey=mTextureIndex < 0xFFFF ? mTextureIndex : 0xFFFF;
+    Uint64 anDepth=theDepth & 0xFFFFFF;
+    anItem.Key=(anView << 56) | (anLayer << 40) | (anTextureKey << 24) | anDepth;
+    mQueue.push_back(anItem);
+  }
+
+  void RenderSystem::FlushBatch(void)
+  {
+    if(mBatch.empty())
+    {
+      return;
+    }
+    // A RenderCommandList keeps its own copy so mBatch can be reused right away
+    mApp.GetRenderTarget().Draw(&mBatch[0],(Uint32)mBatch.size(),sf::Triangles,mBatchTexture);
+    mStats.DrawCalls++;
+
+    // Keep the capacity so the next run doesn't need to allocate
+    mBatch.clear();
   }
 
   void RenderSystem::HandleCleanup(IEntity* theEntity)
   {
-    // Do nothing
+    // Remove theEntity from the SpatialGrid or chunk of its view
+    std::map<const typeEntityID, RenderCache>::iterator anCache=
+      mCaches.find(theEntity->GetID());
+    if(anCache != mCaches.end())
+    {
+      if(anCache->second.Static)
+      {
+        LeaveChunk(anCache->second);
+      }
+      else
+      {
+        std::map<std::string, SpatialGrid>::iterator anGrid=mGrids.find(anCache->second.View);
+        if(anGrid != mGrids.end())
+        {
+          anGrid->second.DropProxy(theEntity);
+        }
+      }
+      mCaches.erase(anCache);
+    }
   }
   void RenderSystem::SetView(std::string theViewID,sf::View theView)
   {
@@ -131,10 +893,14 @@ namespace GQE
     }
     return mApp.mWindow.getDefaultView();
   }
-	void RenderSystem::EventViewEntity(PropertyManager* theContext)
+	void RenderSystem::EventViewEntity(EventContext* theContext)
 	{
-	  std::string anViewID=theContext->GetString("sViewID");
-	  IEntity* anEntity=theContext->Get<IEntity*>("Entity");
+	  IEntity* anEntity=theContext!=NULL ? theContext->Entity : NULL;
+	  if(anEntity==NULL)
+	  {
+	    return;
+	  }
+	  std::string anViewID=anEntity->mProperties.GetString("sView");
 
     sf::View anView = GetView(anViewID);
     anView.setCenter(anEntity->mProperties.Get<sf::Vector2f>("vPosition"));
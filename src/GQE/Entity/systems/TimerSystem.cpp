@@ -4,19 +4,34 @@
 * @file include/GQE/Entity/systems/TimerSystem.cpp
 * @author Jacob Dix
 * @date 20140413 - Initial Release
+* @date 20261018 - Schedule every timer on one hierarchical timing wheel
+* @date 20261018 - Provide an EventContext instead of building a PropertyManager for each event
+* @date 20261018 - Resolve the typeEventIndex of each timer when it is started
 */
+#include <cmath>
 #include <SFML/Graphics.hpp>
 #include <GQE/Entity/systems/TimerSystem.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
 namespace GQE
 {
+  const Uint32 TimerSystem::LEVELS;
+  const Uint32 TimerSystem::SLOTS;
+  const Uint32 TimerSystem::SLOT_BITS;
+  const Uint32 TimerSystem::FIRING;
+  const Uint32 TimerSystem::NONE;
+
   TimerSystem::TimerSystem(GQE::IApp& theApp) :
-    ISystem("TimerSystem", theApp)
+    ISystem("TimerSystem", theApp),
+    mSlots(FIRING + 1, NONE),
+    mFree(NONE),
+    mTick(0)
   {
   }
 
   TimerSystem::~TimerSystem()
   {
+    mTimerIDs.clear();
+    mTimers.clear();
   }
 
   void TimerSystem::AddProperties(GQE::IEntity* theEntity)
@@ -24,6 +39,119 @@ namespace GQE
     theEntity->mProperties.Add<typeTimerLists>("Timers", typeTimerLists());
   }
 
+  void TimerSystem::AddTimer(GQE::IEntity* theEntity, const std::string theTimerID,
+      sf::Time theTime, const std::string theEvent, bool theRepeat,
+      Uint32 theAction)
+  {
+    if(theEntity == NULL)
+    {
+      return;
+    }
+    CancelTimer(theEntity, theTimerID);
+
+    // Reuse a stopped timer before growing the list of timers
+    Uint32 anIndex = mFree;
+    if(anIndex != NONE)
+    {
+      mFree = mTimers[anIndex].Next;
+    }
+    else
+    {
+      anIndex = (Uint32)mTimers.size();
+      mTimers.push_back(Timer());
+    }
+
+    // Round up to whole fixed updates, a timer never fires before its time
+    float anTicks = std::ceil(theTime.asSeconds() * mApp.GetUpdateRate());
+    Timer& anTimer = mTimers[anIndex];
+    anTimer.Entity = theEntity;
+    anTimer.TimerID = theTimerID;
+    anTimer.Data.Time = theTime;
+    anTimer.Data.Event = theEvent;
+    anTimer.Data.Repeat = theRepeat;
+    anTimer.Data.Active = true;
+    anTimer.Data.Action = theAction;
+    anTimer.Event = mApp.mEventManager.GetIndex(theEvent);
+    anTimer.Interval = anTicks > 1.0f ? (Uint32)anTicks : 1;
+    anTimer.Expires = mTick + anTimer.Interval - 1;
+    anTimer.Slot = NONE;
+    anTimer.Prev = NONE;
+    anTimer.Next = NONE;
+    mTimerIDs[std::make_pair(theEntity->GetID(), theTimerID)] = anIndex;
+    Schedule(anIndex);
+  }
+
+  void TimerSystem::CancelTimer(GQE::IEntity* theEntity, const std::string theTimerID)
+  {
+    if(theEntity == NULL)
+    {
+      return;
+    }
+    std::map<std::pair<typeEntityID, std::string>, Uint32>::iterator anIter =
+      mTimerIDs.find(std::make_pair(theEntity->GetID(), theTimerID));
+    if(anIter != mTimerIDs.end())
+    {
+      Release(anIter->second);
+    }
+  }
+
+  bool TimerSystem::HasTimer(GQE::IEntity* theEntity, const std::string theTimerID) const
+  {
+    return theEntity != NULL &&
+      mTimerIDs.find(std::make_pair(theEntity->GetID(), theTimerID)) != mTimerIDs.end();
+  }
+
+  void TimerSystem::UpdateFixed(void)
+  {
+    // Move the timers of the next level down each time a level comes around
+    Uint32 anIndex = (Uint32)(mTick & (SLOTS - 1));
+    if(anIndex == 0 &&
+        Cascade(1, (Uint32)((mTick >> SLOT_BITS) & (SLOTS - 1))) == 0 &&
+        Cascade(2, (Uint32)((mTick >> (2*SLOT_BITS)) & (SLOTS - 1))) == 0)
+    {
+      Cascade(3, (Uint32)((mTick >> (3*SLOT_BITS)) & (SLOTS - 1)));
+    }
+
+    // Every timer in this slot expires on this tick, move them to the firing
+    // list so timers added by the events below wait for their own tick
+    mSlots[FIRING] = mSlots[anIndex];
+    mSlots[anIndex] = NONE;
+    Uint32 anTimer;
+    for(anTimer = mSlots[FIRING]; anTimer != NONE; anTimer = mTimers[anTimer].Next)
+    {
+      mTimers[anTimer].Slot = FIRING;
+    }
+    mTick++;
+
+    while(mSlots[FIRING] != NONE)
+    {
+      anTimer = mSlots[FIRING];
+      // Assigning to the same TimerData each time reuses its memory
+      GQE::IEntity* anEntity = mTimers[anTimer].Entity;
+      typeEventIndex anEvent = mTimers[anTimer].Event;
+      mFired = mTimers[anTimer].Data;
+      mFired.Active = mFired.Repeat;
+      if(mFired.Repeat)
+      {
+        // Link the same timer back into the wheel, no memory is needed
+        Unlink(anTimer);
+        mTimers[anTimer].Expires += mTimers[anTimer].Interval;
+        Schedule(anTimer);
+      }
+      else
+      {
+        Release(anTimer);
+      }
+
+      // The event might add or cancel timers, so the timer isn't used below
+      if(anEvent != EventManager::NO_EVENT)
+      {
+        EventContext anContext(anEntity, NULL, &mFired);
+        mApp.mEventManager.DoEvent(anEvent, &anContext);
+      }
+    }
+  }
+
   void TimerSystem::HandleInit(GQE::IEntity* theEntity)
   {
     typeTimerLists anTimerList = theEntity->mProperties.Get<typeTimerLists>("Timers");
@@ -31,48 +159,120 @@ namespace GQE
     for (anIter = anTimerList.begin(); anIter != anTimerList.end(); ++anIter)
     {
       TimerData& anContext = anIter->second;
-      anContext.Clock.restart();
-      anTimerList[anIter->first] = anContext;
+      if(anContext.Active)
+      {
+        AddTimer(theEntity, anIter->first, anContext.Time, anContext.Event,
+            anContext.Repeat, anContext.Action);
+      }
     }
-    theEntity->mProperties.Set<typeTimerLists>("Timers", anTimerList);
   }
 
   void TimerSystem::HandleCleanup(GQE::IEntity* theEntity)
   {
+    // Timer IDs are sorted by IEntity first so its timers are next to each other
+    typeEntityID anEntityID = theEntity->GetID();
+    std::map<std::pair<typeEntityID, std::string>, Uint32>::iterator anIter =
+      mTimerIDs.lower_bound(std::make_pair(anEntityID, std::string()));
+    while(anIter != mTimerIDs.end() && anIter->first.first == anEntityID)
+    {
+      Uint32 anTimer = anIter->second;
+      ++anIter;
+      Release(anTimer);
+    }
   }
-  void TimerSystem::EntityUpdateFixed(GQE::IEntity* theEntity)
+
+  void TimerSystem::Schedule(Uint32 theIndex)
   {
-    typeTimerLists anTimerList = theEntity->mProperties.Get<typeTimerLists>("Timers");
-    typeTimerLists::iterator anIter;
-    for (anIter = anTimerList.begin(); anIter != anTimerList.end(); ++anIter)
+    Uint64 anExpires = mTimers[theIndex].Expires;
+    Uint64 anDelta = anExpires - mTick;
+    Uint32 anLevel = 0;
+    if(anDelta >= ((Uint64)1 << (3*SLOT_BITS)))
     {
-      TimerData& anContext = anIter->second;
-      sf::Time anElapsedTime = anContext.Clock.getElapsedTime();
-      if (anElapsedTime >= anContext.Time && anContext.Active)
+      // Longer timers wait in the last level and are cascaded back into it
+      // until they come within reach of the wheel
+      if(anDelta >= ((Uint64)1 << (LEVELS*SLOT_BITS)))
       {
-        anContext.Clock.restart();
-        if (!anContext.Repeat)
-          anContext.Active = false;
-        if (anContext.Event != "")
-        {
-          GQE::PropertyManager anProperties;
-          anProperties.Add<GQE::IEntity*>("Entity", theEntity);
-          anProperties.Add<TimerData>("TimerData",anContext);
-          mApp.mEventManager.DoEvent(anContext.Event, &anProperties);
-        }
+        anExpires = mTick + ((Uint64)1 << (LEVELS*SLOT_BITS)) - 1;
       }
+      anLevel = 3;
+    }
+    else if(anDelta >= ((Uint64)1 << (2*SLOT_BITS)))
+    {
+      anLevel = 2;
+    }
+    else if(anDelta >= SLOTS)
+    {
+      anLevel = 1;
+    }
+    Link(theIndex, anLevel*SLOTS +
+        (Uint32)((anExpires >> (anLevel*SLOT_BITS)) & (SLOTS - 1)));
+  }
+
+  void TimerSystem::Link(Uint32 theIndex, Uint32 theSlot)
+  {
+    Timer& anTimer = mTimers[theIndex];
+    anTimer.Slot = theSlot;
+    anTimer.Prev = NONE;
+    anTimer.Next = mSlots[theSlot];
+    if(anTimer.Next != NONE)
+    {
+      mTimers[anTimer.Next].Prev = theIndex;
+    }
+    mSlots[theSlot] = theIndex;
+  }
+
+  void TimerSystem::Unlink(Uint32 theIndex)
+  {
+    Timer& anTimer = mTimers[theIndex];
+    if(anTimer.Slot == NONE)
+    {
+      return;
+    }
+    if(anTimer.Prev != NONE)
+    {
+      mTimers[anTimer.Prev].Next = anTimer.Next;
+    }
+    else
+    {
+      mSlots[anTimer.Slot] = anTimer.Next;
+    }
+    if(anTimer.Next != NONE)
+    {
+      mTimers[anTimer.Next].Prev = anTimer.Prev;
+    }
+    anTimer.Slot = NONE;
+    anTimer.Prev = NONE;
+    anTimer.Next = NONE;
+  }
+
+  void TimerSystem::Release(Uint32 theIndex)
+  {
+    Unlink(theIndex);
+    Timer& anTimer = mTimers[theIndex];
+    if(anTimer.Entity != NULL)
+    {
+      mTimerIDs.erase(std::make_pair(anTimer.Entity->GetID(), anTimer.TimerID));
+      anTimer.Entity = NULL;
+    }
+    anTimer.Next = mFree;
+    mFree = theIndex;
+  }
+
+  Uint32 TimerSystem::Cascade(Uint32 theLevel, Uint32 theSlot)
+  {
+    Uint32 anTimer = mSlots[theLevel*SLOTS + theSlot];
+    mSlots[theLevel*SLOTS + theSlot] = NONE;
+    while(anTimer != NONE)
+    {
+      Uint32 anNext = mTimers[anTimer].Next;
+      Schedule(anTimer);
+      anTimer = anNext;
     }
-    theEntity->mProperties.Set<typeTimerLists>("Timers", anTimerList);
+    return theSlot;
   }
 }
+
 /**
-* @class GQE::TimerSystem
-* @ingroup Entity
-* The TimerSystem class is used to make timed events. The properties provided
-* by this System are as follows:
-* - Timers: A map of TimeContext structure.
-* This class is very simple. It Iterates through each entitys list of timers and checks to see if they are triggerd.
-*
 * Copyright (c) 2010-2012 Jacob Dix
 * Permission is hereby granted, free of charge, to any person obtaining a copy
 * of this software and associated documentation files (the "Software"), to deal
@@ -11,15 +11,19 @@
  * @date 20120630 - Improve ScreenWrap functionality using SpriteRect values
  * @date 20130722 - Renamed TransformSystem to TransformSystem. vPosition, fRotation and vScale now properties of TransformSystem.
  * @date 20130928 - changed fDrag to vDrag.
+ * @date 20261018 - Compare against the vPosition and fRotation read before moving each IEntity
+ * @date 20261018 - Tell the RenderSystem of each IEntity moved without SetRenderSystem
  */
 #include <SFML/Graphics.hpp>
 #include <GQE/Entity/systems/TransformSystem.hpp>
+#include <GQE/Entity/systems/RenderSystem.hpp>
 #include <GQE/Entity/interfaces/IEntity.hpp>
 
 namespace GQE
 {
   TransformSystem::TransformSystem(IApp& theApp):
-    ISystem("TransformSystem",theApp)
+    ISystem("TransformSystem",theApp),
+    mRenderSystem(NULL)
   {
   }
   TransformSystem::~TransformSystem()
@@ -43,6 +47,11 @@ namespace GQE
 
   }
 
+  void TransformSystem::SetRenderSystem(RenderSystem* theRenderSystem)
+  {
+    mRenderSystem = theRenderSystem;
+  }
+
   void TransformSystem::HandleInit(IEntity* theEntity)
   {
     // Do nothing
@@ -57,8 +66,10 @@ namespace GQE
         if(theEntity->mProperties.Get<bool>("bFixedMovement"))
         {
           // Get the RenderSystem properties
-          sf::Vector2f anPosition = theEntity->mProperties.Get<sf::Vector2f>("vPosition");
-          float anRotation = theEntity->mProperties.Get<float>("fRotation");
+          sf::Vector2f anOldPosition = theEntity->mProperties.Get<sf::Vector2f>("vPosition");
+          float anOldRotation = theEntity->mProperties.Get<float>("fRotation");
+          sf::Vector2f anPosition = anOldPosition;
+          float anRotation = anOldRotation;
 
           // Get the TransformSystem properties
           sf::Vector2f anVelocity = theEntity->mProperties.Get<sf::Vector2f>("vVelocity");
@@ -98,6 +109,17 @@ namespace GQE
           theEntity->mProperties.Set<sf::Vector2f>("vVelocity",anVelocity);
           theEntity->mProperties.Set<float>("fRotationalVelocity",anRotationalVelocity);
 
+          // Let the RenderSystem know if this IEntity moved
+          if(anPosition != anOldPosition || anRotation != anOldRotation)
+          {
+            RenderSystem* anRenderSystem = mRenderSystem != NULL ?
+              mRenderSystem : RenderSystem::Find(theEntity);
+            if(anRenderSystem != NULL)
+            {
+              anRenderSystem->UpdateEntity(theEntity);
+            }
+          }
+
           // Now update the RenderSystem properties of this IEntity class
           theEntity->mProperties.Set<sf::Vector2f>("vPosition",anPosition);
           theEntity->mProperties.Set<float>("fRotation",anRotation);
@@ -112,8 +134,10 @@ namespace GQE
         if(theEntity->mProperties.Get<bool>("bFixedMovement") == false)
         {
           // Get the RenderSystem properties
-          sf::Vector2f anPosition = theEntity->mProperties.Get<sf::Vector2f>("vPosition");
-          float anRotation = theEntity->mProperties.Get<float>("fRotation");
+          sf::Vector2f anOldPosition = theEntity->mProperties.Get<sf::Vector2f>("vPosition");
+          float anOldRotation = theEntity->mProperties.Get<float>("fRotation");
+          sf::Vector2f anPosition = anOldPosition;
+          float anRotation = anOldRotation;
 
           // Get the TransformSystem properties
           sf::Vector2f anVelocity = theEntity->mProperties.Get<sf::Vector2f>("vVelocity");
@@ -138,6 +162,17 @@ namespace GQE
           theEntity->mProperties.Set<sf::Vector2f>("vVelocity", anVelocity);
           theEntity->mProperties.Set<float>("fRotationalVelocity", anRotationalVelocity);
 
+          // Let the RenderSystem know if this IEntity moved
+          if(anPosition != anOldPosition || anRotation != anOldRotation)
+          {
+            RenderSystem* anRenderSystem = mRenderSystem != NULL ?
+              mRenderSystem : RenderSystem::Find(theEntity);
+            if(anRenderSystem != NULL)
+            {
+              anRenderSystem->UpdateEntity(theEntity);
+            }
+          }
+
           // Now update the RenderSystem properties of this IEntity class
           theEntity->mProperties.Set<sf::Vector2f>("vPosition", anPosition);
           theEntity->mProperties.Set<float>("fRotation", anRotation);
@@ -0,0 +1,1029 @@
+/**
+ * Provides the separating axis theorem functions used by the ICollisionSystem
+ * class to test the cached world space geometry of two convex shapes. Each
+ * test is provided as a scalar version and SSE2/AVX2 versions which return the
+ * exact same minimum translation vector.
+ *
+ * @file src/GQE/Entity/utils/CollisionUtil.cpp
+ * @author Jacob Dix
+ * @date 20261018 - Initial Release
+ * @date 20261018 - Try the last separating axis first and return the new one
+ * @date 20261018 - Add circle and AABB collider tests
+ * @date 20261018 - Add ColliderRayCast for ray casts against any collider
+ * @date 20261018 - Add ColliderSweep for continuous collision tests
+ * @date 20261018 - Test each convex piece of concave colliders
+ * @date 20261018 - Point the polygon minimum translation toward the other shape
+ */
+#include <limits>
+#include <math.h>
+#include <GQE/Entity/utils/CollisionUtil.hpp>
+#if defined(GQE_COLLISION_AVX2)
+#include <immintrin.h>
+#elif defined(GQE_COLLISION_SSE2)
+#include <emmintrin.h>
+#endif
+
+namespace GQE
+{
+  /// Projects the points of a CollisionCache one point at a time
+  struct ProjectScalar
+  {
+    static void Project(const CollisionCache& theCache, const float theAxisX,
+        const float theAxisY, float& theMin, float& theMax)
+    {
+      const sf::Vector2f* anPoints = &theCache.Points[0];
+      size_t anPointCount = theCache.Points.size();
+      theMin = anPoints[0].x*theAxisX + anPoints[0].y*theAxisY;
+      theMax = theMin;
+      for(size_t anIndex = 1; anIndex < anPointCount; ++anIndex)
+      {
+        float anProjection = anPoints[anIndex].x*theAxisX + anPoints[anIndex].y*theAxisY;
+        if(anProjection < theMin)
+          theMin = anProjection;
+        if(anProjection > theMax)
+          theMax = anProjection;
+      }
+    }
+  };
+
+#if defined(GQE_COLLISION_SSE2)
+  /// Projects the padded points of a CollisionCache four points at a time
+  struct ProjectSSE2
+  {
+    static void Project(const CollisionCache& theCache, const float theAxisX,
+        const float theAxisY, float& theMin, float& theMax)
+    {
+      // Use the scalar version if theCache was never padded
+      size_t anPointCount = theCache.PointsX.size();
+      if(anPointCount < theCache.Points.size() || anPointCount == 0)
+      {
+        ProjectScalar::Project(theCache, theAxisX, theAxisY, theMin, theMax);
+        return;
+      }
+
+      const float* anX = &theCache.PointsX[0];
+      const float* anY = &theCache.PointsY[0];
+      const __m128 anAxisX = _mm_set1_ps(theAxisX);
+      const __m128 anAxisY = _mm_set1_ps(theAxisY);
+      __m128 anMin = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(anX), anAxisX),
+          _mm_mul_ps(_mm_loadu_ps(anY), anAxisY));
+      __m128 anMax = anMin;
+      for(size_t anIndex = 4; anIndex < anPointCount; anIndex += 4)
+      {
+        __m128 anProjection = _mm_add_ps(
+            _mm_mul_ps(_mm_loadu_ps(anX + anIndex), anAxisX),
+            _mm_mul_ps(_mm_loadu_ps(anY + anIndex), anAxisY));
+        anMin = _mm_min_ps(anMin, anProjection);
+        anMax = _mm_max_ps(anMax, anProjection);
+      }
+
+      // Reduce the four lanes down to a single minimum and maximum
+      anMin = _mm_min_ps(anMin, _mm_shuffle_ps(anMin, anMin, _MM_SHUFFLE(2,3,0,1)));
+      anMin = _mm_min_ps(anMin, _mm_shuffle_ps(anMin, anMin, _MM_SHUFFLE(1,0,3,2)));
+      anMax = _mm_max_ps(anMax, _mm_shuffle_ps(anMax, anMax, _MM_SHUFFLE(2,3,0,1)));
+      anMax = _mm_max_ps(anMax, _mm_shuffle_ps(anMax, anMax, _MM_SHUFFLE(1,0,3,2)));
+      theMin = _mm_cvtss_f32(anMin);
+      theMax = _mm_cvtss_f32(anMax);
+    }
+  };
+#endif
+
+#if defined(GQE_COLLISION_AVX2)
+  /// Projects the padded points of a CollisionCache eight points at a time
+  struct ProjectAVX2
+  {
+    static void Project(const CollisionCache& theCache, const float theAxisX,
+        const float theAxisY, float& theMin, float& theMax)
+    {
+      // Use the scalar version if theCache was never padded
+      size_t anPointCount = theCache.PointsX.size();
+      if(anPointCount < theCache.Points.size() || anPointCount == 0)
+      {
+        ProjectScalar::Project(theCache, theAxisX, theAxisY, theMin, theMax);
+        return;
+      }
+
+      const float* anX = &theCache.PointsX[0];
+      const float* anY = &theCache.PointsY[0];
+      const __m256 anAxisX = _mm256_set1_ps(theAxisX);
+      const __m256 anAxisY = _mm256_set1_ps(theAxisY);
+      __m256 anMin = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(anX), anAxisX),
+          _mm256_mul_ps(_mm256_loadu_ps(anY), anAxisY));
+      __m256 anMax = anMin;
+      for(size_t anIndex = 8; anIndex < anPointCount; anIndex += 8)
+      {
+        __m256 anProjection = _mm256_add_ps(
+            _mm256_mul_ps(_mm256_loadu_ps(anX + anIndex), anAxisX),
+            _mm256_mul_ps(_mm256_loadu_ps(anY + anIndex), anAxisY));
+        anMin = _mm256_min_ps(anMin, anProjection);
+        anMax = _mm256_max_ps(anMax, anProjection);
+      }
+
+      // Reduce the eight lanes down to four and then to one
+      __m128 anMin4 = _mm_min_ps(_mm256_castps256_ps128(anMin), _mm256_extractf128_ps(anMin, 1));
+      __m128 anMax4 = _mm_max_ps(_mm256_castps256_ps128(anMax), _mm256_extractf128_ps(anMax, 1));
+      anMin4 = _mm_min_ps(anMin4, _mm_shuffle_ps(anMin4, anMin4, _MM_SHUFFLE(2,3,0,1)));
+      anMin4 = _mm_min_ps(anMin4, _mm_shuffle_ps(anMin4, anMin4, _MM_SHUFFLE(1,0,3,2)));
+      anMax4 = _mm_max_ps(anMax4, _mm_shuffle_ps(anMax4, anMax4, _MM_SHUFFLE(2,3,0,1)));
+      anMax4 = _mm_max_ps(anMax4, _mm_shuffle_ps(anMax4, anMax4, _MM_SHUFFLE(1,0,3,2)));
+      theMin = _mm_cvtss_f32(anMin4);
+      theMax = _mm_cvtss_f32(anMax4);
+    }
+  };
+#endif
+
+  /// Separating axis test shared by every instruction set
+  template<class TPROJECT>
+  bool SATTest(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis)
+  {
+    // Exit if either shape is empty
+    if(theMovingCache.Points.empty() || theOtherCache.Points.empty())
+      return false;
+
+    // Quick rejection if the bounding boxes don't overlap, the axis of the
+    // gap found is also a separating axis for both shapes
+    const sf::FloatRect& anBoundsA = theMovingCache.Bounds;
+    const sf::FloatRect& anBoundsB = theOtherCache.Bounds;
+    if(anBoundsA.left > anBoundsB.left + anBoundsB.width ||
+        anBoundsB.left > anBoundsA.left + anBoundsA.width)
+    {
+      theSeparatingAxis = sf::Vector2f(1.0f, 0.0f);
+      return false;
+    }
+    if(anBoundsA.top > anBoundsB.top + anBoundsB.height ||
+        anBoundsB.top > anBoundsA.top + anBoundsA.height)
+    {
+      theSeparatingAxis = sf::Vector2f(0.0f, 1.0f);
+      return false;
+    }
+
+    float anMinA, anMaxA, anMinB, anMaxB;
+
+    // Shapes rarely move far between updates, so the axis that separated
+    // them last time will most likely still separate them now
+    if(theSeparatingAxis.x != 0.0f || theSeparatingAxis.y != 0.0f)
+    {
+      TPROJECT::Project(theMovingCache, theSeparatingAxis.x, theSeparatingAxis.y, anMinA, anMaxA);
+      TPROJECT::Project(theOtherCache, theSeparatingAxis.x, theSeparatingAxis.y, anMinB, anMaxB);
+      if(!((anMinB <= anMaxA) && (anMaxB >= anMinA)))
+      {
+        return false;
+      }
+    }
+
+    // Each axis is flipped to point from the moving shape toward the other
+    // so the minimum translation has the same direction as every other test
+    sf::Vector2f anDelta = theOtherCache.Center - theMovingCache.Center;
+    sf::Vector2f anSmallestAxis;
+    double anOverlap = std::numeric_limits<double>::max();
+    const std::vector<sf::Vector2f>* anNormals[2] = {&theMovingCache.Normals, &theOtherCache.Normals};
+    for(Uint32 anShape = 0; anShape < 2; ++anShape)
+    {
+      const std::vector<sf::Vector2f>& anAxes = *anNormals[anShape];
+      for(size_t anIndex = 0; anIndex < anAxes.size(); ++anIndex)
+      {
+        TPROJECT::Project(theMovingCache, anAxes[anIndex].x, anAxes[anIndex].y, anMinA, anMaxA);
+        TPROJECT::Project(theOtherCache, anAxes[anIndex].x, anAxes[anIndex].y, anMinB, anMaxB);
+
+        // A gap along any axis means the shapes can't be intersecting
+        if(!((anMinB <= anMaxA) && (anMaxB >= anMinA)))
+        {
+          theSeparatingAxis = anAxes[anIndex];
+          return false;
+        }
+        bool anForward = anDelta.x*anAxes[anIndex].x + anDelta.y*anAxes[anIndex].y >= 0.0f;
+        double o;
+        if(anForward)
+          o = anMaxA - anMinB;
+        else
+          o = anMaxB - anMinA;
+        if(o < anOverlap)
+        {
+          anSmallestAxis = anForward ? anAxes[anIndex] : -anAxes[anIndex];
+          anOverlap = o;
+        }
+      }
+    }
+    theSeparatingAxis = sf::Vector2f(0.0f, 0.0f);
+    theMinimumTranslation = anSmallestAxis;
+    theMinimumTranslation *= (float)anOverlap;
+    return true;
+  }
+
+  bool SATIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+    sf::Vector2f anSeparatingAxis;
+    return SATIntersection(theMovingCache, theOtherCache, theMinimumTranslation, anSeparatingAxis);
+  }
+
+  bool SATIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis)
+  {
+#if defined(GQE_COLLISION_AVX2)
+    return SATTest<ProjectAVX2>(theMovingCache, theOtherCache, theMinimumTranslation, theSeparatingAxis);
+#elif defined(GQE_COLLISION_SSE2)
+    return SATTest<ProjectSSE2>(theMovingCache, theOtherCache, theMinimumTranslation, theSeparatingAxis);
+#else
+    return SATTest<ProjectScalar>(theMovingCache, theOtherCache, theMinimumTranslation, theSeparatingAxis);
+#endif
+  }
+
+  bool SATIntersectionScalar(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+    sf::Vector2f anSeparatingAxis;
+    return SATTest<ProjectScalar>(theMovingCache, theOtherCache, theMinimumTranslation, anSeparatingAxis);
+  }
+
+  bool SATIntersectionSSE2(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+#if defined(GQE_COLLISION_SSE2)
+    sf::Vector2f anSeparatingAxis;
+    return SATTest<ProjectSSE2>(theMovingCache, theOtherCache, theMinimumTranslation, anSeparatingAxis);
+#else
+    sf::Vector2f anSeparatingAxis;
+    return SATTest<ProjectScalar>(theMovingCache, theOtherCache, theMinimumTranslation, anSeparatingAxis);
+#endif
+  }
+
+  bool SATIntersectionAVX2(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+#if defined(GQE_COLLISION_AVX2)
+    sf::Vector2f anSeparatingAxis;
+    return SATTest<ProjectAVX2>(theMovingCache, theOtherCache, theMinimumTranslation, anSeparatingAxis);
+#else
+    return SATIntersectionSSE2(theMovingCache, theOtherCache, theMinimumTranslation);
+#endif
+  }
+
+  /// Projects a collider of any Type, using TPROJECT for polygons
+  template<class TPROJECT>
+  void ProjectCollider(const CollisionCache& theCache, const float theAxisX,
+      const float theAxisY, float& theMin, float& theMax)
+  {
+    if(COLLIDER_CIRCLE == theCache.Type)
+    {
+      float anCenter = theCache.Center.x*theAxisX + theCache.Center.y*theAxisY;
+      theMin = anCenter - theCache.Radius;
+      theMax = anCenter + theCache.Radius;
+    }
+    else if(COLLIDER_AABB == theCache.Type)
+    {
+      float anCenter = theCache.Center.x*theAxisX + theCache.Center.y*theAxisY;
+      float anExtent = 0.5f*(theCache.Bounds.width*fabs(theAxisX) +
+          theCache.Bounds.height*fabs(theAxisY));
+      theMin = anCenter - anExtent;
+      theMax = anCenter + anExtent;
+    }
+    else
+    {
+      TPROJECT::Project(theCache, theAxisX, theAxisY, theMin, theMax);
+    }
+  }
+
+  /// Tests one axis and keeps the smallest overlap found pointing from the
+  /// moving collider toward the other, returns false if theAxis separates them
+  template<class TPROJECT>
+  bool TestColliderAxis(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, const sf::Vector2f& theAxis,
+      double& theOverlap, sf::Vector2f& theSmallestAxis)
+  {
+    float anMinA, anMaxA, anMinB, anMaxB;
+    ProjectCollider<TPROJECT>(theMovingCache, theAxis.x, theAxis.y, anMinA, anMaxA);
+    ProjectCollider<TPROJECT>(theOtherCache, theAxis.x, theAxis.y, anMinB, anMaxB);
+    if(!((anMinB <= anMaxA) && (anMaxB >= anMinA)))
+    {
+      return false;
+    }
+    double anForward = anMaxA - anMinB;
+    double anBackward = anMaxB - anMinA;
+    if(anForward < theOverlap)
+    {
+      theSmallestAxis = theAxis;
+      theOverlap = anForward;
+    }
+    if(anBackward < theOverlap)
+    {
+      theSmallestAxis = -theAxis;
+      theOverlap = anBackward;
+    }
+    return true;
+  }
+
+  /// Returns the point of theCache closest to thePoint used for circle axes
+  static sf::Vector2f GetClosestPoint(const CollisionCache& theCache, const sf::Vector2f& thePoint)
+  {
+    if(COLLIDER_CIRCLE == theCache.Type)
+    {
+      return theCache.Center;
+    }
+    if(COLLIDER_AABB == theCache.Type)
+    {
+      const sf::FloatRect& anBounds = theCache.Bounds;
+      sf::Vector2f anResult = thePoint;
+      anResult.x = anResult.x < anBounds.left ? anBounds.left : anResult.x;
+      anResult.x = anResult.x > anBounds.left + anBounds.width ? anBounds.left + anBounds.width : anResult.x;
+      anResult.y = anResult.y < anBounds.top ? anBounds.top : anResult.y;
+      anResult.y = anResult.y > anBounds.top + anBounds.height ? anBounds.top + anBounds.height : anResult.y;
+      return anResult;
+    }
+
+    // The closest vertex of a polygon gives the only axis not already
+    // covered by its edge normals
+    sf::Vector2f anResult = theCache.Points[0];
+    float anDistance = std::numeric_limits<float>::max();
+    for(size_t anIndex = 0; anIndex < theCache.Points.size(); ++anIndex)
+    {
+      sf::Vector2f anDelta = theCache.Points[anIndex] - thePoint;
+      float anLength = anDelta.x*anDelta.x + anDelta.y*anDelta.y;
+      if(anLength < anDistance)
+      {
+        anResult = theCache.Points[anIndex];
+        anDistance = anLength;
+      }
+    }
+    return anResult;
+  }
+
+  /// Separating axis test for any combination of collider Types
+  template<class TPROJECT>
+  bool ColliderTest(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis)
+  {
+    // Try the axis that separated these colliders last time first
+    double anOverlap = std::numeric_limits<double>::max();
+    sf::Vector2f anSmallestAxis;
+    if((theSeparatingAxis.x != 0.0f || theSeparatingAxis.y != 0.0f) &&
+        !TestColliderAxis<TPROJECT>(theMovingCache, theOtherCache,
+          theSeparatingAxis, anOverlap, anSmallestAxis))
+    {
+      return false;
+    }
+    anOverlap = std::numeric_limits<double>::max();
+
+    const CollisionCache* anColliders[2] = {&theMovingCache, &theOtherCache};
+    for(Uint32 anShape = 0; anShape < 2; ++anShape)
+    {
+      const CollisionCache& anCollider = *anColliders[anShape];
+      if(COLLIDER_CIRCLE == anCollider.Type)
+      {
+        // The only axis a circle adds is toward the closest point of the other
+        sf::Vector2f anAxis = GetClosestPoint(*anColliders[1 - anShape],
+            anCollider.Center) - anCollider.Center;
+        float anLength = sqrt(anAxis.x*anAxis.x + anAxis.y*anAxis.y);
+        if(anLength > 0.0f)
+        {
+          anAxis /= anLength;
+          if(!TestColliderAxis<TPROJECT>(theMovingCache, theOtherCache,
+                anAxis, anOverlap, anSmallestAxis))
+          {
+            theSeparatingAxis = anAxis;
+            return false;
+          }
+        }
+      }
+      else if(COLLIDER_AABB == anCollider.Type)
+      {
+        sf::Vector2f anAxes[2] = {sf::Vector2f(1.0f, 0.0f), sf::Vector2f(0.0f, 1.0f)};
+        for(Uint32 anIndex = 0; anIndex < 2; ++anIndex)
+        {
+          if(!TestColliderAxis<TPROJECT>(theMovingCache, theOtherCache,
+                anAxes[anIndex], anOverlap, anSmallestAxis))
+          {
+            theSeparatingAxis = anAxes[anIndex];
+            return false;
+          }
+        }
+      }
+      else
+      {
+        const std::vector<sf::Vector2f>& anAxes = anCollider.Normals;
+        for(size_t anIndex = 0; anIndex < anAxes.size(); ++anIndex)
+        {
+          if(!TestColliderAxis<TPROJECT>(theMovingCache, theOtherCache,
+                anAxes[anIndex], anOverlap, anSmallestAxis))
+          {
+            theSeparatingAxis = anAxes[anIndex];
+            return false;
+          }
+        }
+      }
+    }
+    theSeparatingAxis = sf::Vector2f(0.0f, 0.0f);
+    theMinimumTranslation = anSmallestAxis;
+    theMinimumTranslation *= (float)anOverlap;
+    return true;
+  }
+
+  /// Returns true and sets theSeparatingAxis to the x or y axis if the
+  /// bounding boxes of the two colliders don't overlap
+  static bool BoundsSeparated(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theSeparatingAxis)
+  {
+    const sf::FloatRect& anBoundsA = theMovingCache.Bounds;
+    const sf::FloatRect& anBoundsB = theOtherCache.Bounds;
+    if(anBoundsA.left > anBoundsB.left + anBoundsB.width ||
+        anBoundsB.left > anBoundsA.left + anBoundsA.width)
+    {
+      theSeparatingAxis = sf::Vector2f(1.0f, 0.0f);
+      return true;
+    }
+    if(anBoundsA.top > anBoundsB.top + anBoundsB.height ||
+        anBoundsB.top > anBoundsA.top + anBoundsA.height)
+    {
+      theSeparatingAxis = sf::Vector2f(0.0f, 1.0f);
+      return true;
+    }
+    return false;
+  }
+
+  /// Tests every convex piece of one or both colliders against each other
+  /// and keeps the deepest minimum translation found
+  static bool PieceIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis)
+  {
+    // Quick rejection if the bounding boxes of the whole shapes don't overlap
+    if(BoundsSeparated(theMovingCache, theOtherCache, theSeparatingAxis))
+      return false;
+
+    // Treat a collider without pieces as a single piece
+    const CollisionCache* anMovingPieces = theMovingCache.Pieces.empty() ?
+      &theMovingCache : &theMovingCache.Pieces[0];
+    size_t anMovingCount = theMovingCache.Pieces.empty() ? 1 : theMovingCache.Pieces.size();
+    const CollisionCache* anOtherPieces = theOtherCache.Pieces.empty() ?
+      &theOtherCache : &theOtherCache.Pieces[0];
+    size_t anOtherCount = theOtherCache.Pieces.empty() ? 1 : theOtherCache.Pieces.size();
+
+    bool anResult = false;
+    float anDepth = 0.0f;
+    for(size_t anMoving = 0; anMoving < anMovingCount; ++anMoving)
+    {
+      for(size_t anOther = 0; anOther < anOtherCount; ++anOther)
+      {
+        sf::Vector2f anTranslation;
+        sf::Vector2f anAxis(0.0f, 0.0f);
+        if(ColliderIntersection(anMovingPieces[anMoving], anOtherPieces[anOther],
+              anTranslation, anAxis))
+        {
+          float anLength = anTranslation.x*anTranslation.x + anTranslation.y*anTranslation.y;
+          if(!anResult || anLength > anDepth)
+          {
+            theMinimumTranslation = anTranslation;
+            anDepth = anLength;
+            anResult = true;
+          }
+        }
+      }
+    }
+
+    // Each piece pair has its own separating axis so none is kept
+    theSeparatingAxis = sf::Vector2f(0.0f, 0.0f);
+    return anResult;
+  }
+
+  bool ColliderIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation,
+      sf::Vector2f& theSeparatingAxis)
+  {
+    // Concave colliders are tested one convex piece at a time
+    if(!theMovingCache.Pieces.empty() || !theOtherCache.Pieces.empty())
+    {
+      return PieceIntersection(theMovingCache, theOtherCache,
+          theMinimumTranslation, theSeparatingAxis);
+    }
+
+    // Two polygons use the SIMD separating axis test
+    if(COLLIDER_POLYGON == theMovingCache.Type && COLLIDER_POLYGON == theOtherCache.Type)
+    {
+      return SATIntersection(theMovingCache, theOtherCache,
+          theMinimumTranslation, theSeparatingAxis);
+    }
+
+    // Exit if either collider is empty
+    if((COLLIDER_CIRCLE == theMovingCache.Type ? theMovingCache.Radius <= 0.0f : theMovingCache.Points.empty()) ||
+        (COLLIDER_CIRCLE == theOtherCache.Type ? theOtherCache.Radius <= 0.0f : theOtherCache.Points.empty()))
+      return false;
+
+    // Two circles or two boxes only need their centers or bounds
+    if(theMovingCache.Type == theOtherCache.Type)
+    {
+      theSeparatingAxis = sf::Vector2f(0.0f, 0.0f);
+      if(COLLIDER_CIRCLE == theMovingCache.Type)
+      {
+        return CircleIntersection(theMovingCache, theOtherCache, theMinimumTranslation);
+      }
+      return AABBIntersection(theMovingCache, theOtherCache, theMinimumTranslation);
+    }
+
+    // Quick rejection if the bounding boxes don't overlap
+    if(BoundsSeparated(theMovingCache, theOtherCache, theSeparatingAxis))
+      return false;
+
+#if defined(GQE_COLLISION_AVX2)
+    return ColliderTest<ProjectAVX2>(theMovingCache, theOtherCache, theMinimumTranslation, theSeparatingAxis);
+#elif defined(GQE_COLLISION_SSE2)
+    return ColliderTest<ProjectSSE2>(theMovingCache, theOtherCache, theMinimumTranslation, theSeparatingAxis);
+#else
+    return ColliderTest<ProjectScalar>(theMovingCache, theOtherCache, theMinimumTranslation, theSeparatingAxis);
+#endif
+  }
+
+  bool CircleIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+    sf::Vector2f anDelta = theOtherCache.Center - theMovingCache.Center;
+    float anRadius = theMovingCache.Radius + theOtherCache.Radius;
+    float anDistance = anDelta.x*anDelta.x + anDelta.y*anDelta.y;
+    if(anDistance > anRadius*anRadius)
+    {
+      return false;
+    }
+
+    // Pick any axis if both centers are in the same place
+    anDistance = sqrt(anDistance);
+    if(anDistance > 0.0f)
+    {
+      theMinimumTranslation = anDelta / anDistance;
+    }
+    else
+    {
+      theMinimumTranslation = sf::Vector2f(1.0f, 0.0f);
+    }
+    theMinimumTranslation *= anRadius - anDistance;
+    return true;
+  }
+
+  bool AABBIntersection(const CollisionCache& theMovingCache,
+      const CollisionCache& theOtherCache, sf::Vector2f& theMinimumTranslation)
+  {
+    const sf::FloatRect& anBoundsA = theMovingCache.Bounds;
+    const sf::FloatRect& anBoundsB = theOtherCache.Bounds;
+    float anOverlapX = anBoundsA.left + anBoundsA.width - anBoundsB.left;
+    float anBackwardX = anBoundsB.left + anBoundsB.width - anBoundsA.left;
+    float anOverlapY = anBoundsA.top + anBoundsA.height - anBoundsB.top;
+    float anBackwardY = anBoundsB.top + anBoundsB.height - anBoundsA.top;
+    if(anOverlapX < 0.0f || anBackwardX < 0.0f || anOverlapY < 0.0f || anBackwardY < 0.0f)
+    {
+      return false;
+    }
+
+    // Use the smaller overlap of each axis pointing toward the other box
+    anOverlapX = anOverlapX < anBackwardX ? anOverlapX : -anBackwardX;
+    anOverlapY = anOverlapY < anBackwardY ? anOverlapY : -anBackwardY;
+    if(fabs(anOverlapX) < fabs(anOverlapY))
+    {
+      theMinimumTranslation = sf::Vector2f(anOverlapX, 0.0f);
+    }
+    else
+    {
+      theMinimumTranslation = sf::Vector2f(0.0f, anOverlapY);
+    }
+    return true;
+  }
+
+  /// Clips a ray against the slab of each axis of a polygon or AABB collider
+  template<class TPROJECT>
+  bool RayCastTest(const CollisionCache& theCache, const sf::Vector2f& theOrigin,
+      const sf::Vector2f& theDirection, const float theMaxDistance,
+      float& theDistance, sf::Vector2f& theNormal)
+  {
+    sf::Vector2f anBoxAxes[2] = {sf::Vector2f(1.0f, 0.0f), sf::Vector2f(0.0f, 1.0f)};
+    const sf::Vector2f* anAxes = anBoxAxes;
+    size_t anAxisCount = 2;
+    if(COLLIDER_AABB != theCache.Type)
+    {
+      if(theCache.Normals.empty())
+        return false;
+      anAxes = &theCache.Normals[0];
+      anAxisCount = theCache.Normals.size();
+    }
+
+    // A convex shape is the overlap of the slabs along each edge normal
+    float anEnter = 0.0f;
+    float anExit = theMaxDistance;
+    theNormal = sf::Vector2f(0.0f, 0.0f);
+    for(size_t anIndex = 0; anIndex < anAxisCount; ++anIndex)
+    {
+      const sf::Vector2f& anAxis = anAxes[anIndex];
+      float anMin, anMax;
+      ProjectCollider<TPROJECT>(theCache, anAxis.x, anAxis.y, anMin, anMax);
+      float anOrigin = theOrigin.x*anAxis.x + theOrigin.y*anAxis.y;
+      float anSpeed = theDirection.x*anAxis.x + theDirection.y*anAxis.y;
+
+      // A ray parallel to this slab must already be inside it
+      if(anSpeed == 0.0f)
+      {
+        if(anOrigin < anMin || anOrigin > anMax)
+        {
+          return false;
+        }
+        continue;
+      }
+
+      float anNear = (anMin - anOrigin) / anSpeed;
+      float anFar = (anMax - anOrigin) / anSpeed;
+      sf::Vector2f anNormal = -anAxis;
+      if(anNear > anFar)
+      {
+        float anSwap = anNear;
+        anNear = anFar;
+        anFar = anSwap;
+        anNormal = anAxis;
+      }
+      if(anNear > anEnter)
+      {
+        anEnter = anNear;
+        theNormal = anNormal;
+      }
+      if(anFar < anExit)
+      {
+        anExit = anFar;
+      }
+      if(anEnter > anExit)
+      {
+        return false;
+      }
+    }
+    theDistance = anEnter;
+    return true;
+  }
+
+  bool ColliderRayCast(const CollisionCache& theCache,
+      const sf::Vector2f& theOrigin, const sf::Vector2f& theDirection,
+      const float theMaxDistance, float& theDistance, sf::Vector2f& theNormal)
+  {
+    // Concave colliders return the nearest hit of any convex piece
+    if(!theCache.Pieces.empty())
+    {
+      bool anResult = false;
+      std::vector<CollisionCache>::const_iterator anPiece;
+      for(anPiece = theCache.Pieces.begin(); anPiece != theCache.Pieces.end(); ++anPiece)
+      {
+        float anDistance;
+        sf::Vector2f anNormal;
+        if(ColliderRayCast(*anPiece, theOrigin, theDirection,
+              anResult ? theDistance : theMaxDistance, anDistance, anNormal) &&
+            (!anResult || anDistance < theDistance))
+        {
+          theDistance = anDistance;
+          theNormal = anNormal;
+          anResult = true;
+        }
+      }
+      return anResult;
+    }
+
+    if(COLLIDER_CIRCLE == theCache.Type)
+    {
+      if(theCache.Radius <= 0.0f)
+        return false;
+
+      // Solve |theOrigin + t*theDirection - Center| = Radius for t
+      sf::Vector2f anDelta = theOrigin - theCache.Center;
+      float anB = anDelta.x*theDirection.x + anDelta.y*theDirection.y;
+      float anC = anDelta.x*anDelta.x + anDelta.y*anDelta.y - theCache.Radius*theCache.Radius;
+      if(anC <= 0.0f)
+      {
+        // The ray starts inside the circle
+        theDistance = 0.0f;
+        theNormal = sf::Vector2f(0.0f, 0.0f);
+        return true;
+      }
+      float anDiscriminant = anB*anB - anC;
+      if(anB > 0.0f || anDiscriminant < 0.0f)
+      {
+        return false;
+      }
+      theDistance = -anB - sqrt(anDiscriminant);
+      if(theDistance > theMaxDistance)
+      {
+        return false;
+      }
+      theNormal = (anDelta + theDirection * theDistance) / theCache.Radius;
+      return true;
+    }
+
+    // Exit if the collider is empty
+    if(theCache.Points.empty())
+      return false;
+
+#if defined(GQE_COLLISION_AVX2)
+    return RayCastTest<ProjectAVX2>(theCache, theOrigin, theDirection, theMaxDistance, theDistance, theNormal);
+#elif defined(GQE_COLLISION_SSE2)
+    return RayCastTest<ProjectSSE2>(theCache, theOrigin, theDirection, theMaxDistance, theDistance, theNormal);
+#else
+    return RayCastTest<ProjectScalar>(theCache, theOrigin, theDirection, theMaxDistance, theDistance, theNormal);
+#endif
+  }
+
+  /// Narrows the time the swept projections along theAxis overlap, returns
+  /// false if they never overlap during the sweep
+  template<class TPROJECT>
+  bool SweepAxis(const CollisionCache& theMovingCache, const sf::Vector2f& theSweep,
+      const CollisionCache& theOtherCache, const sf::Vector2f& theAxis,
+      float& theEnter, float& theExit, sf::Vector2f& theNormal)
+  {
+    float anMinA, anMaxA, anMinB, anMaxB;
+    ProjectCollider<TPROJECT>(theMovingCache, theAxis.x, theAxis.y, anMinA, anMaxA);
+    ProjectCollider<TPROJECT>(theOtherCache, theAxis.x, theAxis.y, anMinB, anMaxB);
+
+    // Move the moving projection back to the start of the sweep
+    float anSpeed = theSweep.x*theAxis.x + theSweep.y*theAxis.y;
+    anMinA -= anSpeed;
+    anMaxA -= anSpeed;
+
+    // Not moving along this axis means they must always overlap on it
+    if(anSpeed == 0.0f)
+    {
+      return (anMinB <= anMaxA) && (anMaxB >= anMinA);
+    }
+
+    float anEnter, anExit;
+    sf::Vector2f anNormal = theAxis;
+    if(anSpeed > 0.0f)
+    {
+      anEnter = (anMinB - anMaxA) / anSpeed;
+      anExit = (anMaxB - anMinA) / anSpeed;
+    }
+    else
+    {
+      anEnter = (anMaxB - anMinA) / anSpeed;
+      anExit = (anMinB - anMaxA) / anSpeed;
+      anNormal = -theAxis;
+    }
+    if(anEnter > theEnter)
+    {
+      theEnter = anEnter;
+      theNormal = anNormal;
+    }
+    if(anExit < theExit)
+    {
+      theExit = anExit;
+    }
+    return theEnter <= theExit;
+  }
+
+  /// Swept separating axis test for any pair except two circles
+  template<class TPROJECT>
+  bool SweepTest(const CollisionCache& theMovingCache, const sf::Vector2f& theSweep,
+      const CollisionCache& theOtherCache, float& theTime, sf::Vector2f& theNormal)
+  {
+    float anEnter = -std::numeric_limits<float>::max();
+    float anExit = 1.0f;
+    sf::Vector2f anBoxAxes[2] = {sf::Vector2f(1.0f, 0.0f), sf::Vector2f(0.0f, 1.0f)};
+    theNormal = sf::Vector2f(0.0f, 0.0f);
+
+    // The edge normals of both colliders are every axis that can separate
+    // two translating convex shapes, circles only add their radius
+    const CollisionCache* anColliders[2] = {&theMovingCache, &theOtherCache};
+    for(Uint32 anShape = 0; anShape < 2; ++anShape)
+    {
+      const CollisionCache& anCollider = *anColliders[anShape];
+      const sf::Vector2f* anAxes = anBoxAxes;
+      size_t anAxisCount = 2;
+      if(COLLIDER_CIRCLE == anCollider.Type)
+      {
+        anAxisCount = 0;
+      }
+      else if(COLLIDER_POLYGON == anCollider.Type)
+      {
+        anAxisCount = anCollider.Normals.size();
+        anAxes = anAxisCount > 0 ? &anCollider.Normals[0] : NULL;
+      }
+      for(size_t anIndex = 0; anIndex < anAxisCount; ++anIndex)
+      {
+        if(!SweepAxis<TPROJECT>(theMovingCache, theSweep, theOtherCache,
+              anAxes[anIndex], anEnter, anExit, theNormal))
+        {
+          return false;
+        }
+      }
+    }
+
+    // Only a contact that starts during this sweep counts
+    if(anEnter > 1.0f || anExit < 0.0f)
+    {
+      return false;
+    }
+    if(anEnter <= 0.0f)
+    {
+      theTime = 0.0f;
+      theNormal = sf::Vector2f(0.0f, 0.0f);
+    }
+    else
+    {
+      theTime = anEnter;
+    }
+    return true;
+  }
+
+  /// Moves the contact time found against a polygon grown by theRadius to
+  /// the rounded corners of the polygon if the contact wasn't along an edge
+  static bool SweepCorners(const CollisionCache& thePolygon, const sf::Vector2f& theOrigin,
+      const sf::Vector2f& theSweep, const float theRadius, float& theTime, sf::Vector2f& theNormal)
+  {
+    // Is the circle within theRadius of any edge at theTime?
+    sf::Vector2f anCenter = theOrigin + theSweep * theTime;
+    float anLimit = theRadius * 1.0001f + 0.0001f;
+    size_t anPointCount = thePolygon.Points.size();
+    size_t anIndex;
+    for(anIndex = 0; anIndex < anPointCount; ++anIndex)
+    {
+      const sf::Vector2f& anPointA = thePolygon.Points[anIndex];
+      sf::Vector2f anEdge = thePolygon.Points[(anIndex + 1) % anPointCount] - anPointA;
+      sf::Vector2f anDelta = anCenter - anPointA;
+      float anLength = anEdge.x*anEdge.x + anEdge.y*anEdge.y;
+      float anRatio = anLength > 0.0f ? (anDelta.x*anEdge.x + anDelta.y*anEdge.y) / anLength : 0.0f;
+      anRatio = anRatio < 0.0f ? 0.0f : (anRatio > 1.0f ? 1.0f : anRatio);
+      anDelta -= anEdge * anRatio;
+      if(anDelta.x*anDelta.x + anDelta.y*anDelta.y <= anLimit*anLimit)
+      {
+        return true;
+      }
+    }
+
+    // Otherwise the circle can only touch one of the corners later on
+    float anSpeed = theSweep.x*theSweep.x + theSweep.y*theSweep.y;
+    float anFirst = 2.0f;
+    sf::Vector2f anCorner;
+    for(anIndex = 0; anIndex < anPointCount; ++anIndex)
+    {
+      sf::Vector2f anDelta = theOrigin - thePolygon.Points[anIndex];
+      float anB = anDelta.x*theSweep.x + anDelta.y*theSweep.y;
+      float anC = anDelta.x*anDelta.x + anDelta.y*anDelta.y - theRadius*theRadius;
+      float anDiscriminant = anB*anB - anSpeed*anC;
+      if(anDiscriminant < 0.0f)
+      {
+        continue;
+      }
+      float anTime = (-anB - sqrt(anDiscriminant)) / anSpeed;
+      if(anTime >= theTime && anTime <= 1.0f && anTime < anFirst)
+      {
+        anFirst = anTime;
+        anCorner = thePolygon.Points[anIndex];
+      }
+    }
+    if(anFirst > 1.0f)
+    {
+      return false;
+    }
+    theTime = anFirst;
+    theNormal = (anCorner - (theOrigin + theSweep * anFirst)) / theRadius;
+    return true;
+  }
+
+  bool ColliderSweep(const CollisionCache& theMovingCache,
+      const sf::Vector2f& theSweep, const CollisionCache& theOtherCache,
+      float& theTime, sf::Vector2f& theNormal)
+  {
+    // Concave colliders return the first contact of any two convex pieces
+    if(!theMovingCache.Pieces.empty() || !theOtherCache.Pieces.empty())
+    {
+      const CollisionCache* anMovingPieces = theMovingCache.Pieces.empty() ?
+        &theMovingCache : &theMovingCache.Pieces[0];
+      size_t anMovingCount = theMovingCache.Pieces.empty() ? 1 : theMovingCache.Pieces.size();
+      const CollisionCache* anOtherPieces = theOtherCache.Pieces.empty() ?
+        &theOtherCache : &theOtherCache.Pieces[0];
+      size_t anOtherCount = theOtherCache.Pieces.empty() ? 1 : theOtherCache.Pieces.size();
+
+      bool anResult = false;
+      for(size_t anMoving = 0; anMoving < anMovingCount; ++anMoving)
+      {
+        for(size_t anOther = 0; anOther < anOtherCount; ++anOther)
+        {
+          float anTime;
+          sf::Vector2f anNormal;
+          if(ColliderSweep(anMovingPieces[anMoving], theSweep, anOtherPieces[anOther],
+                anTime, anNormal) && (!anResult || anTime < theTime))
+          {
+            theTime = anTime;
+            theNormal = anNormal;
+            anResult = true;
+          }
+        }
+      }
+      return anResult;
+    }
+
+    // Exit if either collider is empty
+    if((COLLIDER_CIRCLE == theMovingCache.Type ? theMovingCache.Radius <= 0.0f : theMovingCache.Points.empty()) ||
+        (COLLIDER_CIRCLE == theOtherCache.Type ? theOtherCache.Radius <= 0.0f : theOtherCache.Points.empty()))
+      return false;
+
+    // Two circles are a ray cast against a circle of both radii
+    if(COLLIDER_CIRCLE == theMovingCache.Type && COLLIDER_CIRCLE == theOtherCache.Type)
+    {
+      float anLength = sqrt(theSweep.x*theSweep.x + theSweep.y*theSweep.y);
+      CollisionCache anTarget;
+      anTarget.Type = COLLIDER_CIRCLE;
+      anTarget.Center = theOtherCache.Center;
+      anTarget.Radius = theMovingCache.Radius + theOtherCache.Radius;
+      if(anLength <= 0.0f)
+      {
+        return false;
+      }
+      sf::Vector2f anDirection = theSweep / anLength;
+      if(!ColliderRayCast(anTarget, theMovingCache.Center - theSweep, anDirection,
+            anLength, theTime, theNormal))
+      {
+        return false;
+      }
+      theTime /= anLength;
+      theNormal = -theNormal;
+      return true;
+    }
+
+#if defined(GQE_COLLISION_AVX2)
+    bool anResult = SweepTest<ProjectAVX2>(theMovingCache, theSweep, theOtherCache, theTime, theNormal);
+#elif defined(GQE_COLLISION_SSE2)
+    bool anResult = SweepTest<ProjectSSE2>(theMovingCache, theSweep, theOtherCache, theTime, theNormal);
+#else
+    bool anResult = SweepTest<ProjectScalar>(theMovingCache, theSweep, theOtherCache, theTime, theNormal);
+#endif
+
+    // A circle against a polygon was tested against the polygon grown by the
+    // radius, so check the rounded corners if the contact missed every edge
+    if(anResult && theTime > 0.0f)
+    {
+      if(COLLIDER_CIRCLE == theMovingCache.Type)
+      {
+        anResult = SweepCorners(theOtherCache, theMovingCache.Center - theSweep,
+            theSweep, theMovingCache.Radius, theTime, theNormal);
+      }
+      else if(COLLIDER_CIRCLE == theOtherCache.Type)
+      {
+        // Sweep the circle backwards past the polygon where it ends instead,
+        // which also flips the normal to point from the circle
+        theNormal = -theNormal;
+        anResult = SweepCorners(theMovingCache, theOtherCache.Center + theSweep,
+            -theSweep, theOtherCache.Radius, theTime, theNormal);
+        theNormal = -theNormal;
+      }
+    }
+    return anResult;
+  }
+
+  const char* GetSATInstructionSet(void)
+  {
+#if defined(GQE_COLLISION_AVX2)
+    return "AVX2";
+#elif defined(GQE_COLLISION_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+  }
+
+  void PadCollisionCache(CollisionCache& theCache)
+  {
+    theCache.PointsX.clear();
+    theCache.PointsY.clear();
+    if(theCache.Points.empty())
+    {
+      return;
+    }
+
+    size_t anPointCount = theCache.Points.size();
+    size_t anPaddedCount = ((anPointCount + COLLISION_SIMD_WIDTH - 1) /
+        COLLISION_SIMD_WIDTH) * COLLISION_SIMD_WIDTH;
+    theCache.PointsX.reserve(anPaddedCount);
+    theCache.PointsY.reserve(anPaddedCount);
+    for(size_t anIndex = 0; anIndex < anPaddedCount; ++anIndex)
+    {
+      // Repeating the last point doesn't change the minimum or maximum
+      const sf::Vector2f& anPoint = theCache.Points[
+        anIndex < anPointCount ? anIndex : anPointCount - 1];
+      theCache.PointsX.push_back(anPoint.x);
+      theCache.PointsY.push_back(anPoint.y);
+    }
+  }
+} // namespace GQE
+
+/**
+ * Copyright (c) 2010-2012 Jacob Dix
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */